@@ -2,9 +2,12 @@
  * @addtogroup SBLIB_EXAMPLES Selfbus library usage examples
  * @defgroup SBLIB_EXAMPLE_SERIAL_BUS_1 Serial Bus Monitor Example
  * @ingroup SBLIB_EXAMPLES
- * @brief    Bus monitor that outputs all received telegrams to the serial port
- * @details  This is a bus monitor that outputs all received telegrams to the serial port.<br/>
- *           The serial port is used with 115200 baud, 8 data bits, no parity, 1 stop bit.<br/>
+ * @brief    Bus monitor that outputs all received frames to the serial port
+ * @details  This is a bus monitor that streams all received frames, including acknowledge
+ *           frames and frames with errors, as binary records with a time stamp to the serial port.
+ *           The record format is described in sblib/eib/bus_monitor.h, the host side decoder
+ *           is test/lib-test-cases/busmon.<br/>
+ *           The serial port is used with 921600 baud, 8 data bits, no parity, 1 stop bit.<br/>
  *           Tx-pin is PIO1.7, Rx-pin is PIO1.6<br/>
  *           In addition, one can send telegram on the bus via the serial port by sending
  *           a sequence of bytes.<br/>
@@ -29,6 +32,7 @@
  ---------------------------------------------------------------------------*/
 
 #include <sblib/eibBCU1.h>
+#include <sblib/eib/bus_monitor.h>
 #include <sblib/serial.h>
 #include <sblib/io_pin_names.h>
 #include <sblib/timeout.h>
@@ -37,6 +41,8 @@ Timeout blinky; ///< Timeout to blink the RUN Led
 
 BCU1 bcu = BCU1();
 
+BusMonitor monitor; ///< Captures all frames of the bus
+
 /**
  * Initialize the application.
  */
@@ -56,8 +62,8 @@ BcuBase* setup()
         bcu.userRam->status() ^= BCU_STATUS_LINK_LAYER | BCU_STATUS_PARITY;
     }
 
-    serial.begin(115200); // Tx: PIO1.7, Rx: PIO1.6
-    serial.println("Selfbus Bus Monitor");
+    serial.begin(921600); // Tx: PIO1.7, Rx: PIO1.6
+    bcu.bus->setMonitor(&monitor);
 
     pinMode(PIN_INFO, OUTPUT); // Info LED
     pinMode(PIN_RUN, OUTPUT);  // Run LED
@@ -81,20 +87,18 @@ void loop()
         digitalWrite(PIN_RUN, !digitalRead(PIN_RUN));
     }
 
-    // handle the incoming data from the KNX-bus
-    if (bcu.bus->telegramReceived())
+    // stream the frames captured from the KNX-bus
+    if (monitor.stream(serial))
     {
-        serial.print(bcu.bus->telegramLen, HEX, 2);
-		for (int i = 0; i < bcu.bus->telegramLen; ++i)
-		{
-			serial.print(bcu.bus->telegram[i], HEX, 2);
-		}
-		serial.println();
-		bcu.bus->discardReceivedTelegram();
-
         digitalWrite(PIN_INFO, !digitalRead(PIN_INFO));
     }
 
+    // the frames are captured by the monitor, the received telegrams are not needed
+    if (bcu.bus->telegramReceived())
+    {
+        bcu.bus->discardReceivedTelegram();
+    }
+
     // handle the incoming data from the serial line
     while (serial.available())
     {
@@ -108,8 +112,8 @@ void loop()
             sendTelBuffer[tLength++] = serial.read();
             if (tLength == (receiveCount & 0x7F))
             {
+                // no confirmation byte, it would end up in the middle of a record
                 bcu.bus->sendTelegram(sendTelBuffer, tLength);
-                serial.write (0xAD);
                 receiveCount = -1;
             }
         }
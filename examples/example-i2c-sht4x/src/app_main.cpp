@@ -86,9 +86,9 @@ BcuBase* setup()
 
 void readSHT4TempHum()
 {
-	if (!SHT40.measureHighPrecision())
+	if (!SHT40.result())
 	{
-	    serial.println("SHT40.measureHighPrecision() failed.");
+	    serial.println("SHT40 measurement failed.");
 	    return;
 	}
 
@@ -119,10 +119,16 @@ void loop_noapp()
 {
     if(bReadTimer)
     {
-        readSHT4TempHum();
+        // start the measurement, the result is printed when poll() reports it finished
+        SHT40.startMeasurement();
         readSHT4readSerial();
         bReadTimer=false;
     }
+
+    if (SHT40.poll())
+    {
+        readSHT4TempHum();
+    }
     // Sleep until the next interrupt happens
     __WFI();
 }
@@ -21,6 +21,7 @@
  -----------------------------------------------------------------------------*/
 
 #include <cstring>
+#include <sblib/core.h>
 #include <sblib/eib/bus.h>
 #include <sblib/eib/knx_tpdu.h>
 #include <sblib/eib/apci.h>
@@ -39,6 +39,9 @@ void analogEnd();
  *
  * The pin to read from shall be set to analog input mode with:
  * pinMode(pin, ANALOG_INPUT)
+ *
+ * Every call waits for a conversion. Use the interrupt driven AnalogSampler
+ * (see analog_sampler.h) to sample channels in the background instead.
  */
 int analogRead(int channel);
 
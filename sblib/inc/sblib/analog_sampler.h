@@ -0,0 +1,169 @@
+/*
+ *  analog_sampler.h - Interrupt driven background sampling of the analog inputs
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_analog_sampler_h
+#define sblib_analog_sampler_h
+
+#include <sblib/ioports.h>
+#include <sblib/types.h>
+
+/**
+ * Number of decimated values per channel that are kept for the moving average.
+ */
+#ifndef ANALOG_SAMPLER_BUFFER_SIZE
+#   define ANALOG_SAMPLER_BUFFER_SIZE 8
+#endif
+
+/**
+ * Default clock of the AD converter in burst mode. A conversion takes 11 clocks,
+ * so the default results in approx. 18000 conversions per second, shared by all
+ * sampled channels.
+ */
+#define ANALOG_SAMPLER_CLOCK 200000
+
+extern "C" void ADC_IRQHandler();
+
+
+/**
+ * Background sampling of the analog inputs. The AD converter runs in burst mode
+ * and converts the configured channels continuously. The ADC interrupt collects
+ * the results once per scan, decimates them by the oversampling factor and
+ * stores the decimated values in a ring buffer per channel.
+ *
+ * Reading the values never waits for a conversion.
+ *
+ * Example:
+ *
+ * pinMode(PIO0_11, INPUT_ANALOG);
+ * pinMode(PIO1_0, INPUT_ANALOG);
+ * analogSampler.begin(ANALOG_CHANNEL(AD0) | ANALOG_CHANNEL(AD1), 16);
+ * ...
+ * int value = analogSampler.average(AD0);
+ *
+ * analogRead() must not be used while the sampler runs.
+ */
+class AnalogSampler
+{
+public:
+    /**
+     * Start sampling. Powers on the AD converter if required.
+     *
+     * @param channels - the channels to sample as bitmask, e.g. ANALOG_CHANNEL(AD0) | ANALOG_CHANNEL(AD3)
+     * @param oversampling - the number of conversions that are averaged to one value, 1 disables oversampling
+     * @param adcClock - the clock of the AD converter in Hz, at most 4500000
+     */
+    void begin(unsigned int channels, unsigned int oversampling = 1,
+               unsigned int adcClock = ANALOG_SAMPLER_CLOCK);
+
+    /**
+     * Stop sampling and power down the AD converter.
+     */
+    void end();
+
+    /**
+     * Test if the sampler is running.
+     *
+     * @return True if the sampler is running.
+     */
+    bool running() const;
+
+    /**
+     * Get the latest decimated value of a channel.
+     *
+     * @param channel - the analog channel: AD0, AD1, ... AD7
+     * @return The value (0..1023), or -1 if there is no value yet.
+     */
+    int value(int channel) const;
+
+    /**
+     * Get the moving average over the last ANALOG_SAMPLER_BUFFER_SIZE decimated
+     * values of a channel.
+     *
+     * @param channel - the analog channel: AD0, AD1, ... AD7
+     * @return The average (0..1023), or -1 if there is no value yet.
+     */
+    int average(int channel) const;
+
+    /**
+     * Get the number of decimated values of a channel since begin(). The counter
+     * wraps around, use it to detect new values.
+     *
+     * @param channel - the analog channel: AD0, AD1, ... AD7
+     * @return The number of values.
+     */
+    unsigned int count(int channel) const;
+
+    /**
+     * Get the number of conversions that were lost because the interrupt was
+     * handled too late.
+     *
+     * @return The number of overruns since begin().
+     */
+    unsigned int overruns() const;
+
+    /**
+     * Handle the ADC interrupt. Called by ADC_IRQHandler().
+     */
+    void interruptHandler();
+
+protected:
+    /**
+     * Sampling state of one channel.
+     */
+    struct Channel
+    {
+        uint16_t values[ANALOG_SAMPLER_BUFFER_SIZE]; //!< Ring buffer of the decimated values
+        uint32_t sum;                                //!< Sum of the buffered values
+        uint32_t accu;                               //!< Sum of the conversions for oversampling
+        uint16_t accuCount;                          //!< Number of conversions in accu
+        uint8_t pos;                                 //!< Ring buffer position of the next value
+        uint8_t fill;                                //!< Number of buffered values
+        volatile uint16_t latest;                    //!< Latest decimated value
+        volatile unsigned int count;                 //!< Number of decimated values since begin()
+    };
+
+    void addConversion(Channel& ch, unsigned int value);
+
+    Channel channelData[8];
+    unsigned int channels = 0;
+    unsigned int oversampling = 1;
+    volatile unsigned int overrunCount = 0;
+};
+
+/**
+ * The background sampler of the AD converter.
+ */
+extern AnalogSampler analogSampler;
+
+/**
+ * Get the channel bitmask for AnalogSampler::begin().
+ *
+ * @param channel - the analog channel: AD0, AD1, ... AD7
+ */
+#define ANALOG_CHANNEL(channel) (1 << (channel))
+
+
+//
+//  Inline functions
+//
+
+inline bool AnalogSampler::running() const
+{
+    return channels != 0;
+}
+
+inline unsigned int AnalogSampler::count(int channel) const
+{
+    return channelData[channel].count;
+}
+
+inline unsigned int AnalogSampler::overruns() const
+{
+    return overrunCount;
+}
+
+#endif /*sblib_analog_sampler_h*/
@@ -12,12 +12,29 @@
 
 #include <sblib/stream.h>
 
+/**
+ * Interface for the receivers of the bytes of a stream, which process them
+ * in the receive interrupt instead of reading them from the read buffer.
+ */
+class StreamReceiveCallback
+{
+public:
+    /**
+     * Called from the receive interrupt handler for every received byte.
+     *
+     * @param ch - the received byte
+     */
+    virtual void byteReceived(byte ch) = 0;
+};
+
 /**
  * A stream class that has a read and a write buffer.
  */
 class BufferedStream: public Stream
 {
 public:
+    BufferedStream();
+
     /**
      * Read a single byte.
      *
@@ -38,6 +55,11 @@ public:
      */
     virtual int available();
 
+    /**
+     * @return The number of bytes that can be written without waiting.
+     */
+    int availableForWrite();
+
     /**
      * Clear the read and write buffers.
      *
@@ -45,6 +67,14 @@ public:
      */
     void clearBuffers();
 
+    /**
+     * Set the receiver of the received bytes. The bytes are passed to it from the
+     * receive interrupt and are not stored in the read buffer then.
+     *
+     * @param callback - the receiver of the bytes, 0 to store them in the read buffer.
+     */
+    void setReceiveCallback(StreamReceiveCallback* callback);
+
     enum
     {
         BUFFER_SIZE = 128,  //!< The size of the internal read/write buffers in bytes.
@@ -57,6 +87,15 @@ protected:
 
     byte readBuffer[BUFFER_SIZE];      //!< the read buffer
     byte writeBuffer[BUFFER_SIZE];     //!< the write buffer
+    StreamReceiveCallback* receiveCallback; //!< the receiver of the received bytes, or 0
+
+    /**
+     * Pass a received byte to the receive callback, or store it in the read buffer.
+     * Subclasses call this from their receive interrupt handler.
+     *
+     * @param ch - the received byte
+     */
+    void received(byte ch);
 
     /**
      * Test if the read buffer is full.
@@ -74,6 +113,11 @@ protected:
 //  Inline functions
 //
 
+inline BufferedStream::BufferedStream()
+    : receiveCallback(nullptr)
+{
+}
+
 inline void BufferedStream::clearBuffers()
 {
     readHead = 0;
@@ -82,6 +126,16 @@ inline void BufferedStream::clearBuffers()
     writeTail = 0;
 }
 
+inline void BufferedStream::setReceiveCallback(StreamReceiveCallback* callback)
+{
+    receiveCallback = callback;
+}
+
+inline int BufferedStream::availableForWrite()
+{
+    return (writeHead - writeTail - 1) & BufferedStream::BUFFER_SIZE_MASK;
+}
+
 ALWAYS_INLINE bool BufferedStream::readBufferFull()
 {
     return ((readTail + 1) & BufferedStream::BUFFER_SIZE_MASK) == readHead;
@@ -62,6 +62,119 @@ private:
 };
 
 
+/**
+ * The number of GPIO ports a DebouncerBank can debounce: PIO0 ... PIO3
+ */
+#define DEBOUNCER_BANK_PORTS 4
+
+/**
+ * A debouncer for many digital inputs. The debouncer bank reads whole GPIO
+ * ports and debounces all selected pins of a port in parallel with 2 bit
+ * vertical counters. A pin changes its debounced value after it was sampled
+ * 4 times in a row with the new value.
+ *
+ * Example:
+ *
+ *     DebouncerBank inputs;
+ *     ...
+ *     inputs.addPins(PIO2, 0x0ff);
+ *     inputs.addPin(PIO1_8);
+ *     ...
+ *     if (inputs.debounce(5))  // sample every 5 msec, 20 msec debounce time
+ *     {
+ *         unsigned int changed = inputs.changed(PIO2);
+ *         ...
+ *     }
+ *
+ * Alternatively, call sample() from a timer interrupt.
+ */
+class DebouncerBank
+{
+public:
+    /**
+     * Create a debouncer bank without pins.
+     */
+    DebouncerBank();
+
+    /**
+     * Add pins of a port to the debouncer bank. The current values of the
+     * pins become their debounced values.
+     *
+     * @param port - the port of the pins: PIO0, PIO1, PIO2, PIO3
+     * @param pinMask - the bit mask of the port pins to add
+     */
+    void addPins(int port, unsigned int pinMask);
+
+    /**
+     * Add a pin to the debouncer bank. The current value of the pin becomes
+     * its debounced value.
+     *
+     * @param pin - the pin to add: PIO0_0, PIO0_1, ...
+     */
+    void addPin(int pin);
+
+    /**
+     * Read all ports with selected pins once and advance the vertical counters.
+     * Can be called from an interrupt.
+     *
+     * @return True if the debounced value of a pin changed.
+     */
+    bool sample();
+
+    /**
+     * Call sample() when the sample interval elapsed since the last sample.
+     * The debounce time is 4 times the sample interval.
+     *
+     * @param interval - the sample interval in milliseconds. Default: 5 msec
+     *
+     * @return True if there are changed pins that were not yet fetched with changed().
+     */
+    bool debounce(unsigned int interval = 5);
+
+    /**
+     * Get the debounced values of a port.
+     *
+     * @param port - the port: PIO0, PIO1, PIO2, PIO3
+     * @return The debounced values of the selected pins of the port.
+     */
+    unsigned int value(int port) const;
+
+    /**
+     * Get the debounced value of a pin.
+     *
+     * @param pin - the pin: PIO0_0, PIO0_1, ...
+     * @return The debounced value of the pin.
+     */
+    bool pinValue(int pin) const;
+
+    /**
+     * Get and clear the pins of a port whose debounced value changed since the
+     * last call.
+     *
+     * @param port - the port: PIO0, PIO1, PIO2, PIO3
+     * @return The bit mask of the changed pins.
+     */
+    unsigned int changed(int port);
+
+protected:
+    /**
+     * The debounce state of the pins of a port. The vertical counter of a pin
+     * consists of its bits in count0 and count1.
+     */
+    struct PortState
+    {
+        unsigned int mask;              //!< The selected pins
+        unsigned int state;             //!< The debounced values
+        unsigned int count0;            //!< Low bits of the vertical counters
+        unsigned int count1;            //!< High bits of the vertical counters
+        volatile unsigned int changes;  //!< The changed pins not yet fetched
+    };
+
+    PortState ports[DEBOUNCER_BANK_PORTS];
+    unsigned int time;
+};
+
+
 //
 //  Inline functions
 //
@@ -82,4 +195,9 @@ inline int Debouncer::lastValue() const
     return last;
 }
 
+inline unsigned int DebouncerBank::value(int port) const
+{
+    return ports[port].state;
+}
+
 #endif /*sblib_debounce_h*/
@@ -104,6 +104,7 @@ bool digitalRead(int pin);
  * Output a byte on a digital pin. The output is done bit by bit. The clock pin
  * pulses the output. Output of a bit happens when the clock pin is high. This
  * is a software function. For hardware supported output of data, see SPI or I2C.
+ * For chains of shift registers like the 74HC595, see ShiftRegisterChain.
  *
  * @param dataPin - the data pin to output the byte to
  * @param clockPin - the clock pin
@@ -331,10 +332,114 @@ enum PinInterruptMode
 	INTERRUPT_ENABLED      = 0x1000,
 };
 
+/**
+ * Get the port pin function that a pin mode selects.
+ *
+ * @param mode - the I/O mode, see pinMode()
+ * @return The pin function, e.g. PF_PIO
+ */
+constexpr short pinModeFunction(int mode)
+{
+    return (mode & 0xf000) == OUTPUT_MATCH ? PF_MAT :
+           (mode & 0xf000) == INPUT_CAPTURE ? PF_CAP :
+           (mode & 0xf000) == INPUT_ANALOG ? PF_AD :
+           ((mode >> 18) & 31) ? ((mode >> 18) & 31) : PF_PIO;
+}
+
+/**
+ * Get the value of the IO configuration register of a pin for a pin mode.
+ *
+ * @param pin - the pin to configure: PIO0_0, PIO0_1, ...
+ * @param mode - the I/O mode, see pinMode()
+ * @return The value for the IO configuration register, or -1 if the pin
+ *         does not have the function that the mode selects.
+ */
+constexpr int pinModeIocon(int pin, int mode)
+{
+    const short func = pinModeFunction(mode);
+    const short funcNum = getPinFunctionNumber(pin, func);
+    if (funcNum < 0)
+        return -1;
+
+    int iocon = (mode & 0xfff) | funcNum;
+    if ((pin & PFL_ADMODE) && func != PF_AD)
+        iocon |= 0x80;
+    return iocon;
+}
+
+/**
+ * Route a pin function that is available on alternative pins to the pin.
+ * Does nothing for functions with a fixed location.
+ *
+ * @param pin - the pin: PIO0_0, PIO0_1, ...
+ * @param func - the pin function, e.g. PF_RXD
+ */
+void pinSelectLocation(int pin, short func);
+
 //
 //  Inline functions
 //
 
+ALWAYS_INLINE void pinSelectLocation(int pin, short func)
+{
+    if (func == PF_CAP)
+    {
+        if (pin == PIO0_2)
+            LPC_IOCON->CT16B0_CAP0_LOC = 0;
+        else if (pin == PIO3_3)
+            LPC_IOCON->CT16B0_CAP0_LOC = 1;
+        else if (pin == PIO1_5)
+            LPC_IOCON->CT32B0_CAP0_LOC = 0;
+        else if (pin == PIO2_9)
+            LPC_IOCON->CT32B0_CAP0_LOC = 1;
+    }
+    else if (func == PF_RXD)
+    {
+        if (pin == PIO1_6)
+            LPC_IOCON->RXD_LOC = 0;
+        else if (pin == PIO2_7)
+            LPC_IOCON->RXD_LOC = 1;
+        else if (pin == PIO3_1)
+            LPC_IOCON->RXD_LOC = 2;
+        else if (pin == PIO3_4)
+            LPC_IOCON->RXD_LOC = 3;
+    }
+    else if (func == PF_MISO)
+    {
+        if (pin == PIO2_2)
+            LPC_IOCON->MISO1_LOC = 0;
+        else if (pin == PIO1_10)
+            LPC_IOCON->MISO1_LOC = 1;
+    }
+    else if (func == PF_MOSI)
+    {
+        if (pin == PIO2_3)
+            LPC_IOCON->MOSI1_LOC = 0;
+        else if (pin == PIO1_9)
+            LPC_IOCON->MOSI1_LOC = 1;
+    }
+    else if (func == PF_SCK)
+    {
+        if (pin == PIO0_10)
+            LPC_IOCON->SCK_LOC = 0;
+        else if (pin == PIO2_11)
+            LPC_IOCON->SCK_LOC = 1;
+        else if (pin == PIO0_6)
+            LPC_IOCON->SCK_LOC = 2;
+        else if (pin == PIO2_1)
+            LPC_IOCON->SCK1_LOC = 0;
+        else if (pin == PIO3_2)
+            LPC_IOCON->SCK1_LOC = 1;
+    }
+    else if (func == PF_SSEL)
+    {
+        if (pin == PIO2_2)
+            LPC_IOCON->SSEL1_LOC = 0;
+        else if (pin == PIO2_4)
+            LPC_IOCON->SSEL1_LOC = 1;
+    }
+}
+
 ALWAYS_INLINE void digitalWrite(int pin, bool value)
 {
     int mask = digitalPinToBitMask(pin);
@@ -55,8 +55,42 @@ public:
 	 */
 	byte* assocTable() override;
 
+protected:
+	/**
+	 * The implementation of @ref indexOfAddr(int). It reads the table through self,
+	 * so the calls are resolved at compile time when Self is a final class,
+	 * see AddrTablesStatic.
+	 */
+	template <class Self>
+	static int indexOfAddr(Self& self, int addr);
+
 private:
 	BCU1* bcu;
 };
 
+//
+//  Inline functions
+//
+template <class Self>
+int AddrTablesBCU1::indexOfAddr(Self& self, int addr)
+{
+    byte* tab = self.addrTable();
+    int num = 0;
+
+    if (tab)
+        num = *tab;
+    tab += 3;
+
+    int addrHigh = addr >> 8;
+    int addrLow = addr & 255;
+
+    for (int i = 1; i <= num; ++i, tab += 2)
+    {
+        if (tab[0] == addrHigh && tab[1] == addrLow)
+            return i;
+    }
+
+    return -1;
+}
+
 #endif /*sblib_addr_tables_BCU1_h*/
@@ -16,10 +16,17 @@
 #include <sblib/eib/com_objects.h>
 #include <sblib/timeout.h>
 #include <sblib/timer.h>
+#include <sblib/timer_wheel.h>
 #include <sblib/debounce.h>
 #include <sblib/eib/knx_tlayer4.h>
+#include <sblib/eib/bus.h>
 
-class Bus;
+/**
+ * The time in milliseconds between two samples of the programming button when main() sleeps
+ * between the events, see @ref BcuBase::idleTime(). A press of the button is recognized when
+ * it is longer than this time plus the debounce time of 50 milliseconds.
+ */
+#define BCU_PROG_BUTTON_POLL_TIME 50
 
 /**
  * Class for controlling minimum BCU related things.
@@ -66,6 +73,30 @@ public:
      */
     virtual void loop() override;
 
+    /**
+     * Get the time until the BCU's loop() has work to do again, so the processor can
+     * sleep in between. A received telegram, a telegram waiting to be sent, an open
+     * transport layer connection or a pending restart need loop() immediately.
+     * Interrupts wake up the processor earlier, see @ref sleepUntilInterrupt().
+     *
+     * Otherwise the next deadline is the next timer of the @ref timerWheel, which includes the
+     * timeouts of the application, or the next sample of the programming button, see
+     * @ref BCU_PROG_BUTTON_POLL_TIME.
+     *
+     * @return The number of milliseconds, 0 if loop() shall be called again without sleeping,
+     *         TIMER_WHEEL_IDLE_FOREVER if there is no deadline.
+     */
+    virtual unsigned int idleTime();
+
+    /**
+     * Get the index of a group address in the address table, see @ref AddrTables::indexOfAddr().
+     * The bus calls this from its interrupt handler for every received group telegram.
+     *
+     * @param addr - the group address to find.
+     * @return The index of the address, -1 if not found or if there is no address table.
+     */
+    virtual int indexOfGroupAddress(int addr);
+
     /**
      *
      * The pin where the programming LED + button are connected. The default pin
@@ -84,7 +115,11 @@ public:
     AddrTables* addrTables;
     ComObjects* comObjects;
 
-    virtual int maxTelegramSize();
+    /**
+     * @return The maximum size of a telegram in bytes, including the checksum. This is the size
+     *         of the telegram buffers of the bus and the transport layer.
+     */
+    static constexpr int maxTelegramSize() { return MAX_TELEGRAM_SIZE; }
 
 protected:
     /**
@@ -115,6 +150,7 @@ protected:
     void sendApciIndividualAddressReadResponse();
 
     Debouncer progButtonDebouncer; //!< The debouncer for the programming mode button.
+    unsigned int progButtonTime; //!< The system time of the last sample of the programming button
 
     void discardReceivedTelegram();
     void send(unsigned char* telegram, unsigned short length);
@@ -132,6 +168,7 @@ protected:
 private:
     RestartType restartType;
     bool restartSendDisconnect;
-    Timeout restartTimeout;
+    SoftTimer restartTimeout;
+    Bus busInstance; //!< The bus, allocated with the BCU. Use @ref bus to access it.
 };
 #endif /*sblib_BcuBase_h*/
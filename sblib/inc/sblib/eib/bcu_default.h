@@ -59,6 +59,17 @@ public:
      * and is called automatically by main() when the BCU is activated with bcu.begin().
      */
     virtual void loop() override;
+
+    /**
+     * Get the time until the BCU's loop() has work to do again. In addition to
+     * @ref BcuBase::idleTime(), the modified user EEPROM needs loop() when its write delay
+     * is elapsed, immediately while a direct connection holds off writing it, and
+     * a transmission request of a communication object when the rate limit of the group
+     * telegrams allows sending it.
+     *
+     * @return The number of milliseconds, 0 if loop() shall be called again without sleeping.
+     */
+    virtual unsigned int idleTime() override;
     
     /**
      * Process a APCI_MEMORY_WRITE_PDU
@@ -0,0 +1,153 @@
+/*
+ *  bcu_static.h - BCU variant with compile time table access.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_bcu_static_h
+#define sblib_bcu_static_h
+
+#include <sblib/eib/bcu_default.h>
+
+/**
+ * Address tables of the mask Base whose lookups are resolved at compile time.
+ *
+ * indexOfAddr() reads the tables through Derived, so when Derived is a final class
+ * the compiler calls and inlines the table accessors directly instead of going
+ * through the vtable. The virtual interface of Base is kept, so the tables can still
+ * be used through an AddrTables pointer.
+ *
+ * @tparam Derived - the final class that derives from this class.
+ * @tparam Base - the address tables of the mask, e.g. AddrTablesSYSTEMB.
+ */
+template <class Derived, class Base>
+class AddrTablesStatic : public Base
+{
+public:
+    using Base::Base;
+
+    int indexOfAddr(int addr) final
+    {
+        return Base::indexOfAddr(static_cast<Derived&>(*this), addr);
+    }
+};
+
+/**
+ * Communication objects of the mask Base whose table lookups are resolved at compile time.
+ *
+ * objectConfig(), objectSize() and objectValuePtr() read the tables through Derived,
+ * see AddrTablesStatic. processGroupTelegram(), sendNextGroupTelegram() and
+ * nextUpdatedObject() also read the address tables through AddrTablesType, so the
+ * processing of a group telegram does not go through the vtable after the first call.
+ *
+ * @tparam Derived - the final class that derives from this class.
+ * @tparam Base - the communication objects of the mask, e.g. ComObjectsSYSTEMB.
+ * @tparam AddrTablesType - the final class of the address tables of the BCU.
+ */
+template <class Derived, class Base, class AddrTablesType>
+class ComObjectsStatic : public Base
+{
+public:
+    using Base::Base;
+
+    const ComConfig& objectConfig(int objno) final
+    {
+        return Base::objectConfig(static_cast<Derived&>(*this), objno);
+    }
+
+    int objectSize(int objno) final
+    {
+        return Base::objectSize(static_cast<Derived&>(*this), objno);
+    }
+
+    byte* objectValuePtr(int objno) final
+    {
+        return Base::objectValuePtr(static_cast<Derived&>(*this), objno);
+    }
+
+    void processGroupTelegram(uint16_t addr, int apci, byte* tel, int trg_objno) final
+    {
+        Base::processGroupTelegram(static_cast<Derived&>(*this), addrTables(), addr, apci, tel, trg_objno);
+    }
+
+    bool sendNextGroupTelegram() final
+    {
+        return Base::sendNextGroupTelegram(static_cast<Derived&>(*this), addrTables());
+    }
+
+    int nextUpdatedObject() final
+    {
+        return Base::nextUpdatedObject(static_cast<Derived&>(*this));
+    }
+
+private:
+    AddrTablesType& addrTables() { return *static_cast<AddrTablesType*>(this->bcu->addrTables); }
+};
+
+/**
+ * The address tables of the mask Base with compile time lookups, for masks
+ * that keep their tables in the user memory.
+ */
+template <class Base>
+class StaticAddrTables final : public AddrTablesStatic<StaticAddrTables<Base>, Base>
+{
+public:
+    using AddrTablesStatic<StaticAddrTables<Base>, Base>::AddrTablesStatic;
+};
+
+/**
+ * The communication objects of the mask Base with compile time lookups, for masks
+ * that keep their tables in the user memory.
+ *
+ * @tparam AddrTablesType - the address tables of the BCU, usually StaticAddrTables.
+ */
+template <class Base, class AddrTablesType>
+class StaticComObjects final : public ComObjectsStatic<StaticComObjects<Base, AddrTablesType>, Base, AddrTablesType>
+{
+public:
+    using ComObjectsStatic<StaticComObjects<Base, AddrTablesType>, Base, AddrTablesType>::ComObjectsStatic;
+};
+
+/**
+ * A BCU of the mask Base that uses address tables and communication objects with
+ * compile time lookups.
+ *
+ * Example:
+ * @code
+ * typedef StaticAddrTables<AddrTablesSYSTEMB> Tables;
+ * BcuStatic<SYSTEMB, Tables, StaticComObjects<ComObjectsSYSTEMB, Tables>, PropertiesSYSTEMB>
+ *     bcu(new UserRamSYSTEMB(), new UserEepromSYSTEMB());
+ * @endcode
+ *
+ * @tparam Base - the BCU class of the mask, e.g. SYSTEMB.
+ * @tparam AddrTablesType - the address tables, usually StaticAddrTables.
+ * @tparam ComObjectsType - the communication objects, usually StaticComObjects.
+ * @tparam PropertiesType - the properties of the mask, empty for BCU1.
+ */
+template <class Base, class AddrTablesType, class ComObjectsType, class... PropertiesType>
+class BcuStatic : public Base
+{
+public:
+    template <class UserRamType, class UserEepromType>
+    BcuStatic(UserRamType* userRam, UserEepromType* userEeprom) :
+        Base(userRam, userEeprom, new ComObjectsType(this), new AddrTablesType(this), new PropertiesType(this)...)
+    {}
+
+    /**
+     * @return The address tables, with their lookups resolved at compile time.
+     */
+    AddrTablesType* staticAddrTables() { return static_cast<AddrTablesType*>(this->addrTables); }
+
+    /**
+     * @return The communication objects, with their lookups resolved at compile time.
+     */
+    ComObjectsType* staticComObjects() { return static_cast<ComObjectsType*>(this->comObjects); }
+
+    int indexOfGroupAddress(int addr) final
+    {
+        return staticAddrTables()->indexOfAddr(addr);
+    }
+};
+
+#endif /*sblib_bcu_static_h*/
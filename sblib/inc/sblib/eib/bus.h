@@ -10,12 +10,48 @@
 #ifndef sblib_bus_h
 #define sblib_bus_h
 
-#include <sblib/core.h>
-#include <sblib/eib/bcu_base.h>
+#include <sblib/types.h>
 
 #include <sblib/timer.h>
+#include <sblib/eib/bus_const.h>
+#include <sblib/eib/bus_monitor.h>
 #include <sblib/eib/types.h>
 
+class BcuBase;
+class TpUart;
+
+/**
+ * The number of telegrams handed to the higher layers that are remembered to
+ * detect repetitions.
+ */
+#define RX_HISTORY_SIZE 4
+
+/**
+ * The time in milliseconds a handed over telegram is remembered to detect repetitions.
+ * The sender repeats a telegram right after the missing acknowledge, but busy
+ * repetitions can take a few hundred milliseconds.
+ */
+#define RX_HISTORY_TIMEOUT 1000
+
+/**
+ * Interface for the receivers of the notification that the bus finished
+ * sending a telegram.
+ */
+class BusSendCallback
+{
+public:
+    /**
+     * Called from the bus timer interrupt handler when sending a telegram has ended.
+     * With a transceiver, it is called from the receive interrupt handler of its serial
+     * port, or from loop() when the transceiver does not confirm the telegram.
+     *
+     * @param telegram - the telegram that was sent
+     * @param successful - true if the telegram was acknowledged, false if not even
+     *                     after repeating it
+     */
+    virtual void telegramSent(byte* telegram, bool successful) = 0;
+};
+
 /**
  * Low level class for EIB bus access.
  *
@@ -134,11 +170,39 @@ public:
      */
     void maxSendBusyRetries(int retries);
 
+    /**
+     * Set the bus monitor that captures every received frame, including acknowledge
+     * frames and frames with errors. The frames are captured in addition to the
+     * normal processing of the received telegrams.
+     *
+     * @param monitor - the bus monitor, 0 to stop capturing.
+     */
+    void setMonitor(BusMonitor* monitor);
+
+    /**
+     * Set the receiver of the notification that sending a telegram has ended.
+     * The BCU is notified too.
+     *
+     * @param callback - the receiver of the notification, 0 for none.
+     */
+    void setSendCallback(BusSendCallback* callback);
+
+    /**
+     * Use a transceiver chip that is attached to a serial port for sending and receiving
+     * the frames, instead of the bus timer. Must be called before @ref begin().
+     * Pausing the bus has no effect then.
+     *
+     * @param transceiver - the transceiver, 0 to use the bus timer.
+     */
+    void setTransceiver(TpUart* transceiver);
+
     /**
      * The received telegram.
      * The higher layer process should not change the telegram data in the buffer!
+     * The buffer belongs to the higher layer until it calls @ref discardReceivedTelegram(),
+     * then the bus hands the next received telegram over by swapping the buffers.
      */
-    byte* telegram;
+    byte* volatile telegram;
 
     /**
       * The total length of the received telegram in telegram[].
@@ -210,6 +274,63 @@ private:
      */
     void handleTelegram(bool valid);
 
+    /**
+     * Hand the valid telegram in rx_telegram over to the higher layers, if it is for us
+     * and no repetition of a recently handed over telegram.
+     *
+     * @return The acknowledge to send, SB_BUS_ACK or 0 for none.
+     */
+    int acceptTelegram();
+
+    /**
+     * Test if a telegram with the control byte may be acknowledged by the link layer.
+     */
+    bool acknowledgeAllowed(byte controlByte) const;
+
+    /**
+     * Handle a frame that the transceiver received completely. The transceiver already
+     * sent the acknowledge.
+     *
+     * @param valid - true if the checksum is correct
+     */
+    void handleTransceiverTelegram(bool valid);
+
+    /**
+     * Decide if the telegram in rx_telegram is for us, by its destination address, and set
+     * @ref rxDestination. rx_telegram must contain at least the first 6 bytes of the telegram.
+     */
+    void checkDestination();
+
+    /**
+     * Test if the telegram in rx_telegram is a repetition of a telegram that was
+     * handed to the higher layers recently.
+     *
+     * @param checksumReceived - false to compare only the header, while the rest of the
+     *                           telegram is still being received
+     */
+    bool isRepeatedTelegram(bool checksumReceived = true) const;
+
+    /**
+     * Remember the telegram in rx_telegram, to detect its repetitions.
+     */
+    void rememberTelegram();
+
+    /**
+     * The signature of a received telegram, for detecting repetitions: the control byte
+     * without the repeat flag, the addresses, the length byte and the checksum.
+     */
+    struct RxSignature
+    {
+        unsigned int addresses;  //!< Source and destination address
+        unsigned int header;     //!< Control byte, length byte and checksum, 0 if the entry is unused
+        unsigned int time;       //!< The time when the telegram was received, in milliseconds
+    };
+
+    /**
+     * Build the signature of the telegram in rx_telegram.
+     */
+    void rxSignature(RxSignature& signature) const;
+
 private:
     BcuBase* bcu;
     Timer& timer;                //!< The timer
@@ -217,8 +338,21 @@ private:
     TimerCapture captureChannel; //!< The timer channel that captures the timer value on the bus-in pin
     TimerMatch pwmChannel;       //!< The timer channel for PWM for sending
     TimerMatch timeChannel;      //!< The timer channel for timeouts
+    BusMonitor* monitor;         //!< The bus monitor that captures the received frames, or 0
+    BusSendCallback* sendCallback; //!< The receiver of the notification that sending ended, or 0
+    TpUart* transceiver;         //!< The transceiver that sends and receives the frames, or 0 for the bus timer
+
+    friend class TpUart;
 
 private:
+    /** The decision if the received telegram is for us, see @ref checkDestination() */
+    enum RxDestination
+    {
+        RX_DESTINATION_UNKNOWN, //!< Not decided yet, the destination was not received completely
+        RX_DESTINATION_OTHER,   //!< The telegram is not for us
+        RX_DESTINATION_OURS     //!< The telegram is for us
+    };
+
     /** The states of the telegram sending/receiving state machine */
     enum State
     {
@@ -249,7 +383,8 @@ private:
     int currentByte;               //!< The current byte that is received/sent, including the parity bit
     int sendTelegramLen;           //!< The size of the to be sent telegram in bytes (including the checksum).
     byte *sendCurTelegram;         //!< The telegram that is currently being sent.
-    byte *rx_telegram = new byte[bcu->maxTelegramSize()](); //!< Telegram buffer for the L1/L2 receiving process
+    byte *rx_telegram;             //!< Telegram buffer for the L1/L2 receiving process
+    byte rxBuffers[2][MAX_TELEGRAM_SIZE]; //!< The buffers of telegram and rx_telegram, swapped when a telegram is received
 
     int bitMask;
     int bitTime;                   //!< The bit-time within a byte when receiving
@@ -262,6 +397,9 @@ private:
     bool busy_wait_from_remote;    //!< remote side is busy, re-send telegram after 150bit time wait
     bool repeatTelegram;           //!< need to repeat last  telegram sent
     uint8_t collisions;            //!< Number of collisions when sending @ref sendCurTelegram
+    RxSignature rxHistory[RX_HISTORY_SIZE]; //!< The recently handed over telegrams
+    byte rxHistoryNext;            //!< The index of the next entry of rxHistory to replace
+    byte rxDestination;            //!< Whether the telegram in rx_telegram is for us, see @ref RxDestination
 };
 
 
@@ -289,6 +427,21 @@ inline void Bus::maxSendBusyRetries(int retries)
     sendBusyRetriesMax = retries;
 }
 
+inline void Bus::setMonitor(BusMonitor* monitor)
+{
+    this->monitor = monitor;
+}
+
+inline void Bus::setSendCallback(BusSendCallback* callback)
+{
+    sendCallback = callback;
+}
+
+inline void Bus::setTransceiver(TpUart* transceiver)
+{
+    this->transceiver = transceiver;
+}
+
 inline bool Bus::sendingFrame() const
 {
     return sendCurTelegram != nullptr || sendAck != 0;
@@ -14,6 +14,12 @@
 #ifndef SBLIB_KNX_BUS_CONST_H_
 #define SBLIB_KNX_BUS_CONST_H_
 
+/**
+ * Maximum size of a telegram in bytes, including the checksum.
+ * The telegram buffers of the bus and the transport layer are allocated with this size.
+ */
+#define MAX_TELEGRAM_SIZE 23
+
 /**
  * Data link layer short acknowledgment frames
  */
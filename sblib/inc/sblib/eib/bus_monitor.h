@@ -0,0 +1,137 @@
+/*
+ *  bus_monitor.h - Capture of all bus frames for a binary bus monitor stream
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_bus_monitor_h
+#define sblib_bus_monitor_h
+
+#include <sblib/types.h>
+
+class BufferedStream;
+
+/**
+ * The size of the bus monitor ring buffer in bytes. Must be a power of 2.
+ * A record of a telegram with 23 bytes needs 32 bytes.
+ */
+#define BUS_MONITOR_BUFFER_SIZE 512
+
+/**
+ * The first byte of every bus monitor record, used by the decoder to find the
+ * start of a record.
+ */
+#define BUS_MONITOR_SYNC 0xa5
+
+/**
+ * The size of the header of a bus monitor record in bytes.
+ */
+#define BUS_MONITOR_HEADER_SIZE 9
+
+/**
+ * The flags of a bus monitor record.
+ */
+enum BusMonitorFlags
+{
+    BUS_MONITOR_VALID = 0x01, //!< Parity of all bytes and the checksum are correct
+    BUS_MONITOR_ACK   = 0x02, //!< The frame is a single byte acknowledge frame
+    BUS_MONITOR_LOST  = 0x04  //!< Records were lost before this record, because the ring buffer was full
+};
+
+/**
+ * Captures every frame that the bus receives, including acknowledge frames and
+ * frames with errors, into a ring buffer, and streams the captured frames as
+ * binary records. The frames are captured in the bus timer interrupt, independent
+ * of the processing of the received telegrams by the BCU, so no frame is dropped
+ * as long as the stream keeps up with the bus.
+ *
+ * A record is stored in the ring buffer in the format it is streamed, all values
+ * are little endian:
+ *
+ *     byte 0      BUS_MONITOR_SYNC
+ *     byte 1      length of the frame in bytes
+ *     byte 2      flags, see BusMonitorFlags
+ *     byte 3..4   RX error flags of the bus, see RX_* in bus_const.h
+ *     byte 5..8   time stamp of the end of the frame in microseconds, see micros()
+ *     byte 9..    the frame, including the checksum
+ *
+ * Example:
+ *
+ *     BusMonitor monitor;
+ *     ...
+ *     serial.begin(921600);
+ *     bcu.bus->setMonitor(&monitor);
+ *     ...
+ *     monitor.stream(serial); // in loop()
+ *
+ * The host side decoder is in test/lib-test-cases/busmon.
+ */
+class BusMonitor
+{
+public:
+    /**
+     * Create a bus monitor with an empty ring buffer.
+     */
+    BusMonitor();
+
+    /**
+     * Discard all captured records and clear the lost records counter.
+     */
+    void clear();
+
+    /**
+     * Capture a frame. This method is called by the bus timer interrupt handler.
+     * If the ring buffer has no space for the record, the record is dropped and
+     * the next captured record gets the BUS_MONITOR_LOST flag.
+     *
+     * @param frame - the received frame
+     * @param length - the length of the frame in bytes
+     * @param flags - the flags of the record, see BusMonitorFlags
+     * @param errors - the RX error flags of the bus
+     */
+    void capture(const byte* frame, int length, int flags, unsigned short errors);
+
+    /**
+     * Write as many captured bytes to the stream as it can take without waiting.
+     * Call this regularly from the application's loop().
+     *
+     * @param out - the stream to write to, e.g. serial
+     * @return The number of bytes written.
+     */
+    int stream(BufferedStream& out);
+
+    /**
+     * @return The number of captured bytes that were not streamed yet.
+     */
+    int available() const;
+
+    /**
+     * @return The number of records that were dropped because the ring buffer was full.
+     */
+    unsigned int lost() const;
+
+protected:
+    volatile unsigned int head; //!< Index where the next record is captured
+    volatile unsigned int tail; //!< Index of the next byte to stream
+    unsigned int lostCount;     //!< Number of dropped records
+    bool lostRecords;           //!< Records were dropped since the last captured record
+    byte buffer[BUS_MONITOR_BUFFER_SIZE]; //!< The ring buffer
+};
+
+
+//
+//  Inline functions
+//
+
+inline int BusMonitor::available() const
+{
+    return (head - tail) & (BUS_MONITOR_BUFFER_SIZE - 1);
+}
+
+inline unsigned int BusMonitor::lost() const
+{
+    return lostCount;
+}
+
+#endif /*sblib_bus_monitor_h*/
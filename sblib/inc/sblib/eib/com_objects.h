@@ -36,6 +36,14 @@
 #include <sys/param.h>
 #include <sblib/eib/types.h>
 #include <sblib/eib/datapoint_types.h>
+#include <sblib/eib/knx_lpdu.h>
+#include <sblib/eib/apci.h>
+#include <sblib/profiler.h>
+#include <sblib/utils.h>
+
+#if defined(DUMP_COM_OBJ)
+#   include <sblib/serial.h>
+#endif
 
 class BcuBase;
 
@@ -202,7 +210,7 @@ public:
 	 *
 	 * @return The ID of the next updated com-object, @ref INVALID_OBJECT_NUMBER if none was found.
 	 */
-	int nextUpdatedObject();
+	virtual int nextUpdatedObject();
 
 	/**
 	 * Get the type of a communication object.
@@ -286,7 +294,17 @@ public:
 	 *
 	 *  @return true if a telegram was sent, otherwise false
 	 */
-	bool sendNextGroupTelegram();
+	virtual bool sendNextGroupTelegram();
+
+	/**
+	 * Test if a communication object may have a read or write request from the app
+	 * that @ref sendNextGroupTelegram() has not sent yet. This is set when a transmission
+	 * is requested and cleared when sendNextGroupTelegram() found nothing to send in all objects,
+	 * so it does not scan the objects.
+	 *
+	 * @return True if a transmission is requested, otherwise false.
+	 */
+	bool transmissionRequested() const;
 
 protected:
 	/**
@@ -358,11 +376,25 @@ protected:
 	void sendGroupWriteTelegram(int objno, int addr, bool isResponse);
 	void processGroupWriteTelegram(int objno, byte* tel);
 
+	/**
+	 * The implementations of the functions of the same name. They access the com-object
+	 * tables through self and the address tables through tables, so the calls are
+	 * resolved at compile time when Self and Tables are final classes, see ComObjectsStatic.
+	 */
+	template <class Self, class Tables> static bool sendNextGroupTelegram(Self& self, Tables& tables);
+	template <class Self> static int nextUpdatedObject(Self& self);
+	template <class Self> static int telegramObjectSize(Self& self, int objno);
+	template <class Self> static void addObjectFlags(Self& self, int objno, int flags);
+	template <class Tables> static int firstObjectAddr(Tables& tables, int objno);
+	template <class Self, class Tables> static void sendGroupWriteTelegram(Self& self, Tables& tables, int objno, int addr, bool isResponse);
+	template <class Self> static void processGroupWriteTelegram(Self& self, int objno, byte* tel);
+
     BcuBase* bcu;
     int le_ptr;
     int transmitting_object_no; //!< Object number of last transmitted bus message - status should be in transmitting
     int sendNextObjIndex;       //!< Next object number which  will be checked in sendNextGroupTelegram() for transmission
     int nextUpdatedObjIndex;    //!< Next object number which  will be checked in nextUpdatedObject() for processing by the application
+    bool transmissionPending;   //!< A transmission was requested since sendNextGroupTelegram() found nothing to send, see transmissionRequested()
 
 };
 
@@ -376,6 +408,11 @@ inline void ComObjects::objectEndian(int val)
 	le_ptr=val;
 }
 
+inline bool ComObjects::transmissionRequested() const
+{
+    return transmissionPending;
+}
+
 inline void ComObjects::processGroupTelegram(int addr, int apci, byte* tel)
 { // call with neg/invalid object
 
@@ -437,4 +474,269 @@ inline float ComObjects::objectReadFloat(int objno)
     return dpt9ToFloat(objectRead(objno));
 }
 
+/** The COMFLAG_UPDATE flag, moved to the high nibble */
+#define COMFLAG_UPDATE_HIGH (COMFLAG_UPDATE << 4)
+
+/** The COMFLAG_TRANS_MASK mask, moved to the high nibble */
+#define COMFLAG_TRANS_MASK_HIGH (COMFLAG_TRANS_MASK << 4)
+
+template <class Self>
+int ComObjects::telegramObjectSize(Self& self, int objno)
+{
+    int type = self.objectConfig(objno).type;
+    if (type < BIT_7) return 0;
+    return self.objectSize(objno);
+}
+
+template <class Self>
+void ComObjects::addObjectFlags(Self& self, int objno, int flags)
+{
+    byte* flagsTab = self.objectFlagsTable();
+    if(flagsTab == 0)
+    	return;
+
+
+    if ((flags & COMFLAG_TRANSREQ) == COMFLAG_TRANSREQ)
+        self.transmissionPending = true;
+
+    if (objno & 1)
+        flags <<= 4;
+
+    DB_COM_OBJ(serial.print(" addObjFlags in (obj, flags): ");)
+  	DB_COM_OBJ(serial.print(objno, DEC, 2);)
+    DB_COM_OBJ(serial.print(", ");)
+  	DB_COM_OBJ(serial.print(flags, HEX, 2);)
+  	DB_COM_OBJ(serial.print(", is: ");)
+  	DB_COM_OBJ(serial.print(flagsTab[objno >> 1], HEX, 2);)
+
+    flagsTab[objno >> 1] |= flags;
+
+    DB_COM_OBJ(serial.print(", out: ");)
+	DB_COM_OBJ(serial.print(flagsTab[objno >> 1], HEX, 2);)
+	DB_COM_OBJ(serial.println();)
+}
+
+template <class Tables>
+int ComObjects::firstObjectAddr(Tables& tables, int objno)
+{
+    byte* assocTab = tables.assocTable();
+    byte* assocTabEnd = assocTab + (*assocTab << 1);
+
+    for (++assocTab; assocTab < assocTabEnd; assocTab += 2)
+    {
+        if (assocTab[1] != objno)
+        {
+            continue;
+        }
+        uint16_t addressTablePos = (assocTab[0]) + 1; // +1 because first address in addressTable is our own address
+
+        if (addressTablePos > tables.addrCount())
+        {
+            continue;
+        }
+
+        byte* addr = tables.addrTable() + 1 + (assocTab[0] << 1);
+        return ((addr[0] << 8) | addr[1]);
+    }
+    return (0);
+}
+
+template <class Self, class Tables>
+void ComObjects::sendGroupWriteTelegram(Self& self, Tables& tables, int objno, int addr, bool isResponse)
+{
+    byte* valuePtr = self.objectValuePtr(objno);
+    int objSize = telegramObjectSize(self, objno);
+    byte addData = 0;
+    ApciCommand cmd;
+
+    auto sendBuffer = self.bcu->acquireSendBuffer();
+    ///\todo Set routing count and priority according to the parameters set from ETS in the EEPROM, add ID/objno for result association from bus-layer
+    initLpdu(sendBuffer, PRIORITY_LOW, false, FRAME_STANDARD);
+    setDestinationAddress(sendBuffer, addr);
+    sendBuffer[5] = 0xe0 | ((objSize + 1) & 0x0f);
+
+    isResponse ? cmd = APCI_GROUP_VALUE_RESPONSE_PDU : cmd = APCI_GROUP_VALUE_WRITE_PDU;
+
+    if (objSize)
+        reverseCopy(sendBuffer + 8, valuePtr, objSize);
+    else
+        addData = *valuePtr;
+
+    setApciCommand(sendBuffer, cmd, addData);
+
+    // Process this telegram in the receive queue (if there is a local receiver of this group address)
+    self.processGroupTelegram(addr, APCI_GROUP_VALUE_WRITE_PDU, sendBuffer, objno);
+
+    self.bcu->sendPreparedTelegram();
+    self.transmitting_object_no = objno; //save transmitting object for status check
+}
+
+template <class Self, class Tables>
+bool ComObjects::sendNextGroupTelegram(Self& self, Tables& tables)
+{
+    PROFILE_SCOPE(PROFILE_SEND_NEXT_GROUP_TELEGRAM);
+    byte* flagsTab = self.objectFlagsTable();
+    if(flagsTab == nullptr)
+    {
+        self.transmissionPending = false;
+        return (false);
+    }
+
+    uint16_t addr;
+    uint8_t flags;
+    uint16_t config;
+    uint16_t numObjs = *self.objectConfigTable(); // The first byte of the config table contains the number of com-objects
+    if (numObjs == 0)
+    {
+        self.transmissionPending = false;
+        return (false);
+    }
+    self.sendNextObjIndex %= numObjs;
+    bool fullScan = (self.sendNextObjIndex == 0);
+
+	//const ComConfig* configTab = &objectConfig(0);
+///\todo BUG This commented out section can lead to LL_BUSY responses of the Bus and it wont recover from that state
+/*
+    // pending transmission status check, switch off interrupts to avoid reading/storing changing data
+    noInterrupts();
+	if ( !(transmitting_object_no == INVALID_OBJECT_NUMBER) && bcu->bus->getBusTXStateValid() )
+	{
+		//check if state ok and update RAM Flag of object
+		if ( !bcu->bus->sendTelegramState())
+		{
+			// set RAM Status flag to ok : clear COMFLAG_TRANS_MASK	and possible DATAREQ
+         	unsigned int mask = (COMFLAG_TRANS_MASK |COMFLAG_DATAREQ )  << (transmitting_object_no & 1 ? 4 :  0);
+            flagsTab[transmitting_object_no >> 1] &= ~mask;
+		}
+		else
+		{
+            //set status to error, clear COMFLAG_TRANS_MASK and set COMFLAG_ERROR
+            unsigned int mask = (COMFLAG_TRANS_MASK |COMFLAG_DATAREQ)  << (transmitting_object_no & 1 ? 4 :  0);
+            flagsTab[transmitting_object_no >> 1] &= ~mask;
+            mask = (COMFLAG_ERROR) << (transmitting_object_no & 1 ? 4 :  0);
+            flagsTab[transmitting_object_no >> 1] |= mask;
+		}
+
+		// clear pending status check
+		transmitting_object_no = INVALID_OBJECT_NUMBER;
+		bcu->bus->setBusTXStateValid(false);
+	}
+	interrupts();
+*/
+///\todo BUG END
+    // scan all objects, read config and group address of object
+    for (uint16_t objno = self.sendNextObjIndex; objno < numObjs; ++objno)
+    {
+        // check ram-flags for read or write request first, it is much cheaper than
+        // looking up the config and the group address of every object
+        flags = flagsTab[objno >> 1];
+        if (objno & 1)
+        {
+            flags >>= 4;
+        }
+
+        if ((flags & COMFLAG_TRANSREQ) != COMFLAG_TRANSREQ)
+        {
+            continue;
+        }
+
+        const ComConfig& configTab = self.objectConfig(objno);
+        config = configTab.config;
+        addr = firstObjectAddr(tables, objno);
+
+        // check if <transmit enable> and <communication enable> is set in the config for the resp. object.
+        if ((addr == 0) || !(config & COMCONF_COMM)|| !(config & COMCONF_TRANS))
+        {
+             continue;  // no communication allowed or no grp-adr associated, next obj.
+        }
+
+        //app is triggering a object read or write request on the bus
+        if (flags & COMFLAG_DATAREQ)
+        	// app triggered a read request on the bus - no further search for local objects belonging to the same group,
+        	// they will be updated by the response to the read request
+            self.sendGroupReadTelegram(objno, addr);
+        else
+        	// app triggered a write request on the bus  and check for additional associations to Grp Addr for local writes
+        	sendGroupWriteTelegram(self, tables, objno, addr, false);
+
+        // we set the status to TRANSMITING (0x02), clear DATAREQ flag
+      	unsigned int mask = (COMFLAG_TRANS_MASK | COMFLAG_DATAREQ)  << (objno & 1 ? 4 :  0);
+        flagsTab[objno >> 1] &= ~mask;
+        mask = (COMFLAG_ERROR) << (objno & 1 ? 4 :  0);
+        flagsTab[objno >> 1] |= mask;
+
+
+        self.sendNextObjIndex = objno + 1;
+        return true;
+    }
+
+    if (fullScan)
+    {
+        self.transmissionPending = false; // no object has a transmission request
+    }
+    self.sendNextObjIndex++; // nothing found to send, lets prepare for next round
+    return false;
+}
+
+template <class Self>
+int ComObjects::nextUpdatedObject(Self& self)
+{
+    byte* flagsTab = self.objectFlagsTable();
+    if(flagsTab == nullptr)
+    {
+    	return (INVALID_OBJECT_NUMBER);
+    }
+
+    uint8_t flags;
+    uint16_t numObjs = *self.objectConfigTable(); // The first byte of the config table contains the number of com-objects
+
+    if (numObjs == 0)
+    {
+        return (INVALID_OBJECT_NUMBER);
+    }
+    self.nextUpdatedObjIndex = 0; ///\todo this is old behavior
+    //nextUpdatedObjIndex %= numObjs; ///\todo this should be a less resource intense alternative, even more could be here optimized
+
+    for (uint16_t objno = self.nextUpdatedObjIndex; objno < numObjs; ++objno)
+    {
+        flags = flagsTab[objno >> 1]; // gets the same byte twice
+
+        if (objno & 1) flags &= COMFLAG_UPDATE_HIGH; // check high or low nibble
+        else flags &= COMFLAG_UPDATE;
+
+        if (flags)
+        {
+            // fi = flags in, fo = flags out
+            DB_COM_OBJ(serial.print(" flags set obj: ", objno, DEC); serial.print(", fi: ", flags, HEX, 2); serial.print("; ");)
+
+        	flagsTab[objno >> 1] &= ~flags;
+            self.nextUpdatedObjIndex = objno + 1;
+
+            DB_COM_OBJ(serial.println(" fo: ", flagsTab[objno >> 1], HEX, 2);)
+			return objno;
+        }
+    }
+    self.nextUpdatedObjIndex++; // nothing found to send, lets prepare for next round
+    return INVALID_OBJECT_NUMBER;
+}
+
+template <class Self>
+void ComObjects::processGroupWriteTelegram(Self& self, int objno, byte* tel)
+{
+    byte* valuePtr = self.objectValuePtr(objno);
+
+    if (valuePtr == nullptr)
+    {
+        IF_DEBUG(fatalError(););
+        return;
+    }
+
+    int count = telegramObjectSize(self, objno);
+
+    if (count > 0) reverseCopy(valuePtr, tel + 8, count);
+    else *valuePtr = tel[7] & 0x3f;
+
+    addObjectFlags(self, objno, COMFLAG_UPDATE);
+}
+
 #endif /*sblib_com_objects_h*/
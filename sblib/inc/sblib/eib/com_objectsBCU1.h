@@ -34,6 +34,7 @@
 
 #include <sblib/eib/com_objects.h>
 #include <sblib/eib/typesBCU1.h>
+#include <sblib/eib/bcu_default.h>
 
 class BcuDefault;
 
@@ -57,6 +58,146 @@ public:
 	virtual byte* objectFlagsTable() override;
 
 	const ComConfigBCU1* objectConfigBCU1(int objno); ///\todo make protected again after ramLocation fix, see setup.cpp fixRamLoc(.) of 4sense-bcu1
+
+protected:
+	/**
+	 * The implementations of the virtual functions of the same name. They access the
+	 * tables through self, so the calls are resolved at compile time when Self is a
+	 * final class, see ComObjectsStatic. processGroupTelegram() reads the address
+	 * tables through tables.
+	 */
+	template <class Self> static const ComConfig& objectConfig(Self& self, int objno);
+	template <class Self> static int objectSize(Self& self, int objno);
+	template <class Self> static byte* objectValuePtr(Self& self, int objno);
+	template <class Self> static const ComConfigBCU1* objectConfigBCU1(Self& self, int objno);
+	template <class Self, class Tables>
+	static void processGroupTelegram(Self& self, Tables& tables, uint16_t addr, int apci, byte* tel, int trg_objno);
 };
 
+//
+//  Inline functions
+//
+template <class Self>
+const ComConfig& ComObjectsBCU1::objectConfig(Self& self, int objno)
+{
+    return objectConfigBCU1(self, objno)->baseConfig;
+}
+
+template <class Self>
+int ComObjectsBCU1::objectSize(Self& self, int objno)
+{
+    // The size of the object types BIT_7...VARDATA in bytes
+    const byte objectTypeSizes[10] = { 1, 1, 2, 3, 4, 6, 8, 10, 14, 14 };
+
+    int type = self.objectConfig(objno).type;
+    if (type < BIT_7)
+        return 1;
+    if (type <= VARDATA)
+        return objectTypeSizes[type - BIT_7];
+    return -1;
+}
+
+template <class Self>
+byte* ComObjectsBCU1::objectValuePtr(Self& self, int objno)
+{
+    // The object configuration
+    const ComConfigBCU1* cfg = objectConfigBCU1(self, objno);
+    if (cfg == nullptr)
+    {
+        return (nullptr);
+    }
+    uint16_t addrObjValue = cfg->dataPtr;
+    uint8_t* objValuePtr;
+    if (cfg->baseConfig.config & COMCONF_VALUE_TYPE) // 0 in user RAM, >0 in user EEPROM
+    {
+        addrObjValue += ((BcuDefault*)self.bcu)->userEeprom->startAddr();
+        objValuePtr = ((BcuDefault*)self.bcu)->userMemoryPtr(addrObjValue);
+    }
+    else
+    {
+        objValuePtr = ((BcuDefault*)self.bcu)->userMemoryPtr(addrObjValue);
+    }
+    return (objValuePtr);
+}
+
+template <class Self>
+const ComConfigBCU1* ComObjectsBCU1::objectConfigBCU1(Self& self, int objno)
+{
+    byte *objConfigTable = self.objectConfigTable();
+    if (objConfigTable == nullptr)
+    {
+        return (nullptr);
+    }
+    return (const ComConfigBCU1*) (objConfigTable + 1 + sizeof(ComConfigBCU1::DataPtrType) + objno * sizeof(ComConfigBCU1) );
+}
+
+template <class Self, class Tables>
+void ComObjectsBCU1::processGroupTelegram(Self& self, Tables& tables, uint16_t addr, int apci, byte* tel, int trg_objno)
+{
+/**
+ * Spec: Resources 4.11.2 Group Object Association Table - Realization Type 1
+ */
+    const byte* assocTab = tables.assocTable();
+    const int endAssoc = 1 + (*assocTab) * 2;
+    int objno, objConf;
+
+    DB_COM_OBJ(
+            serial.print("grpAddr ", mainGroup(addr));
+            serial.print("/", middleGroup(addr));
+            serial.print("/", lowGroup(addr));
+            serial.print(": gapos ");
+            );
+    // Convert the group address into the index of the group address table
+    const int gapos = tables.indexOfAddr(addr);
+    if (gapos < 0)
+    {
+        DB_COM_OBJ(serial.println("not found"););
+        return;
+    }
+    else
+    {
+        DB_COM_OBJ(serial.println(gapos););
+    }
+
+    // Loop over all entries in the association table, as one group address
+    // could be assigned to multiple com-objects.
+    for (int idx = 1; idx < endAssoc; idx += 2)
+    {
+        // Check if grp-address index in assoc table matches the dest grp address index
+        if (gapos != assocTab[idx])
+        {
+            continue;
+        }
+        // We found an association for our addr
+        objno = assocTab[idx + 1];  // Get the com-object number from the assoc table
+        DB_COM_OBJ(serial.println("objno  : ", objno););
+
+        if (objno == trg_objno)
+        {
+            DB_COM_OBJ(serial.println("triggered by app ", objno););
+            continue; // no update of the object triggered by the app
+        }
+
+        //DB_COM_OBJ(serial.println("commsTabAddr: 0x", ((UserEepromBCU1*)((BcuDefault*)bcu)->userEeprom)->commsTabAddr(), HEX););
+        objConf = self.objectConfig(objno).config;
+        DB_COM_OBJ(serial.println("objConf: 0x", objno, HEX, 2););
+
+
+
+        if (apci == APCI_GROUP_VALUE_WRITE_PDU || apci == APCI_GROUP_VALUE_RESPONSE_PDU)
+        {
+            // Check if communication and write are enabled
+            if ((objConf & COMCONF_WRITE_COMM) == COMCONF_WRITE_COMM)
+                processGroupWriteTelegram(self, objno, tel); // set update flag and update value of object
+        }
+        else if (apci == APCI_GROUP_VALUE_READ_PDU)
+        {
+            // Check if communication and read are enabled
+            if ((objConf & COMCONF_READ_COMM) == COMCONF_READ_COMM)
+                // we received read-request from bus - so send response back and search for more associations
+                sendGroupWriteTelegram(self, tables, objno, addr, true); // send write to the bus and update all associated local objects
+        }
+    }
+}
+
 #endif /*sblib_com_objects_BCU1_h*/
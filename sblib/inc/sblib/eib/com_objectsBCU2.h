@@ -34,6 +34,7 @@
 
 #include <sblib/eib/com_objectsBCU1.h>
 #include <sblib/eib/typesBCU2.h>
+#include <sblib/bits.h>
 
 class BcuDefault;
 
@@ -50,8 +51,53 @@ protected:
 	virtual byte* objectFlagsTable() override;
 	const ComConfig& objectConfig(int objno) override;
 
+	/**
+	 * The implementations of the virtual functions of the same name. They access the
+	 * tables through self, so the calls are resolved at compile time when Self is a
+	 * final class, see ComObjectsStatic.
+	 */
+	template <class Self> static const ComConfig& objectConfig(Self& self, int objno);
+	template <class Self> static byte* objectValuePtr(Self& self, int objno);
+
 private:
 	const ComConfigBCU2* objectConfigBCU2(int objno);
+	template <class Self> static const ComConfigBCU2* objectConfigBCU2(Self& self, int objno);
 };
 
+//
+//  Inline functions
+//
+template <class Self>
+const ComConfig& ComObjectsBCU2::objectConfig(Self& self, int objno)
+{
+    return objectConfigBCU2(self, objno)->baseConfig;
+}
+
+template <class Self>
+byte* ComObjectsBCU2::objectValuePtr(Self& self, int objno)
+{
+    // The object configuration
+    const ComConfigBCU2* cfg = objectConfigBCU2(self, objno);
+
+    // TODO Should handle userRam.segment0addr and userRam.segment1addr here
+    // if (cfg.config & COMCONF_VALUE_TYPE) // 0 if segment 0, !=0 if segment 1
+    const byte * addr = (const byte *) &cfg->dataPtr;
+    if (self.le_ptr == LITTLE_ENDIAN)
+        return ((BcuDefault*)self.bcu)->userMemoryPtr(makeWord(addr[1], addr[0]));
+    else
+        return ((BcuDefault*)self.bcu)->userMemoryPtr(makeWord(addr[0], addr[1]));
+}
+
+template <class Self>
+const ComConfigBCU2* ComObjectsBCU2::objectConfigBCU2(Self& self, int objno)
+{
+    const byte* configTable = self.objectConfigTable();
+    if (configTable == nullptr)
+    {
+        return (nullptr);
+    }
+    uint16_t offSet = 1 + sizeof(ComConfigBCU2::DataPtrType) + objno * sizeof(ComConfigBCU2);
+    return (const ComConfigBCU2*) (configTable + offSet);
+}
+
 #endif /*sblib_com_objects_BCU2_h*/
@@ -33,6 +33,7 @@
 #define sblib_com_objects_SYSTEMB_h
 
 #include <sblib/eib/com_objectsMASK0701.h>
+#include <sblib/eib/typesSYSTEMB.h>
 
 class BcuDefault;
 
@@ -42,7 +43,7 @@ public:
 	ComObjectsSYSTEMB(BcuDefault* bcuInstance) : ComObjectsMASK0701(bcuInstance) {}
 	~ComObjectsSYSTEMB() = default;
 
-	virtual inline const ComConfig& objectConfig(int objno) override;
+	virtual const ComConfig& objectConfig(int objno) override;
 
 protected:
 	virtual int objectSize(int objno) override;
@@ -51,6 +52,98 @@ protected:
 	virtual byte* objectConfigTable() override;
 	virtual byte* objectFlagsTable() override;
 
+	/**
+	 * The implementations of the virtual functions of the same name. They access the
+	 * tables through self, so the calls are resolved at compile time when Self is a
+	 * final class, see ComObjectsStatic. processGroupTelegram() reads the address
+	 * tables through tables.
+	 */
+	template <class Self> static const ComConfig& objectConfig(Self& self, int objno);
+	template <class Self> static int objectSize(Self& self, int objno);
+	template <class Self> static byte* objectValuePtr(Self& self, int objno);
+	template <class Self, class Tables>
+	static void processGroupTelegram(Self& self, Tables& tables, uint16_t addr, int apci, byte* tel, int trg_objno);
 };
 
+//
+//  Inline functions
+//
+template <class Self>
+const ComConfig& ComObjectsSYSTEMB::objectConfig(Self& self, int objno)
+{
+    return (*(const ComConfigSYSTEMB*) (self.objectConfigTable() + 2 + (objno -1) * sizeof(ComConfigSYSTEMB) )).baseConfig;
+}
+
+template <class Self>
+int ComObjectsSYSTEMB::objectSize(Self& self, int objno)
+{
+    // KNX spec v2.1 3/5/1 p. 178 (section 4.12.5.2.4.1.4)
+    // The size of the object types 6...20 in bytes
+    const byte objectTypeSizes[15] = { 1, 1, 2, 3, 4, 6, 8, 10, 14, 5, 7, 9, 11, 12, 13 };
+
+    int type = self.objectConfig(objno).type;
+    if (type < BIT_7)
+        return 1;
+    if (type < 21)
+        return objectTypeSizes[type - BIT_7];
+    if (type < 255)
+        return (type -6);
+    return 252;
+}
+
+template <class Self>
+byte* ComObjectsSYSTEMB::objectValuePtr(Self& self, int objno)
+{
+    int ramAddr = self.bcu->userRam->startAddr() + 2;
+    for (int i = 1; i < objno; i++)
+        ramAddr += self.objectSize(i);
+    return ((BcuDefault*)self.bcu)->userMemoryPtr(ramAddr);
+}
+
+template <class Self, class Tables>
+void ComObjectsSYSTEMB::processGroupTelegram(Self& self, Tables& tables, uint16_t addr, int apci, byte* tel, int trg_objno)
+{
+    //
+    // Spec: Resources 4.11.4 Group Object Association Table - Realization Type 6
+    //
+    const ComConfig* configTab = &self.objectConfig(0);
+    const byte* assocTab = tables.assocTable();
+    const int endAssoc = 2 +  makeWord(assocTab[0], assocTab[1]) * 4;   // length field has 2 octets and each entry has 4 octets on SYSTEM B
+    int objno, objConf;
+
+    // Convert the group address into the index into the group address table
+    const int gapos = tables.indexOfAddr(addr);
+    if (gapos < 0) return;
+
+    // Loop over all entries in the association table, as one group address
+    // could be assigned to multiple com-objects.
+    for (int idx = 2; idx < endAssoc; idx += 4)
+    {
+        // Check if grp-address index in assoc table matches the dest grp address index
+        int gadest = makeWord(assocTab[idx], assocTab[idx +1]); // get destination group address index
+        if (gapos == gadest) // We found an association for our addr
+        {
+            objno = makeWord(assocTab[idx +2], assocTab[idx +3]);  // Get the com-object number from the assoc table
+            if (objno == trg_objno)
+             	continue; // no update of the object triggered by the app
+
+            objConf = configTab[objno].config;
+
+            if (apci == APCI_GROUP_VALUE_WRITE_PDU || apci == APCI_GROUP_VALUE_RESPONSE_PDU)
+            {
+                // Check if communication and write are enabled
+                if ((objConf & COMCONF_WRITE_COMM) == COMCONF_WRITE_COMM)
+                    processGroupWriteTelegram(self, objno, tel); // set update flag and update value of object
+            }
+            else if (apci == APCI_GROUP_VALUE_READ_PDU)
+            {
+                // Check if communication and read are enabled
+                if ((objConf & COMCONF_READ_COMM) == COMCONF_READ_COMM)
+                   	// we received read-request from bus - so send response back and search for more associations
+                    sendGroupWriteTelegram(self, tables, objno, addr, true);
+            }
+        }
+    }
+}
+
 #endif /*sblib_com_objects_SYSTEMB_h*/
@@ -0,0 +1,191 @@
+/*
+ *  ft12_interface.h - Serial KNX data link interface with FT1.2 framing
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_ft12_interface_h
+#define sblib_ft12_interface_h
+
+#include <sblib/eib/bus.h>
+#include <sblib/types.h>
+
+class BcuBase;
+class BufferedStream;
+
+/**
+ * The send window: the number of L_Data.req telegrams that the host can have in
+ * flight. The interface does not report the window to the host, it must be
+ * configured to this size on the host.
+ */
+#define FT12_WINDOW_SIZE 4
+
+/**
+ * The maximum size of a telegram in bytes, including the checksum.
+ */
+#define FT12_MAX_TELEGRAM_SIZE MAX_TELEGRAM_SIZE
+
+/**
+ * The time in milliseconds after which an incomplete frame from the host is discarded.
+ */
+#define FT12_RX_TIMEOUT 50
+
+/** The message codes of the user data, EMI2 format */
+enum Ft12MessageCode
+{
+    FT12_L_DATA_REQ = 0x11, //!< Host requests to send a telegram
+    FT12_L_DATA_CON = 0x2e, //!< Confirmation that sending a requested telegram has ended
+    FT12_L_DATA_IND = 0x29  //!< Telegram received from the bus
+};
+
+/**
+ * A serial data link interface, so a host gateway can send and receive telegrams
+ * through the board at the full rate of the bus.
+ *
+ * The frames on the serial port use the FT1.2 framing:
+ *
+ *     fixed length frame:    10 CF CS 16
+ *     variable length frame: 68 L L 68 CF data... CS 16
+ *     acknowledge:           E5
+ *
+ * L is the number of bytes of CF and the data, CS the sum of CF and the data modulo 256.
+ * The host resets the link with the fixed frame 10 40 40 16 and sends user data with
+ * the control field 73 and 53, the frame count bit (0x20) toggles with every new frame.
+ * Every correct frame from the host is acknowledged with E5. A frame with the same frame
+ * count bit as the previous one is a repetition, it is acknowledged but not processed
+ * again.
+ *
+ * The data of a user data frame starts with the message code, followed by the telegram
+ * without the checksum: control byte, source address, destination address, address type,
+ * hop count and length, TPDU. The interface sends the source address of the BCU.
+ *
+ * Flow control uses a fixed send window of FT12_WINDOW_SIZE telegrams: the host may have
+ * up to FT12_WINDOW_SIZE L_Data.req in flight, a L_Data.con closes one of them. The
+ * telegrams are sent on the bus in the order they were requested, so the host can
+ * pipeline the telegrams without waiting for the bus. A L_Data.req beyond the window is
+ * not acknowledged, the host repeats it after its acknowledge timeout. A reset does not
+ * discard requested telegrams.
+ *
+ * The L_Data.con and L_Data.ind frames to the host use the control field F3 and D3.
+ * They are sent as soon as the serial port can take them, without waiting for the
+ * acknowledge of the host, acknowledges from the host are ignored. In a L_Data.con
+ * bit 0 of the control byte of the telegram is set if the telegram was not acknowledged
+ * on the bus, not even after repeating it.
+ *
+ * Example:
+ *
+ *     Ft12Interface knxInterface(&bcu, serial);
+ *     ...
+ *     serial.begin(19200, SERIAL_8E1);
+ *     knxInterface.begin();
+ *     ...
+ *     knxInterface.loop(); // in loop()
+ */
+class Ft12Interface: public BusSendCallback
+{
+public:
+    /**
+     * Create a serial data link interface.
+     *
+     * @param bcu - the BCU whose bus is used
+     * @param port - the serial port to the host, e.g. serial
+     */
+    Ft12Interface(BcuBase* bcu, BufferedStream& port);
+
+    /**
+     * Begin using the interface. This disables the transport layer of the BCU,
+     * so the received telegrams are passed to the host. end() restores the
+     * status of the BCU.
+     */
+    void begin();
+
+    /**
+     * End using the interface.
+     */
+    void end();
+
+    /**
+     * Process the data from the host and the bus. Call this regularly from the
+     * application's loop().
+     */
+    void loop();
+
+    /**
+     * @return The number of L_Data.req that the host can send now, without waiting for a L_Data.con.
+     */
+    int freeSlots() const;
+
+    /**
+     * Called from the bus timer interrupt handler when sending a telegram has ended.
+     */
+    virtual void telegramSent(byte* telegram, bool successful) override;
+
+protected:
+    /** The states of a telegram in the send queue */
+    enum SlotState
+    {
+        SLOT_FREE,    //!< Not used
+        SLOT_WAITING, //!< Waiting to be sent
+        SLOT_SENDING, //!< Handed to the bus
+        SLOT_SENT,    //!< Sent and acknowledged, waiting for the L_Data.con
+        SLOT_FAILED   //!< Not sent or not acknowledged, waiting for the L_Data.con
+    };
+
+    /** A telegram of the send queue */
+    struct Slot
+    {
+        volatile byte state;                    //!< The state, see SlotState
+        byte length;                            //!< The length of the telegram without checksum
+        byte telegram[FT12_MAX_TELEGRAM_SIZE];  //!< The telegram, with space for the checksum
+    };
+
+    /**
+     * Process a byte from the host.
+     */
+    void receivedByte(byte ch);
+
+    /**
+     * Process a complete frame from the host, frame[] holds CF and the data.
+     *
+     * @param length - the number of bytes in frame[]
+     * @param fixed - true for a fixed length frame
+     */
+    void receivedFrame(int length, bool fixed);
+
+    /**
+     * Process a L_Data.req.
+     *
+     * @return False if the send queue is full, true if not.
+     */
+    bool requestSend(const byte* data, int length);
+
+    /**
+     * Send a variable length frame to the host.
+     *
+     * @param code - the message code
+     * @param telegram - the telegram
+     * @param length - the length of the telegram without checksum
+     * @param ctrlBits - bits to set in the control byte of the telegram
+     * @return True if sent, false if the serial port can not take the frame now.
+     */
+    bool sendFrame(byte code, const byte* telegram, int length, byte ctrlBits = 0);
+
+    BcuBase* bcu;            //!< The BCU whose bus is used
+    BufferedStream& port;    //!< The serial port to the host
+    Slot queue[FT12_WINDOW_SIZE]; //!< The send queue, in the order of the requests
+    byte first;              //!< Index of the oldest telegram in queue[]
+    byte count;              //!< Number of used slots of queue[]
+    byte rxState;            //!< State of receiving a frame from the host
+    byte rxLength;           //!< The length field of the variable length frame
+    byte rxPos;              //!< Number of bytes in frame[]
+    byte rxSum;              //!< Checksum of the bytes in frame[]
+    bool hostFcb;            //!< Frame count bit of the last processed frame from the host
+    bool sendFcb;            //!< Frame count bit of the next frame to the host
+    unsigned int rxTime;     //!< Time of the last received byte, for the timeout
+    bool active;             //!< The interface is in use, between begin() and end()
+    byte savedStatus;        //!< The status of the BCU before begin(), restored by end()
+    byte frame[FT12_MAX_TELEGRAM_SIZE + 1]; //!< The frame from the host: CF and data
+};
+
+#endif /*sblib_ft12_interface_h*/
@@ -25,6 +25,8 @@
 #include <stdint.h>
 #include <sblib/eib/knx_tpdu.h>
 #include <sblib/eib/apci.h>
+#include <sblib/eib/bus_const.h>
+#include <sblib/timer_wheel.h>
 
 
 #define TL4_CONNECTION_TIMEOUT_MS (6000) //!< Transport layer 4 connection timeout in milliseconds
@@ -52,8 +54,7 @@ public:
         OPEN_IDLE,
         OPEN_WAIT
     };
-    TLayer4(uint8_t maxTelegramLength);
-    TLayer4() = delete;
+    TLayer4();
     virtual ~TLayer4() = default;
 
     /**
@@ -71,6 +72,13 @@ public:
      */
     bool directConnection();
 
+    /**
+     * Test if a telegram is waiting in the send buffer to be sent.
+     *
+     * @return True if the send buffer is in use, otherwise false.
+     */
+    bool sendTelegramPending();
+
     /**
      * The transport layer 4 processing loop. This is like the application's loop() function,
      * and is called automatically by the libraries main() when the BCU is activated with bcu.begin().
@@ -292,22 +300,22 @@ private:
     int8_t seqNoRcv = -1;                       //!< Sequence number of the last telegram received from connected partner
     int8_t repCount = 0;                        //!< Telegram repetition count
     int8_t conCtrlRepCount = 0;                 //!< Connection control telegram repetition count
-    uint32_t connectedTime = 0;                 //!< System time of the last connection oriented telegram
-    uint32_t sentTelegramTime = 0;              //!< System time of the last sent telegram
+    SoftTimer connectionTimer;                  //!< Connection timeout, restarted by every connection oriented telegram
+    SoftTimer ackTimer;                         //!< Acknowledge timeout of the last sent telegram
 
     volatile uint16_t ownAddr;                  //!< Our own physical address on the bus
 
     /**
      * A buffer for the telegram to send.
      */
-    byte *sendTelegram;
+    byte sendTelegram[MAX_TELEGRAM_SIZE];
 
     /**
      * Two buffers for connection-oriented telegrams to send. Separate from @ref sendTelegram as repeated sending
      * can be necessary after seconds, while other telegrams can be received and transmitted.
      */
-    byte *sendConnectedTelegram;
-    byte *sendConnectedTelegram2;
+    byte sendConnectedTelegram[MAX_TELEGRAM_SIZE];
+    byte sendConnectedTelegram2[MAX_TELEGRAM_SIZE];
 
     enum SendTelegramBufferState
     {
@@ -326,6 +334,11 @@ inline bool TLayer4::directConnection()
     return (state != TLayer4::CLOSED);
 }
 
+inline bool TLayer4::sendTelegramPending()
+{
+    return (sendTelegramBufferState != TELEGRAM_FREE);
+}
+
 inline uint16_t TLayer4::ownAddress()
 {
     ///\todo bus.ownAddress should also only return uint16_t
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <sblib/types.h>
+#include <sblib/platform.h>
 
 /**
  * Class for basic memory operations.
@@ -116,6 +117,45 @@ private:
 
 };
 
+/**
+ * Statically allocated data of a memory class.
+ * @details The data is a global array, so its size is known at link time and shows up in the
+ *          map file of the linker. The default constructor of a memory class uses the data
+ *          with the class itself as tag, so all objects created with it share the same data.
+ *          An object that is used at the same time as another one of the same class needs its
+ *          own data with another tag, see @ref memoryData().
+ *
+ * @tparam T    - the memory class that uses the data
+ * @tparam size - the size of the data in bytes
+ * @tparam Tag  - selects the data, every tag has its own data
+ */
+template <class T, uint32_t size, class Tag = T>
+struct MemoryData
+{
+    static byte data[size] __attribute__ ((aligned (FLASH_RAM_BUFFER_ALIGNMENT))); //!< word aligned, so it can be flashed
+};
+
+template <class T, uint32_t size, class Tag>
+byte MemoryData<T, size, Tag>::data[size];
+
+/**
+ * Get the statically allocated data of the memory class T for the given tag.
+ *
+ * Example, two BCUs of the same mask used at the same time:
+ * @code
+ * struct SecondBcu;
+ * new UserEepromBCU2(memoryData<UserEepromBCU2, SecondBcu>());
+ * @endcode
+ *
+ * @tparam T   - the memory class, e.g. UserRamBCU2 or UserEepromBCU2
+ * @tparam Tag - any type, every tag has its own data
+ * @return The data, T::dataSize bytes
+ */
+template <class T, class Tag>
+inline byte* memoryData()
+{
+    return MemoryData<T, T::dataSize, Tag>::data;
+}
 
 #endif /* SBLIB_EIB_MEMORY_H_ */
 /** @}*/
@@ -237,6 +237,15 @@ public:
 
 	virtual const PropertyDef* propertyDef(int objectIdx, PropertyID propertyId);
 
+	/**
+	 * Get the number of properties of an interface object.
+	 *
+	 * @param objectIdx - the index of the interface object.
+	 *
+	 * @return The number of properties, 0 if the interface object does not exist.
+	 */
+	int numProperties(int objectIdx);
+
 	virtual LoadState handleLoadStateMachine(const int objectIdx, const byte* data, const int len);
 
 	virtual LoadState handleAllocAbsTaskSegment(const int objectIdx, const byte* payLoad, const int len);
@@ -306,6 +315,19 @@ protected:
 private:
 	BCU2* bcu;
 
+	/**
+	 * The number of properties of the interface objects, counted on the first use, 0 if not counted yet.
+	 * The tables are kept in the order of the spec, because the properties are also read by their index.
+	 */
+	byte propertyCount[NUM_PROP_OBJECTS] = {};
+
+	/**
+	 * The result of the last lookup of propertyDef(). A property is looked up several times in a row,
+	 * e.g. ETS reads its description before its value.
+	 */
+	const PropertyDef* lastPropertyDef = nullptr;
+	int lastObjectIdx = -1; //!< The interface object of lastPropertyDef
+
 	/**
 	 * The properties of the device object
 	 * See KNX Spec 06 Profiles/Annex A p.103 and 9/4/1 p.50
@@ -0,0 +1,179 @@
+/*
+ *  tp_uart.h - Data link layer on a TP transceiver chip that is attached to a serial port
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_tp_uart_h
+#define sblib_tp_uart_h
+
+#include <sblib/types.h>
+#include <sblib/buffered_stream.h>
+
+class Bus;
+
+/**
+ * The time in milliseconds after which an incomplete frame from the transceiver is discarded.
+ * The transceiver passes the bytes of a frame on as they are received from the bus,
+ * one every 1.35 milliseconds.
+ */
+#define TP_UART_RX_TIMEOUT 3
+
+/**
+ * The time in milliseconds after which a telegram is confirmed negatively when the
+ * transceiver does not confirm it. The transceiver confirms every telegram by itself,
+ * this only covers lost bytes.
+ */
+#define TP_UART_CON_TIMEOUT 1000
+
+/** The services from the host to the transceiver */
+enum TpUartRequest
+{
+    TP_UART_RESET_REQ     = 0x01, //!< U_Reset.req: reset the transceiver
+    TP_UART_STATE_REQ     = 0x02, //!< U_State.req: request a U_State.ind
+    TP_UART_ACK_INFO      = 0x10, //!< U_AckInformation: how to acknowledge the received frame, or'ed with TP_UART_ACK_*
+    TP_UART_DATA_START    = 0x80, //!< U_L_DataStart: followed by the first byte of the frame to send
+    TP_UART_DATA_CONTINUE = 0x80, //!< U_L_DataContinue: or'ed with the index of the byte that follows
+    TP_UART_DATA_END      = 0x40  //!< U_L_DataEnd: or'ed with the index of the checksum that follows
+};
+
+/** The flags of U_AckInformation */
+enum TpUartAckFlags
+{
+    TP_UART_ACK_ADDRESSED = 0x01, //!< The frame is for us, acknowledge it
+    TP_UART_ACK_BUSY      = 0x02, //!< Answer with busy
+    TP_UART_ACK_NACK      = 0x04  //!< Answer with not acknowledged
+};
+
+/** The services from the transceiver to the host, besides the received frames */
+enum TpUartIndication
+{
+    TP_UART_RESET_IND = 0x03, //!< U_Reset.ind: the transceiver was reset
+    TP_UART_STATE_IND = 0x07, //!< U_State.ind: the lower 3 bits, the upper 5 bits are the state flags
+    TP_UART_DATA_CON  = 0x0b  //!< L_Data.con: the lower 7 bits, bit 7 is set if the frame was acknowledged
+};
+
+/**
+ * A data link layer on a TP transceiver chip with a UART interface, like the
+ * TP-UART or the NCN5120. The transceiver does the bit timing, the acknowledge
+ * frames and the repetitions on the bus, so the processor only handles whole
+ * frames instead of the bus timer interrupts of every bit.
+ *
+ * The frames on the serial port:
+ *
+ *     received frame:  the bytes of the frame, as they are received from the bus
+ *     acknowledge:     U_AckInformation, sent after the destination address of a received frame,
+ *                      addressed, or addressed and busy if the received telegram was not processed yet
+ *     sending a frame: 80 byte0 81 byte1 ... 80+i byte_i ... 40+n checksum, n is the index of the checksum
+ *     confirmation:    L_Data.con 8B if the frame was acknowledged, 0B if not
+ *
+ * The transceiver passes the sent frames back as received frames, they are ignored.
+ *
+ * The transceiver is used by the bus instead of the bus timer. The higher layers
+ * use the bus as usual. The bytes from the transceiver are processed in the receive
+ * interrupt of the serial port, like the bus timer interrupt processes the bits,
+ * because the acknowledge must be sent within a few milliseconds. The bus' loop()
+ * only handles the timeouts.
+ *
+ * Example:
+ *
+ *     TpUart transceiver(serial);
+ *     ...
+ *     serial.begin(19200, SERIAL_8E1);
+ *     bcu->bus->setTransceiver(&transceiver);
+ *     bcu->begin(...);
+ */
+class TpUart: public StreamReceiveCallback
+{
+public:
+    /**
+     * Create a transceiver.
+     *
+     * @param port - the serial port of the transceiver, e.g. serial
+     */
+    TpUart(BufferedStream& port);
+
+    /**
+     * Begin using the transceiver. This is called by Bus::begin(), it resets the transceiver.
+     *
+     * @param bus - the bus that uses the transceiver
+     */
+    void begin(Bus* bus);
+
+    /**
+     * Handle the timeouts of receiving and of the confirmation. This is called by Bus::loop().
+     */
+    void loop();
+
+    /**
+     * Process a byte from the transceiver. This is called from the receive interrupt
+     * of the serial port.
+     */
+    virtual void byteReceived(byte ch) override;
+
+    /**
+     * Send the telegram of Bus::sendCurTelegram. This is called by Bus::sendTelegram().
+     * The telegram is written when the transceiver has finished resetting.
+     *
+     * @param telegram - the telegram, with the checksum
+     * @param length - the length of the telegram, with the checksum
+     */
+    void send(const byte* telegram, int length);
+
+    /**
+     * @return The state flags of the last U_State.ind, or 0.
+     */
+    byte state() const;
+
+protected:
+    /**
+     * Discard the frame being received if no byte was received for @ref TP_UART_RX_TIMEOUT.
+     * Call with the interrupts disabled, or from the receive interrupt.
+     */
+    void checkReceiveTimeout();
+
+    /**
+     * Process a byte of a received frame.
+     */
+    void receivedFrameByte(byte ch);
+
+    /**
+     * Send U_AckInformation for the received frame, after its destination address.
+     */
+    void acknowledgeFrame();
+
+    /**
+     * Write the telegram to send to the transceiver.
+     */
+    void writeFrame();
+
+    /**
+     * Notify the bus that sending the telegram has ended.
+     *
+     * @param successful - true if the telegram was acknowledged
+     */
+    void confirm(bool successful);
+
+    Bus* bus;                //!< The bus that uses the transceiver
+    BufferedStream& port;    //!< The serial port of the transceiver
+    byte rxState;            //!< State of receiving from the transceiver
+    byte rxChecksum;         //!< Checksum of the received bytes of the frame
+    int rxLength;            //!< The length of the received frame, 0 until it is known
+    unsigned int rxTime;     //!< Time of the last received byte, for the timeout
+    byte txState;            //!< State of sending the telegram of Bus::sendCurTelegram
+    int txLength;            //!< The length of the telegram to send
+    unsigned int txTime;     //!< Time when the telegram was written, for the confirmation timeout
+    bool resetPending;       //!< A U_Reset.req was sent, waiting for the U_Reset.ind
+    byte lastState;          //!< The state flags of the last U_State.ind
+};
+
+//
+//  Inline functions
+//
+inline byte TpUart::state() const
+{
+    return lastState;
+}
+
+#endif /*sblib_tp_uart_h*/
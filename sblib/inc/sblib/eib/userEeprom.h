@@ -16,6 +16,9 @@
 /** number of interface objects supported */
 #define INTERFACE_OBJECT_COUNT 8
 
+/** The time in milliseconds the user EEPROM waits after its last modification before it is written to flash */
+#define USER_EEPROM_WRITE_DELAY 50
+
 /**
  * The user EEPROM
  * @details Can be accessed by name, like userEeprom.manuDataH() and as an array, like
@@ -31,10 +34,20 @@ class UserEeprom : public Memory
 {
 public:
     UserEeprom() = delete;
-    UserEeprom(unsigned int start, unsigned int size, unsigned int flashSize);
+
+    /**
+     * Create the user EEPROM and read its content from the flash.
+     *
+     * @param start     - the start address of the user EEPROM
+     * @param size      - the size of the user EEPROM in bytes
+     * @param flashSize - the size of the flash area that holds the user EEPROM in bytes
+     * @param data      - the data of the user EEPROM, see @ref MemoryData. Must be word aligned,
+     *                    otherwise iapProgram will fail.
+     */
+    UserEeprom(unsigned int start, unsigned int size, unsigned int flashSize, byte* data);
 	~UserEeprom() = default;
 
-	__attribute__ ((aligned (FLASH_RAM_BUFFER_ALIGNMENT))) byte *userEepromData; // must be word aligned, otherwise iapProgram will fail
+	byte *userEepromData;
 
     virtual byte& optionReg() const = 0;
     virtual byte& manuDataH() const = 0;
@@ -86,8 +99,21 @@ public:
      */
     bool isModified() const;
 
+    /**
+     * Test if the write delay of the modified user EEPROM is elapsed.
+     *
+     * @return True if the user EEPROM is not modified or was modified at least
+     *         @ref USER_EEPROM_WRITE_DELAY milliseconds ago.
+     */
     bool writeDelayElapsed() const;
 
+    /**
+     * Get the time until @ref writeDelayElapsed() becomes true.
+     *
+     * @return The number of milliseconds, 0 if the write delay is elapsed.
+     */
+    unsigned int writeDelayRemaining() const;
+
     uint32_t flashSize() const;
 
     unsigned int numEepromPages() const;
@@ -15,7 +15,15 @@
 class UserEepromBCU1 : public UserEeprom
 {
 public:
-    UserEepromBCU1() : UserEeprom(0x100, 256, 256) {};
+    static const unsigned int userEepromSize = 256; //!< Size of the user EEPROM in bytes
+    static const unsigned int dataSize = userEepromSize; //!< Size of the data, see @ref MemoryData
+
+    UserEepromBCU1() : UserEepromBCU1(MemoryData<UserEepromBCU1, dataSize>::data) {}
+
+    /**
+     * Create the user EEPROM with other data than the default one, see @ref memoryData().
+     */
+    explicit UserEepromBCU1(byte* data) : UserEeprom(0x100, userEepromSize, 256, data) {}
 	~UserEepromBCU1() = default;
 
 	static const int optionRegOffset         = 0x00; //!< 0x0100: EEPROM option register
@@ -73,7 +81,7 @@ public:
     virtual byte& checksum() const { return userEepromData[checksumOffset]; }
 
 protected:
-	UserEepromBCU1(unsigned int start, unsigned int size, unsigned int flashSize) : UserEeprom(start, size, flashSize) {};
+	UserEepromBCU1(unsigned int start, unsigned int size, unsigned int flashSize, byte* data) : UserEeprom(start, size, flashSize, data) {};
 };
 
 #endif /*sblib_usereeprom_bcu1_h*/
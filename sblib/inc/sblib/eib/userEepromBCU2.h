@@ -15,7 +15,15 @@
 class UserEepromBCU2 : public UserEepromBCU1
 {
 public:
-    UserEepromBCU2() : UserEepromBCU1(0x100, 1024, 1024) {};
+    static const unsigned int userEepromSize = 1024; //!< Size of the user EEPROM in bytes
+    static const unsigned int dataSize = userEepromSize; //!< Size of the data, see @ref MemoryData
+
+    UserEepromBCU2() : UserEepromBCU2(MemoryData<UserEepromBCU2, dataSize>::data) {}
+
+    /**
+     * Create the user EEPROM with other data than the default one, see @ref memoryData().
+     */
+    explicit UserEepromBCU2(byte* data) : UserEepromBCU1(0x100, userEepromSize, 1024, data) {}
 	~UserEepromBCU2() = default;
 
 	static const int appTypeOffset        = 0x015; //!< 0x0115: \todo Application program type: 0=BCU2, else BCU1
@@ -68,7 +76,7 @@ public:
 	virtual byte* orderInfo() const { return &userEepromData[orderInfoOffset]; }
 
 protected:
-	UserEepromBCU2(unsigned int start, unsigned int size, unsigned int flashSize) : UserEepromBCU1(start, size, flashSize) {};
+	UserEepromBCU2(unsigned int start, unsigned int size, unsigned int flashSize, byte* data) : UserEepromBCU1(start, size, flashSize, data) {};
 };
 
 #endif /*sblib_usereeprom_bcu2_h*/
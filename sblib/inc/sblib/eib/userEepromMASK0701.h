@@ -15,12 +15,20 @@
 class UserEepromMASK0701 : public UserEepromBCU2
 {
 public:
+    static const unsigned int userEepromSize = 3072; //!< Size of the user EEPROM in bytes
+    static const unsigned int dataSize = userEepromSize; //!< Size of the data, see @ref MemoryData
+
     ///\todo make start at 0x4000, right now 0x4000-0x100= 0x3f00 is chosen to avoid address-offset calculations to a BCU1
-    UserEepromMASK0701() : UserEepromBCU2(0x3f00, 3072, 4096) {};
+    UserEepromMASK0701() : UserEepromMASK0701(MemoryData<UserEepromMASK0701, dataSize>::data) {}
+
+    /**
+     * Create the user EEPROM with other data than the default one, see @ref memoryData().
+     */
+    explicit UserEepromMASK0701(byte* data) : UserEepromBCU2(0x3f00, userEepromSize, 4096, data) {}
 	~UserEepromMASK0701() = default;
 
 protected:
-	UserEepromMASK0701(unsigned int start, unsigned int size, unsigned int flashSize) : UserEepromBCU2(start, size, flashSize) {};
+	UserEepromMASK0701(unsigned int start, unsigned int size, unsigned int flashSize, byte* data) : UserEepromBCU2(start, size, flashSize, data) {};
 };
 
 #endif /*sblib_usereeprom_mask0701_h*/
@@ -9,12 +9,20 @@
 class UserEepromMASK0705 : public UserEepromMASK0701
 {
 public:
+	static const unsigned int userEepromSize = 3072; //!< Size of the user EEPROM in bytes
+	static const unsigned int dataSize = userEepromSize; //!< Size of the data, see @ref MemoryData
+
     ///\todo make start at 0x4000, right now 0x4000-0x100= 0x3f00 is chosen to avoid address-offset calculations to a BCU1
-	UserEepromMASK0705() : UserEepromMASK0701(0x3f00, 3072, 4096) {};
+	UserEepromMASK0705() : UserEepromMASK0705(MemoryData<UserEepromMASK0705, dataSize>::data) {}
+
+	/**
+	 * Create the user EEPROM with other data than the default one, see @ref memoryData().
+	 */
+	explicit UserEepromMASK0705(byte* data) : UserEepromMASK0701(0x3f00, userEepromSize, 4096, data) {}
 	~UserEepromMASK0705() = default;
 
 protected:
-	UserEepromMASK0705(unsigned int start, unsigned int size, unsigned int flashSize) : UserEepromMASK0701(start, size, flashSize) {};
+	UserEepromMASK0705(unsigned int start, unsigned int size, unsigned int flashSize, byte* data) : UserEepromMASK0701(start, size, flashSize, data) {};
 };
 
 #endif /*sblib_usereeprom_mask0705_h*/
@@ -9,8 +9,16 @@
 class UserEepromSYSTEMB : public UserEepromMASK0701
 {
 public:
+	static const unsigned int userEepromSize = 3072; //!< Size of the user EEPROM in bytes
+	static const unsigned int dataSize = userEepromSize; //!< Size of the data, see @ref MemoryData
+
     ///\todo check start of 0x3300, maybe the same reason like for 0x0701 -> -0x100 is chosen to avoid address-offset calculations to a BCU1
-	UserEepromSYSTEMB() : UserEepromMASK0701(0x3300, 3072, 4096) {};
+	UserEepromSYSTEMB() : UserEepromSYSTEMB(MemoryData<UserEepromSYSTEMB, dataSize>::data) {}
+
+	/**
+	 * Create the user EEPROM with other data than the default one, see @ref memoryData().
+	 */
+	explicit UserEepromSYSTEMB(byte* data) : UserEepromMASK0701(0x3300, userEepromSize, 4096, data) {}
 	~UserEepromSYSTEMB() = default;
 
 	static const int addrTabAddrOffset  = 0x21; //!< 0x3321-0x3322
@@ -33,7 +41,7 @@ public:
 	virtual byte* eibObjMcb() const { return &userEepromData[eibObjMcbOffset]; }
 
 protected:
-	UserEepromSYSTEMB(unsigned int start, unsigned int size, unsigned int flashSize) : UserEepromMASK0701(start, size, flashSize) {};
+	UserEepromSYSTEMB(unsigned int start, unsigned int size, unsigned int flashSize, byte* data) : UserEepromMASK0701(start, size, flashSize, data) {};
 };
 
 #endif /*sblib_usereeprom_systemb_h*/
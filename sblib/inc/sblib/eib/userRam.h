@@ -52,7 +52,16 @@ class UserRam : public Memory
 public:
     UserRam() = delete;
     ~UserRam() = default;
-    UserRam(uint32_t start, uint32_t size, uint32_t shadowSize);
+
+    /**
+     * Create the user RAM.
+     *
+     * @param start      - the start address of the user RAM
+     * @param size       - the size of the user RAM in bytes
+     * @param shadowSize - the size of the shadow area behind the user RAM in bytes
+     * @param data       - the data of the user RAM and the shadow area, see @ref MemoryData
+     */
+    UserRam(uint32_t start, uint32_t size, uint32_t shadowSize, uint8_t* data);
 
     /**
      * System status. See enum @ref BcuStatus
@@ -21,7 +21,16 @@
 class UserRamBCU1 : public UserRam
 {
 public:
-	UserRamBCU1() : UserRam(0, 0x100, 3) {}
+	static const uint32_t userRamSize = 0x100; //!< Size of the user RAM in bytes
+	static const uint32_t userRamShadowSize = 3; //!< Size of the shadow area behind the user RAM in bytes
+	static const uint32_t dataSize = userRamSize + userRamShadowSize; //!< Size of the data, see @ref MemoryData
+
+	UserRamBCU1() : UserRamBCU1(MemoryData<UserRamBCU1, dataSize>::data) {}
+
+	/**
+	 * Create the user RAM with other data than the default one, see @ref memoryData().
+	 */
+	explicit UserRamBCU1(uint8_t* data) : UserRam(0, userRamSize, userRamShadowSize, data) {}
 
 
     static const uint32_t _runStateOffset = 0x61; ///\todo properties still need this to be public
@@ -36,7 +45,7 @@ public:
 	virtual uint8_t& peiType() const override{ return userRamData[_peiTypeOffset]; }
 
 protected:
-	UserRamBCU1(unsigned int start, unsigned int size, unsigned int shadowSize) : UserRam(start, size, shadowSize) {}
+	UserRamBCU1(unsigned int start, unsigned int size, unsigned int shadowSize, uint8_t* data) : UserRam(start, size, shadowSize, data) {}
 
     virtual uint32_t statusOffset() const override {return _statusOffset;}
     virtual uint32_t runStateOffset() const override {return _runStateOffset;}
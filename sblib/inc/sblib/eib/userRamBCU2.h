@@ -17,11 +17,20 @@
 class UserRamBCU2 : public UserRamBCU1
 {
 public:
+    static const uint32_t userRamSize = 0x100; //!< Size of the user RAM in bytes
+    static const uint32_t userRamShadowSize = 3; //!< Size of the shadow area behind the user RAM in bytes
+    static const uint32_t dataSize = userRamSize + userRamShadowSize; //!< Size of the data, see @ref MemoryData
+
     ///\todo BUG? Check this, originally (pre OOP) shadowSize was 0 but i think total size of class UserRam is 258 bytes and not 256 like before with 0
-    UserRamBCU2() : UserRamBCU1(0, 0x100, 3) {};
+    UserRamBCU2() : UserRamBCU2(MemoryData<UserRamBCU2, dataSize>::data) {}
+
+    /**
+     * Create the user RAM with other data than the default one, see @ref memoryData().
+     */
+    explicit UserRamBCU2(uint8_t* data) : UserRamBCU1(0, userRamSize, userRamShadowSize, data) {}
 
 protected:
-	UserRamBCU2(uint32_t start, uint32_t size, uint32_t shadowSize) : UserRamBCU1(start, size, shadowSize) {}
+	UserRamBCU2(uint32_t start, uint32_t size, uint32_t shadowSize, uint8_t* data) : UserRamBCU1(start, size, shadowSize, data) {}
 };
 
 #endif /* SBLIB_EIB_USERRAM_BCU2_H_ */
@@ -17,10 +17,19 @@
 class UserRamMASK0705 : public UserRamMASK0701
 {
 public:
-	UserRamMASK0705() : UserRamMASK0701(0x5FC, 0x304, 3) {}
+	static const uint32_t userRamSize = 0x304; //!< Size of the user RAM in bytes
+	static const uint32_t userRamShadowSize = 3; //!< Size of the shadow area behind the user RAM in bytes
+	static const uint32_t dataSize = userRamSize + userRamShadowSize; //!< Size of the data, see @ref MemoryData
+
+	UserRamMASK0705() : UserRamMASK0705(MemoryData<UserRamMASK0705, dataSize>::data) {}
+
+	/**
+	 * Create the user RAM with other data than the default one, see @ref memoryData().
+	 */
+	explicit UserRamMASK0705(uint8_t* data) : UserRamMASK0701(0x5FC, userRamSize, userRamShadowSize, data) {}
 
 protected:
-	UserRamMASK0705(uint32_t start, uint32_t size, uint32_t shadowSize) : UserRamMASK0701(start, size, shadowSize) {}
+	UserRamMASK0705(uint32_t start, uint32_t size, uint32_t shadowSize, uint8_t* data) : UserRamMASK0701(start, size, shadowSize, data) {}
 
 private:
 };
@@ -17,10 +17,19 @@
 class UserRamSYSTEMB : public UserRamMASK0701
 {
 public:
-	UserRamSYSTEMB() : UserRamMASK0701(0x5FC, 0x304, 3) {}
+	static const uint32_t userRamSize = 0x304; //!< Size of the user RAM in bytes
+	static const uint32_t userRamShadowSize = 3; //!< Size of the shadow area behind the user RAM in bytes
+	static const uint32_t dataSize = userRamSize + userRamShadowSize; //!< Size of the data, see @ref MemoryData
+
+	UserRamSYSTEMB() : UserRamSYSTEMB(MemoryData<UserRamSYSTEMB, dataSize>::data) {}
+
+	/**
+	 * Create the user RAM with other data than the default one, see @ref memoryData().
+	 */
+	explicit UserRamSYSTEMB(uint8_t* data) : UserRamMASK0701(0x5FC, userRamSize, userRamShadowSize, data) {}
 
 protected:
-	UserRamSYSTEMB(uint32_t start, uint32_t size, uint32_t shadowSize) : UserRamMASK0701(start, size, shadowSize) {}
+	UserRamSYSTEMB(uint32_t start, uint32_t size, uint32_t shadowSize, uint8_t* data) : UserRamMASK0701(start, size, shadowSize, data) {}
 
 private:
 
@@ -48,7 +48,7 @@ extern "C" {
 #      define LPCOPEN_I2C                   ((LPC_I2C_T              *) LPC_I2C_BASE)
 #   endif
 #else
-#   define LPCOPEN_I2C 0 ///> FIXME not sure if this is correct for unit testing
+#   define LPCOPEN_I2C                      ((LPC_I2C_T              *) LPC_I2C) ///> emulated registers for unit testing
 #endif
 
 
@@ -272,6 +272,7 @@ typedef enum {
 	I2C_STATUS_ARBLOST,	/**< Aribitration lost during transfer */
 	I2C_STATUS_BUSERR,	/**< Bus error in I2C transfer */
 	I2C_STATUS_BUSY,	/**< I2C is busy doing transfer */
+	I2C_STATUS_TIMEOUT,	/**< Transfer aborted after its timeout */
 } I2C_STATUS_T;
 
 /**
@@ -288,6 +289,37 @@ typedef struct {
 	I2C_STATUS_T status;	/**< Status of the current I2C transfer */
 } I2C_XFER_T;
 
+/**
+ * @brief Queued master transfer, see Chip_I2C_MasterSubmit()
+ */
+typedef struct I2C_MASTER_REQ I2C_MASTER_REQ_T;
+
+/**
+ * @brief	Completion callback of a queued master transfer
+ * @note	Called from I2C_IRQHandler, or from Chip_I2C_MasterCheckTimeout()
+ *			for a timeout. req->xfer->status holds the result.
+ */
+typedef void (*I2C_MASTER_CALLBACK_T)(I2C_MASTER_REQ_T *req);
+
+struct I2C_MASTER_REQ {
+	I2C_XFER_T *xfer;				/**< Transfer to do, its status is I2C_STATUS_BUSY until it is done */
+	I2C_MASTER_CALLBACK_T callback;	/**< Called when the transfer is done, may be NULL */
+	void *context;					/**< Free for use by the caller */
+	uint8_t retries;				/**< Number of retries after a lost arbitration */
+	uint16_t timeoutMs;				/**< Timeout of the transfer once it started, 0 for none */
+
+	/* Private, set by Chip_I2C_MasterSubmit() */
+	const uint8_t *txBuff;			/**< txBuff of the transfer for a retry */
+	int txSz;						/**< txSz of the transfer for a retry */
+	uint8_t *rxBuff;				/**< rxBuff of the transfer for a retry */
+	int rxSz;						/**< rxSz of the transfer for a retry */
+	uint32_t startTime;				/**< millis() when the transfer started */
+	I2C_MASTER_REQ_T *next;			/**< Next queued request */
+};
+
+#define I2C_MASTER_RETRIES      5	/**< Retries after a lost arbitration of the blocking send and read functions */
+#define I2C_MASTER_TIMEOUT_MS   100	/**< Timeout of the blocking transfer functions */
+
 /**
  * @brief	I2C interface IDs
  * @note
@@ -360,6 +392,49 @@ void Chip_I2C_SetClockRate(I2C_ID_T id, uint32_t clockrate);
  */
 uint32_t Chip_I2C_GetClockRate(I2C_ID_T id);
 
+/**
+ * @brief	Queue a master transfer and return at once
+ * @param	id		: I2C peripheral selected (I2C0, I2C1 etc)
+ * @param	req		: The request, with @a xfer, @a callback, @a context, @a retries
+ *					  and @a timeoutMs set. It must stay valid until it is done.
+ * @return	Nothing
+ * @note
+ * The transfer is done by I2C_IRQHandler, so the I2C must be in interrupt
+ * mode, which is the default after i2c_lpcopen_init(). When it is done
+ * req->xfer->status is not I2C_STATUS_BUSY anymore and the callback is called.
+ * A lost arbitration restarts the transfer up to @a retries times. For the
+ * timeout Chip_I2C_MasterCheckTimeout() must be called regularly.
+ */
+void Chip_I2C_MasterSubmit(I2C_ID_T id, I2C_MASTER_REQ_T *req);
+
+/**
+ * @brief	Set up a transfer and its request and queue it
+ * @param	id			: I2C peripheral selected (I2C0, I2C1 etc)
+ * @param	req			: The request, it is overwritten. It must stay valid until it is done.
+ * @param	xfer		: The transfer, it is overwritten. It must stay valid until it is done.
+ * @param	slaveAddr	: Slave address of the transfer
+ * @param	txBuff		: Bytes to send, may be NULL if @a txSz is 0
+ * @param	txSz		: Number of bytes to send
+ * @param	rxBuff		: Where to store the received bytes, may be NULL if @a rxSz is 0
+ * @param	rxSz		: Number of bytes to receive
+ * @return	Nothing
+ * @note
+ * Like the blocking transfer functions the request is done with
+ * I2C_MASTER_RETRIES retries and a timeout of I2C_MASTER_TIMEOUT_MS, and
+ * without a callback. Poll xfer->status, see Chip_I2C_MasterSubmit().
+ */
+void Chip_I2C_MasterSubmitXfer(I2C_ID_T id, I2C_MASTER_REQ_T *req, I2C_XFER_T *xfer, uint8_t slaveAddr,
+							   const uint8_t *txBuff, int txSz, uint8_t *rxBuff, int rxSz);
+
+/**
+ * @brief	Abort the current master transfer if its timeout passed
+ * @param	id		: I2C peripheral selected (I2C0, I2C1 etc)
+ * @return	Nothing
+ * @note	Call it from the main loop while queued transfers are pending.
+ *			The aborted transfer gets the status I2C_STATUS_TIMEOUT.
+ */
+void Chip_I2C_MasterCheckTimeout(I2C_ID_T id);
+
 /**
  * @brief	Transmit and Receive data in master mode
  * @param	id		: I2C peripheral selected (I2C0, I2C1 etc)
@@ -378,6 +453,8 @@ uint32_t Chip_I2C_GetClockRate(I2C_ID_T id);
  * transfered to slave and the number of bytes to send respectively, similarly
  * @a rxBuff and @a rxSz must have pointer to memroy where data received
  * from slave be stored and the number of data to get from slave respectilvely.
+ * The transfer is queued like with Chip_I2C_MasterSubmit() and waited for,
+ * without retries and with a timeout of I2C_MASTER_TIMEOUT_MS.
  */
 int Chip_I2C_MasterTransfer(I2C_ID_T id, I2C_XFER_T *xfer);
 
@@ -388,6 +465,7 @@ int Chip_I2C_MasterTransfer(I2C_ID_T id, I2C_XFER_T *xfer);
  * @param	buff		: Pointer to buffer having the array of data
  * @param	len			: Number of bytes to be transfered from @a buff
  * @return	Number of bytes successfully transfered
+ * @note	A lost arbitration is retried up to I2C_MASTER_RETRIES times
  */
 int Chip_I2C_MasterSend(I2C_ID_T id, uint8_t slaveAddr, const uint8_t *buff, uint8_t len);
 
@@ -399,6 +477,7 @@ int Chip_I2C_MasterSend(I2C_ID_T id, uint8_t slaveAddr, const uint8_t *buff, uin
  * @param	buff		: Pointer to memory that will hold the data received
  * @param	len			: Number of bytes to receive
  * @return	Number of bytes successfully received
+ * @note	A lost arbitration is retried up to I2C_MASTER_RETRIES times
  */
 int Chip_I2C_MasterCmdRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t cmd, uint8_t *buff, int len);
 
@@ -411,6 +490,7 @@ int Chip_I2C_MasterCmdRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t cmd, uint8_t
  * @param	txlen		: Number of bytes to send
  * @param	rxlen		: Number of bytes to receive
  * @return	Number of bytes successfully received
+ * @note	A lost arbitration is retried up to I2C_MASTER_RETRIES times
  */
 int Chip_I2C_MasterWriteRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t *cmd, uint8_t *buff, int txlen, int rxlen);
 
@@ -436,6 +516,7 @@ int Chip_I2C_SetMasterEventHandler(I2C_ID_T id, I2C_EVENTHANDLER_T event);
  * @param	buff		: Pointer to memory where data read be stored
  * @param	len			: Number of bytes to read from slave
  * @return	Number of bytes read successfully
+ * @note	A lost arbitration is retried up to I2C_MASTER_RETRIES times
  */
 int Chip_I2C_MasterRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t *buff, int len);
 
@@ -28,6 +28,9 @@
 #ifndef CCS811_h
 #define CCS811_h
 
+#include <sblib/i2c.h>
+#include <sblib/timeout.h>
+
 #define nWAKE           4      // pin 4 is tied to CCS811 nWAKE pin in sensor node
 #define nINT            7      // pin 7 is tied to CCS811 nINT pin in sensor node
 
@@ -58,6 +61,9 @@ public:
   int readCO2(void);
   void setMode(uint8_t modeNumber);
   bool getData(void);
+  bool startMeasurement(void);
+  bool poll(void);
+  bool result(void);
   void compensate(float t, float rh);
   void _digitalWrite(int WAKE_PIN, bool VAL);
   void reset(void);
@@ -65,8 +71,21 @@ public:
   int TVOC, CO2;
 
 private:
+  enum MeasureState {
+    MEASURE_IDLE,
+    MEASURE_WAKE, // waiting for the sensor to wake up
+    MEASURE_READ  // result is read
+  };
+
   int _WAKE_PIN;
   uint8_t _I2C_ADDR;
+  MeasureState _measureState;
+  bool _measureValid;
+  Timeout _measureTimeout;
+  I2C_XFER_T _measureXfer;
+  I2C_MASTER_REQ_T _measureReq;
+  uint8_t _measureBuffer[4];
+  void storeData(const uint8_t *buffer);
 };
 
 #endif
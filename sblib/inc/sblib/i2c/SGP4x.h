@@ -15,7 +15,14 @@
 #define SGP4X_H
 
 #include <stdint.h>
-#include <sblib/i2c/sensirion_gas_index_algorithm.h>
+#include <sblib/libconfig.h>
+#include <sblib/i2c.h>
+#include <sblib/timeout.h>
+#ifdef GAS_INDEX_FIXED_POINT
+#   include <sblib/i2c/sensirion_gas_index_algorithm_fix16.h>
+#else
+#   include <sblib/i2c/sensirion_gas_index_algorithm.h>
+#endif
 
 enum class SGP4xResult : int8_t {
   invalidByteCount = -6,
@@ -62,8 +69,57 @@ private:
   int32_t noxIndexValue;
   uint16_t featureSet;
 
+#ifdef GAS_INDEX_FIXED_POINT
+  GasIndexAlgorithmFix16Params voc_algorithm_params;
+  GasIndexAlgorithmFix16Params nox_algorithm_params;
+#else
   GasIndexAlgorithmParams voc_algorithm_params;
   GasIndexAlgorithmParams nox_algorithm_params;
+#endif
+
+  enum class MeasureState : uint8_t {
+      idle,
+      command,    //!< measure command is sent
+      conversion, //!< waiting for the measurement
+      read        //!< result is read
+  };
+
+  MeasureState measureState;
+  SGP4xResult measureResult;
+  Timeout measureTimeout;
+  I2C_XFER_T measureXfer;
+  I2C_MASTER_REQ_T measureReq;
+  uint8_t measureCommand[8];
+  uint8_t measureBuffer[6];
+
+  bool finishMeasurement(SGP4xResult result);
+
+  /**
+   * Fill the @ref Sgp4xCommand::measureRaw command and its parameters into a buffer
+   *
+   * @param cmdBuffer           Buffer of 8 bytes for the command
+   * @param relativeHumidity    Relative humidity in percent
+   * @param temperature         Temperature in degree celsius
+   * @param useCompensation     Set true to use SGP4x internal temperature/humidity compensation
+   */
+  void setupMeasureCommand(uint8_t * cmdBuffer, float relativeHumidity, float temperature, bool useCompensation);
+
+  /**
+   * Check the crc8 checksum after every word of a response
+   *
+   * @param readBuffer          Response of the sensor
+   * @param readBufferSize      Size in bytes of the response
+   *
+   * @return @ref SGP4xResult::success if all checksums match, otherwise a @ref SGP4xResult
+   */
+  SGP4xResult checkResponse(const uint8_t * readBuffer, uint8_t readBufferSize);
+
+  /**
+   * Store the raw signals of a measurement response and process them with the gas index algorithm
+   *
+   * @param readBuffer          Response of the @ref Sgp4xCommand::measureRaw command
+   */
+  void processRawSignals(const uint8_t * readBuffer);
 
   /**
    * Send a command to the sensor, wait for it to be processed and retrieve the sensor's response
@@ -130,6 +186,39 @@ public:
    */
   SGP4xResult measureRawSignal();
 
+  /**
+   * Start the @ref Sgp4xCommand::measureRaw command without waiting for it.
+   * Call @ref poll() from the main loop until it returns true.
+   *
+   * @param relativeHumidity    Relative humidity in percent
+   * @param temperature         Temperature in degree celsius
+   * @param useCompensation     Set true to use SGP4x internal temperature/humidity compensation
+   *
+   * @return true if the measurement was started, false if one is still running
+   */
+  bool startMeasurement(float relativeHumidity, float temperature, bool useCompensation);
+
+  /**
+   * Start the @ref Sgp4xCommand::measureRaw command without temperature or relative humidity compensation
+   *
+   * @return true if the measurement was started, false if one is still running
+   */
+  bool startMeasurement();
+
+  /**
+   * Process the measurement started with @ref startMeasurement(). Never waits.
+   *
+   * @return true once when the measurement is finished, successful or not
+   */
+  bool poll();
+
+  /**
+   * Result of the last finished measurement started with @ref startMeasurement().
+   *
+   * @return @ref SGP4xResult::success if the index and raw values were updated, otherwise a @ref SGP4xResult
+   */
+  SGP4xResult result();
+
   /**
    * Shall be executed after each re-start of the SGP4x
    * sensor returns a VOC value - but this is discarded here.
@@ -37,6 +37,8 @@
 #define SHT4X_H
 
 #include <stdint.h>
+#include <sblib/i2c.h>
+#include <sblib/timeout.h>
 
 enum class Sht4xCommand : uint8_t {
 	measHi 				= 0xFD,
@@ -59,6 +61,24 @@ private:
 	float temperature;
 	float humidity;
 
+	enum class MeasureState : uint8_t {
+		idle,
+		command,    //!< measurement command is sent
+		conversion, //!< waiting for the conversion
+		read        //!< result is read
+	};
+
+	MeasureState measureState = MeasureState::idle;
+	bool measureValid = false;
+	unsigned int measureStart = 0;
+	Timeout measureTimeout;
+	I2C_XFER_T measureXfer = {};
+	I2C_MASTER_REQ_T measureReq = {};
+	uint8_t measureCommand = 0;
+	uint8_t measureBuffer[6] = {};
+
+	bool finishMeasurement(bool valid);
+
     bool readSensor(Sht4xCommand command, uint8_t* buffer, uint8_t bufferLength);
     bool writeCommand(Sht4xCommand command);
 
@@ -111,10 +131,30 @@ public:
 
   /**
    * SHT4x command for a single shot measurement with high repeatability.
+   * Waits until the measurement is finished.
    * @return true on success, and false otherwise
    */
   bool measureHighPrecision();
 
+  /**
+   * Start a single shot measurement with high repeatability without waiting for it.
+   * Call @ref poll() from the main loop until it returns true.
+   * @return true if the measurement was started, false if one is still running
+   */
+  bool startMeasurement();
+
+  /**
+   * Process the measurement started with @ref startMeasurement(). Never waits.
+   * @return true once when the measurement is finished, successful or not
+   */
+  bool poll();
+
+  /**
+   * Result of the last finished measurement.
+   * @return true if @ref getTemperature() and @ref getHumidity() return its values, false if it failed
+   */
+  bool result();
+
   /**
    * Gets the current dew point based on the current humidity and temperature
    * @return the dew point in Deg C
@@ -15,6 +15,7 @@
 */
 #include <sblib/core.h>
 #include <sblib/i2c.h>
+#include <sblib/timeout.h>
 
 #ifndef BH1750_h
 #define BH1750_h
@@ -70,8 +71,23 @@ public:
   bool setMTreg(byte MTreg);
   bool measurementReady(bool maxWait = false);
   float readLightLevel();
+  bool startMeasurement();
+  bool poll();
+  float result();
 
 private:
+  enum MeasureState {
+    MEASURE_IDLE,
+    MEASURE_COMMAND,    // one time mode command is sent
+    MEASURE_CONVERSION, // waiting for the measurement
+    MEASURE_READ        // result is read
+  };
+
+  unsigned long measurementTime(bool maxWait);
+  float convertLevel(uint16_t raw);
+  void startConversionTimeout();
+  bool finishMeasurement(float level);
+
   byte BH1750_I2CADDR;
   byte BH1750_MTreg = (byte)BH1750_DEFAULT_MTREG;
   // Correction factor used to calculate lux. Typical value is 1.2 but can
@@ -80,6 +96,12 @@ private:
   const float BH1750_CONV_FACTOR = 1.2f;
   Mode BH1750_MODE = UNCONFIGURED;
   unsigned long lastReadTimestamp;
+  MeasureState measureState = MEASURE_IDLE;
+  float measureLevel = -1.0f;
+  Timeout measureTimeout;
+  I2C_XFER_T measureXfer = {};
+  I2C_MASTER_REQ_T measureReq = {};
+  uint8_t measureBuffer[2] = {};
 };
 
 #endif
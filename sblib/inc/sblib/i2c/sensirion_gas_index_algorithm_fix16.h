@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2022, Sensirion AG
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * * Neither the name of Sensirion AG nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Q16.16 fixed-point port of the gas index algorithm for the Selfbus Library.
+ * The algorithm and its parameters are the same as in
+ * sensirion_gas_index_algorithm.h, all states are fix16_t values instead of
+ * float, so GasIndexAlgorithmFix16_process() needs no soft-float code.
+ */
+
+#ifndef GASINDEXALGORITHMFIX16_H_
+#define GASINDEXALGORITHMFIX16_H_
+
+#include <stdint.h>
+#include <sblib/i2c/sensirion_gas_index_algorithm.h>
+
+/**
+ * Signed Q16.16 fixed-point value
+ */
+typedef int32_t fix16_t;
+
+/**
+ * Convert a constant to fix16_t at compile time
+ */
+#define F16(x) \
+    ((fix16_t)(((x) >= 0) ? ((x)*65536.0 + 0.5) : ((x)*65536.0 - 0.5)))
+
+#define GasIndexAlgorithmFix16_DEFAULT_SAMPLING_INTERVAL \
+    F16(GasIndexAlgorithm_DEFAULT_SAMPLING_INTERVAL)
+
+/**
+ * Struct to hold all parameters and states of the fixed-point gas algorithm.
+ */
+typedef struct {
+    int mAlgorithm_Type;
+    fix16_t mSamplingInterval;
+    fix16_t mIndex_Offset;
+    int32_t mSraw_Minimum;
+    fix16_t mGating_Max_Duration_Minutes;
+    fix16_t mInit_Duration_Mean;
+    fix16_t mInit_Duration_Variance;
+    fix16_t mGating_Threshold;
+    fix16_t mIndex_Gain;
+    fix16_t mTau_Mean_Hours;
+    fix16_t mTau_Variance_Hours;
+    fix16_t mSraw_Std_Initial;
+    fix16_t mUptime;
+    fix16_t mSraw;
+    fix16_t mGas_Index;
+    bool m_Mean_Variance_Estimator___Initialized;
+    fix16_t m_Mean_Variance_Estimator___Mean;
+    fix16_t m_Mean_Variance_Estimator___Sraw_Offset;
+    fix16_t m_Mean_Variance_Estimator___Std;
+    fix16_t m_Mean_Variance_Estimator___Gamma_Mean;
+    fix16_t m_Mean_Variance_Estimator___Gamma_Variance;
+    fix16_t m_Mean_Variance_Estimator___Gamma_Initial_Mean;
+    fix16_t m_Mean_Variance_Estimator___Gamma_Initial_Variance;
+    fix16_t m_Mean_Variance_Estimator__Gamma_Mean;
+    fix16_t m_Mean_Variance_Estimator__Gamma_Variance;
+    fix16_t m_Mean_Variance_Estimator___Uptime_Gamma;
+    fix16_t m_Mean_Variance_Estimator___Uptime_Gating;
+    fix16_t m_Mean_Variance_Estimator___Gating_Duration_Minutes;
+    fix16_t m_Mean_Variance_Estimator___Sigmoid__K;
+    fix16_t m_Mean_Variance_Estimator___Sigmoid__X0;
+    fix16_t m_Mox_Model__Sraw_Std;
+    fix16_t m_Mox_Model__Sraw_Mean;
+    fix16_t m_Sigmoid_Scaled__K;
+    fix16_t m_Sigmoid_Scaled__X0;
+    fix16_t m_Sigmoid_Scaled__Offset_Default;
+    fix16_t m_Adaptive_Lowpass__A1;
+    fix16_t m_Adaptive_Lowpass__A2;
+    bool m_Adaptive_Lowpass___Initialized;
+    fix16_t m_Adaptive_Lowpass___X1;
+    fix16_t m_Adaptive_Lowpass___X2;
+    fix16_t m_Adaptive_Lowpass___X3;
+} GasIndexAlgorithmFix16Params;
+
+/**
+ * Initialize the gas index algorithm parameters for the specified algorithm
+ * type and reset its internal states. Call this once at the beginning.
+ * @param params            Pointer to the GasIndexAlgorithmFix16Params struct
+ * @param algorithm_type    0 (GasIndexAlgorithm_ALGORITHM_TYPE_VOC) for VOC or
+ *                          1 (GasIndexAlgorithm_ALGORITHM_TYPE_NOX) for NOx
+ */
+void GasIndexAlgorithmFix16_init(GasIndexAlgorithmFix16Params* params,
+                                 int32_t algorithm_type);
+
+/**
+ * Initialize the gas index algorithm parameters for the specified algorithm
+ * type and reset its internal states. Call this once at the beginning.
+ * @param params            Pointer to the GasIndexAlgorithmFix16Params struct
+ * @param algorithm_type    0 (GasIndexAlgorithm_ALGORITHM_TYPE_VOC) for VOC or
+ *                          1 (GasIndexAlgorithm_ALGORITHM_TYPE_NOX) for NOx
+ * @param sampling_interval The sampling interval in seconds the algorithm is
+ *                          called. Tested for 1s and 10s.
+ */
+void GasIndexAlgorithmFix16_init_with_sampling_interval(
+    GasIndexAlgorithmFix16Params* params, int32_t algorithm_type,
+    fix16_t sampling_interval);
+
+/**
+ * Reset the internal states of the gas index algorithm. Previously set tuning
+ * parameters are preserved. Call this when resuming operation after a
+ * measurement interruption.
+ * @param params    Pointer to the GasIndexAlgorithmFix16Params struct
+ */
+void GasIndexAlgorithmFix16_reset(GasIndexAlgorithmFix16Params* params);
+
+/**
+ * Get current algorithm states, see GasIndexAlgorithm_get_states().
+ * @param params    Pointer to the GasIndexAlgorithmFix16Params struct
+ * @param state0    State0 to be stored
+ * @param state1    State1 to be stored
+ */
+void GasIndexAlgorithmFix16_get_states(
+    const GasIndexAlgorithmFix16Params* params, fix16_t* state0,
+    fix16_t* state1);
+
+/**
+ * Set previously retrieved algorithm states, see
+ * GasIndexAlgorithm_set_states().
+ * @param params    Pointer to the GasIndexAlgorithmFix16Params struct
+ * @param state0    State0 to be restored
+ * @param state1    State1 to be restored
+ */
+void GasIndexAlgorithmFix16_set_states(GasIndexAlgorithmFix16Params* params,
+                                       fix16_t state0, fix16_t state1);
+
+/**
+ * Set parameters to customize the gas index algorithm, see
+ * GasIndexAlgorithm_set_tuning_parameters() for the description and ranges
+ * of the parameters.
+ */
+void GasIndexAlgorithmFix16_set_tuning_parameters(
+    GasIndexAlgorithmFix16Params* params, int32_t index_offset,
+    int32_t learning_time_offset_hours, int32_t learning_time_gain_hours,
+    int32_t gating_max_duration_minutes, int32_t std_initial,
+    int32_t gain_factor);
+
+/**
+ * Get current parameters to customize the gas index algorithm.
+ * Refer to GasIndexAlgorithm_set_tuning_parameters() for description of the
+ * parameters.
+ */
+void GasIndexAlgorithmFix16_get_tuning_parameters(
+    const GasIndexAlgorithmFix16Params* params, int32_t* index_offset,
+    int32_t* learning_time_offset_hours, int32_t* learning_time_gain_hours,
+    int32_t* gating_max_duration_minutes, int32_t* std_initial,
+    int32_t* gain_factor);
+
+/**
+ * Get the sampling interval parameter used by the algorithm.
+ */
+void GasIndexAlgorithmFix16_get_sampling_interval(
+    const GasIndexAlgorithmFix16Params* params, fix16_t* sampling_interval);
+
+/**
+ * Calculate the gas index value from the raw sensor value.
+ *
+ * @param params      Pointer to the GasIndexAlgorithmFix16Params struct
+ * @param sraw        Raw value from the SGP4x sensor
+ * @param gas_index   Calculated gas index value from the raw sensor value. Zero
+ *                    during initial blackout period and 1..500 afterwards
+ */
+void GasIndexAlgorithmFix16_process(GasIndexAlgorithmFix16Params* params,
+                                    int32_t sraw, int32_t* gas_index);
+
+#endif /* GASINDEXALGORITHMFIX16_H_ */
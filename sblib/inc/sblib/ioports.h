@@ -251,7 +251,20 @@ extern const int portMask[12];
  * @param func - the port function to find, e.g. PF_PIO
  * @return the function number, or -1 if not found
  */
-short getPinFunctionNumber(int pin, short func);
+constexpr short getPinFunctionNumber(int pin, short func)
+{
+    pin >>= PF0_SHIFT;
+
+    for (short funcNumber = 0; funcNumber < 4; ++funcNumber)
+    {
+        if ((pin & PFF_MASK) == func)
+            return funcNumber;
+
+        pin >>= PFF_SHIFT_OFFSET;
+    }
+
+    return -1;
+}
 
 
 #endif /*sblib_ioports_h*/
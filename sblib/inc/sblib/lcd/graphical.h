@@ -14,9 +14,21 @@
 
 class Font;
 
+/**
+ * The maximum number of pages (rows of 8 pixels) of a display that uses a frame buffer.
+ */
+#define LCD_GRAPHICAL_MAX_PAGES 8
+
 
 /**
  * Base class for graphical LCD displays.
+ *
+ * The display memory of the supported controllers is organized in pages. A page is
+ * a row of 8 pixels height, every byte of a page is a column of 8 pixels.
+ *
+ * Without a frame buffer every output is sent to the display at once. With a frame
+ * buffer, see frameBuffer(), the output goes to the frame buffer only, and flush()
+ * sends the columns that were changed since the last flush() to the display.
  */
 class LcdGraphical: public Print
 {
@@ -42,18 +54,83 @@ public:
      */
     void font(const Font& font);
 
+    /**
+     * Use a frame buffer. The frame buffer must have space for width * pages bytes,
+     * see the constants of the display class. The contents of the frame buffer
+     * is cleared and flush() sends the whole frame buffer to the display.
+     *
+     * @param buffer - the frame buffer, 0 to write directly to the display.
+     */
+    void frameBuffer(byte* buffer);
+
+    /**
+     * Send the changed parts of the frame buffer to the display. Nothing is
+     * done if the display does not use a frame buffer.
+     */
+    void flush();
+
+    /**
+     * Set or clear a pixel in the frame buffer. Nothing is done if the display
+     * does not use a frame buffer.
+     *
+     * @param x - the X position in pixels, starting with 0
+     * @param y - the Y position in pixels, starting with 0
+     * @param on - true to set the pixel, false to clear it.
+     */
+    void pixel(int x, int y, bool on);
+
 protected:
     /**
      * Create a graphical LCD display.
      *
      * @param font - the font to use for text output, e.g. font_5x7
      * @param width - the width of the display in pixels
-     * @param height - the height of the display in pixels
+     * @param height - the height of the display in pages (8 pixels per page)
      */
     LcdGraphical(const Font& font, int width, int height);
 
+    /**
+     * Send columns of the frame buffer to the display.
+     *
+     * @param x - the X position of the first column
+     * @param page - the page of the columns
+     * @param data - the columns to send
+     * @param count - the number of columns to send
+     */
+    virtual void writeColumns(int x, int page, const byte* data, int count) = 0;
+
+    /**
+     * Draw a character into the frame buffer at the cursor position and advance
+     * the cursor.
+     *
+     * @param ch - the character to draw.
+     *
+     * @return 1 if the character was drawn, 0 if not.
+     */
+    int drawChar(byte ch);
+
+    /**
+     * Clear the frame buffer.
+     */
+    void clearFrameBuffer();
+
+    /**
+     * Mark columns of the frame buffer as changed.
+     *
+     * @param x - the X position of the first column
+     * @param page - the page of the columns
+     * @param count - the number of columns
+     */
+    void markDirty(int x, int page, int count);
+
     const Font* fnt;
     const int width, height;
+
+    byte* frame;         //!< The frame buffer, 0 if not used
+    int cursorX;         //!< The X position of the cursor, in pixels
+    int cursorY;         //!< The Y position of the cursor, in pages
+    byte dirtyStart[LCD_GRAPHICAL_MAX_PAGES]; //!< The first changed column of the pages
+    byte dirtyEnd[LCD_GRAPHICAL_MAX_PAGES];   //!< The column after the last changed column of the pages
 };
 
 
@@ -14,6 +14,11 @@
 #include <sblib/ioports.h>
 #include <sblib/spi.h>
 
+/**
+ * The size of a frame buffer for a EA-DOGS display, in bytes.
+ */
+#define LCD_EADOGS_FRAMEBUFFER_SIZE (102 * 8)
+
 
 /**
  * Class for EA-DOGS graphical LCD displays. These displays have a UC1701 display
@@ -22,6 +27,16 @@
  * The fonts are stored in separate files. The default font can be used with
  * #include <sblib/lcd/font_5x7.h> and is named font_5x7.
  *
+ * With a frame buffer, flush() sends the changed columns of a page in the background,
+ * using the SPI interrupt. The next access to the display waits for this transfer to end.
+ *
+ *     static byte frame[LCD_EADOGS_FRAMEBUFFER_SIZE];
+ *     ...
+ *     display.begin();
+ *     display.frameBuffer(frame);
+ *     display.print("Hello World");
+ *     display.flush();
+ *
  * WARNING
  *
  * This code is only half done !
@@ -84,9 +99,27 @@ public:
      */
     virtual void clear();
 
+protected:
+    virtual void writeColumns(int x, int page, const byte* data, int count);
+
+    /**
+     * Wait until the background transfer of flush() is done.
+     */
+    void waitTransfer();
+
+    /**
+     * Send the column and page address of a position to the display.
+     *
+     * @param x - the X position, starting with 0
+     * @param y - the Y position, starting with 0
+     */
+    void address(int x, int y);
+
 protected:
     SPI spi;
     const int pinCD, pinCS;
+    bool transferring;
+    uint16_t transferBuffer[LCD_EADOGS_FRAMEBUFFER_SIZE / 8];
 };
 
 
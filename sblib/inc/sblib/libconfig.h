@@ -54,6 +54,20 @@
 
 //#define ROUTER /// \todo create a new class derived from BcuDefault to build a ROUTER
 
+/**
+ * @def GAS_INDEX_FIXED_POINT @ref SGP4xClass uses the Q16.16 fixed-point port of the Sensirion gas index algorithm
+ *      instead of the float reference, see sensirion_gas_index_algorithm_fix16.h
+ */
+//#define GAS_INDEX_FIXED_POINT
+
+/**
+ * @def SLEEP_WHEN_IDLE main() sleeps between the calls of the loops until an interrupt or the next
+ *      deadline of the BCU, see @ref BcuBase::idleTime() and @ref sleepUntilInterrupt().
+ *      The application's loop() is then only called on interrupts, the timers of the @ref timerWheel
+ *      and the samples of the programming button, so its own timeouts must use the @ref timerWheel.
+ */
+//#define SLEEP_WHEN_IDLE
+
 
 
 
@@ -94,6 +108,12 @@
 /** @def DUMP_TL4 dump transport layer 4 protocol handling over serial interface */
 //#define DUMP_TL4
 
+/**
+ *  @def PROFILING collect run-time statistics of the main loop and interrupt handlers,
+ *       see @ref profiler.h
+ */
+//#define PROFILING
+
 /// \todo following #defines should be moved to this libconfig.h file
 // IAP_EMULATION        /// \todo from platform.h & analog_pin.cpp (used for catch-unit tests of the sblib)
 // DEBUG                /// \todo from utils.h
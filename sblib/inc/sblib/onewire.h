@@ -26,6 +26,36 @@
 #define ONEWIRE_CRC16           1      // Allow 16-bit CRC checks by defining this to 1 (Note that ONEWIRE_CRC must also be 1.)
 #define ONEWIRE_INTERNAL_PULLUP 1      // Use internal pull-up resistor instead of regular 4.7KOhms (Info -> http://wp.josh.com/2014/06/23/no-external-pull-up-needed-for-ds18b20-temp-sensor/)
 
+#ifndef ONEWIRE_QUEUE_SIZE
+#define ONEWIRE_QUEUE_SIZE      16     // Number of operations the timer driven engine can queue
+#endif
+
+class Timer;
+
+/*
+ * Completion callback of a queued transaction. Called from the timer interrupt,
+ * so keep it short. bSuccess is false if a reset of the transaction got no
+ * presence pulse, the remaining operations of the transaction were skipped then.
+ */
+typedef void (*OneWireCallback)(void* context, bool bSuccess);
+
+/*
+ * Operation of the timer driven engine
+ */
+struct OneWireOp
+{
+  uint8_t type;                        // OneWire::OpType
+  uint8_t count;                       // Number of bytes to write or read
+  uint8_t value;                       // Byte to write for a single byte write
+  union
+  {
+    const uint8_t *txData;             // Bytes to write
+    uint8_t *rxData;                   // Buffer for the read bytes
+    OneWireCallback callback;          // Callback to call
+  };
+  void *context;                       // Context for the callback
+};
+
 /*
  * OneWire Class
  */
@@ -39,6 +69,32 @@ class OneWire
     uint8_t _LastFamilyDiscrepancy;
     bool _bLastDeviceFlag;
 #endif
+    // Timer driven engine
+    Timer *_timer = nullptr;
+    OneWireOp _queue[ONEWIRE_QUEUE_SIZE];
+    volatile uint8_t _queueHead = 0;   // Next free queue entry, written by the main loop
+    volatile uint8_t _queueTail = 0;   // Operation in progress, written by the interrupt
+    volatile bool _bActive = false;    // The timer is running
+    bool _bFailed = false;             // Skip the operations up to the next callback
+    uint8_t _phase = 0;                // Phase of the current reset or bit slot
+    uint8_t _bitMask = 1;              // Current bit of the current byte
+    uint8_t _byteIdx = 0;              // Current byte of the current operation
+
+    enum OpType
+    {
+      OP_RESET,
+      OP_WRITE,
+      OP_READ,
+      OP_DEPOWER,
+      OP_CALLBACK
+    };
+
+    OneWireOp* OneWireQueueEntry(uint8_t type, uint8_t count);
+    bool OneWireQueueCommit();
+    unsigned int OneWireStep();
+    void OneWireNextOp();
+    void OneWireSchedule(unsigned int usec);
+    void OneWireRelease();
 
   public:
     bool m_bParasitePowerMode;        // Parasite power mode state
@@ -164,6 +220,77 @@ class OneWire
      */
     inline bool IsParasiteMode(){ return this->m_bParasitePowerMode; }
 
+   /*
+    * Function name:  OneWireTimerInit
+    * Descriptions:   Use the timer for the queued operations. The timer is
+    *                 used exclusively and ticks with 1us. Its interrupt handler
+    *                 must be created with ONEWIRE_TIMER_INTERRUPT_HANDLER.
+    *                 The blocking functions stay available, but must not be
+    *                 used while queued operations are pending.
+    * parameters:     timer, e.g. timer32_0
+    * Returned value: none
+    */
+    void OneWireTimerInit(Timer& timer);
+
+   /*
+    * Function name:  OneWireTimerInterruptHandler
+    * Descriptions:   Process the next step of the queued operations. Each reset
+    *                 and bit slot is split into steps, between them the timer
+    *                 waits. Only the short parts of a slot (up to 13us) are
+    *                 busy waited in the interrupt. It runs at a lower priority
+    *                 than the bus timer.
+    * parameters:     none
+    * Returned value: none
+    */
+    void OneWireTimerInterruptHandler();
+
+   /*
+    * Function name:  OneWireQueueReset, OneWireQueueWrite, OneWireQueueWriteBytes,
+    *                 OneWireQueueRead, OneWireQueueReadBytes, OneWireQueueSelect,
+    *                 OneWireQueueSkip, OneWireQueueDePower
+    * Descriptions:   Queue the operation, see the blocking functions of the same
+    *                 name. A transaction starts with a reset and ends with
+    *                 OneWireQueueCallback(). Buffers passed must stay valid
+    *                 until the callback was called. Check OneWireQueueSpace()
+    *                 before queueing a transaction, so it is queued completely.
+    * parameters:     see the blocking functions
+    * Returned value: true if queued, false if the queue is full
+    */
+    bool OneWireQueueReset();
+    bool OneWireQueueWrite(uint8_t v);
+    bool OneWireQueueWriteBytes(const uint8_t *buf, uint8_t count);
+    bool OneWireQueueRead(uint8_t *dest);
+    bool OneWireQueueReadBytes(uint8_t *buf, uint8_t count);
+    bool OneWireQueueSelect(const uint8_t rom[8]);
+    bool OneWireQueueSkip();
+    bool OneWireQueueDePower();
+
+   /*
+    * Function name:  OneWireQueueCallback
+    * Descriptions:   Queue the end of a transaction. The callback is called
+    *                 from the timer interrupt when all operations queued before
+    *                 are done or were skipped.
+    * parameters:     callback (may be nullptr), context for the callback
+    * Returned value: true if queued, false if the queue is full
+    */
+    bool OneWireQueueCallback(OneWireCallback callback, void *context);
+
+   /*
+    * Function name:  OneWireQueueSpace
+    * Descriptions:   Number of operations that can be queued.
+    * parameters:     none
+    * Returned value: free queue entries
+    */
+    uint8_t OneWireQueueSpace() const;
+
+   /*
+    * Function name:  OneWireBusy
+    * Descriptions:   Queued operations are pending.
+    * parameters:     none
+    * Returned value: true if busy
+    */
+    inline bool OneWireBusy() const { return this->_bActive; }
+
 #if ONEWIRE_SEARCH
    /*
     * Function name:  OneWireResetSearch
@@ -252,4 +379,13 @@ class OneWire
 #endif
 };
 
+/*
+ * Create the interrupt handler for the timer of the queued operations. Example:
+ *
+ * OneWire ow;
+ * ONEWIRE_TIMER_INTERRUPT_HANDLER(TIMER32_0_IRQHandler, ow);
+ */
+#define ONEWIRE_TIMER_INTERRUPT_HANDLER(handler, owObj) \
+    extern "C" void handler() { owObj.OneWireTimerInterruptHandler(); }
+
 #endif /* onewire_h */
@@ -0,0 +1,136 @@
+/*
+ *  pin.h - Compile-time port pin descriptors
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_pin_h
+#define sblib_pin_h
+
+#include <sblib/digital_pin.h>
+#include <sblib/ioports.h>
+#include <sblib/platform.h>
+#include <sblib/types.h>
+
+/**
+ * A port pin that is known at compile time. The GPIO port, the bit mask, the
+ * IO configuration register and the pin function of a mode are resolved by
+ * the compiler, so writing the pin is a single store and configuring it is
+ * a few constant stores. Pins and pin modes that do not exist on the
+ * processor are rejected at compile time.
+ *
+ * Example:
+ *
+ *     typedef Pin<PIO2_6> InfoLed;
+ *     ...
+ *     InfoLed::mode<OUTPUT>();
+ *     InfoLed::write(true);
+ *
+ *     Pin<PIO1_6>::mode<SERIAL_RXD>();  // selects the RXD location too
+ *     Pin<PIO0_3>::mode<SERIAL_RXD>();  // does not compile, PIO0_3 has no RXD function
+ *
+ * Use the functions of digital_pin.h for pins that are only known at runtime.
+ *
+ * @param pinCode - the pin: PIO0_0, PIO0_1, ... (see sblib/ioports.h)
+ */
+template <int pinCode>
+class Pin
+{
+public:
+    static constexpr int code = pinCode;                              //!< The pin, e.g. PIO1_8
+    static constexpr int port = digitalPinToPort(pinCode);            //!< The port number, e.g. 1
+    static constexpr int pinNum = digitalPinToPinNum(pinCode);        //!< The pin number, e.g. 8
+    static constexpr unsigned int mask = digitalPinToBitMask(pinCode); //!< The bit mask, e.g. 0x100
+
+    static_assert(pinNum < 12 && (port < 3 || pinNum < 6) && getPinFunctionNumber(pinCode, PF_PIO) >= 0,
+                  "Pin: not a port pin of the processor");
+
+    /** The offset of the IO configuration register in LPC_IOCON_TypeDef, in words */
+    static constexpr unsigned int ioconOffset = ioconOffsets[port][pinNum];
+
+    /**
+     * @return The GPIO port of the pin.
+     */
+    ALWAYS_INLINE static LPC_GPIO_TypeDef* gpio()
+    {
+        return port == 0 ? LPC_GPIO0 : port == 1 ? LPC_GPIO1 : port == 2 ? LPC_GPIO2 : LPC_GPIO3;
+    }
+
+    /**
+     * @return A pointer to the IO configuration register of the pin.
+     */
+    ALWAYS_INLINE static unsigned int* iocon()
+    {
+        return (unsigned int*) LPC_IOCON_BASE + ioconOffset;
+    }
+
+    /**
+     * Configure the mode of the pin, like pinMode().
+     *
+     * @param ioMode - the I/O mode to set. Use a combination of the PinMode values.
+     */
+    template <int ioMode>
+    ALWAYS_INLINE static void mode()
+    {
+        constexpr int ioconValue = pinModeIocon(pinCode, ioMode);
+        static_assert(ioconValue >= 0, "Pin: the pin does not have the function of the mode");
+
+        if ((ioMode & 0xf000) == OUTPUT || (ioMode & 0xf000) == OUTPUT_MATCH)
+            gpio()->DIR |= mask;
+        else gpio()->DIR &= ~mask;
+
+        pinSelectLocation(pinCode, pinModeFunction(ioMode));
+        *iocon() = ioconValue;
+    }
+
+    /**
+     * Set the direction of the pin, like pinDirection().
+     *
+     * @param dir - the direction: INPUT or OUTPUT
+     */
+    ALWAYS_INLINE static void direction(int dir)
+    {
+        if (dir == OUTPUT)
+            gpio()->DIR |= mask;
+        else gpio()->DIR &= ~mask;
+    }
+
+    /**
+     * Set the value of the output pin, like digitalWrite().
+     *
+     * @param value - the value to set: true or false.
+     */
+    ALWAYS_INLINE static void write(bool value)
+    {
+        gpio()->MASKED_ACCESS[mask] = value ? mask : 0;
+    }
+
+    /**
+     * Set the output pin to high.
+     */
+    ALWAYS_INLINE static void set()
+    {
+        gpio()->MASKED_ACCESS[mask] = mask;
+    }
+
+    /**
+     * Set the output pin to low.
+     */
+    ALWAYS_INLINE static void clear()
+    {
+        gpio()->MASKED_ACCESS[mask] = 0;
+    }
+
+    /**
+     * Read the value of the pin, like digitalRead().
+     *
+     * @return The value of the pin: true (1) or false (0).
+     */
+    ALWAYS_INLINE static bool read()
+    {
+        return gpio()->MASKED_ACCESS[mask] != 0;
+    }
+};
+
+#endif /*sblib_pin_h*/
@@ -35,6 +35,73 @@ extern LPC_GPIO_TypeDef* const gpioPorts[4];
 #endif
 #include <core_cm0.h>
 
+#include <stddef.h>
+
+// Get the offset of the pin in the structure LPC_IOCON_TypeDef
+#define OFFSET_OF_IOCON(pin)  (offsetof(LPC_IOCON_TypeDef, pin) >> 2)
+
+/**
+ * Offsets of the IO configuration registers of the port pins in the structure
+ * LPC_IOCON_TypeDef, in words. Constant expression, so the IO configuration
+ * register of a pin that is known at compile time is resolved at compile time.
+ */
+constexpr unsigned short ioconOffsets[4][12] =
+{
+    {
+        OFFSET_OF_IOCON(RESET_PIO0_0),
+        OFFSET_OF_IOCON(PIO0_1),
+        OFFSET_OF_IOCON(PIO0_2),
+        OFFSET_OF_IOCON(PIO0_3),
+        OFFSET_OF_IOCON(PIO0_4),
+        OFFSET_OF_IOCON(PIO0_5),
+        OFFSET_OF_IOCON(PIO0_6),
+        OFFSET_OF_IOCON(PIO0_7),
+        OFFSET_OF_IOCON(PIO0_8),
+        OFFSET_OF_IOCON(PIO0_9),
+        OFFSET_OF_IOCON(SWCLK_PIO0_10),
+        OFFSET_OF_IOCON(R_PIO0_11)
+    },
+    {
+        OFFSET_OF_IOCON(R_PIO1_0),
+        OFFSET_OF_IOCON(R_PIO1_1),
+        OFFSET_OF_IOCON(R_PIO1_2),
+        OFFSET_OF_IOCON(SWDIO_PIO1_3),
+        OFFSET_OF_IOCON(PIO1_4),
+        OFFSET_OF_IOCON(PIO1_5),
+        OFFSET_OF_IOCON(PIO1_6),
+        OFFSET_OF_IOCON(PIO1_7),
+        OFFSET_OF_IOCON(PIO1_8),
+        OFFSET_OF_IOCON(PIO1_9),
+        OFFSET_OF_IOCON(PIO1_10),
+        OFFSET_OF_IOCON(PIO1_11)
+    },
+    {
+        OFFSET_OF_IOCON(PIO2_0),
+        OFFSET_OF_IOCON(PIO2_1),
+        OFFSET_OF_IOCON(PIO2_2),
+        OFFSET_OF_IOCON(PIO2_3),
+        OFFSET_OF_IOCON(PIO2_4),
+        OFFSET_OF_IOCON(PIO2_5),
+        OFFSET_OF_IOCON(PIO2_6),
+        OFFSET_OF_IOCON(PIO2_7),
+        OFFSET_OF_IOCON(PIO2_8),
+        OFFSET_OF_IOCON(PIO2_9),
+        OFFSET_OF_IOCON(PIO2_10),
+        OFFSET_OF_IOCON(PIO2_11)
+    },
+    {
+        OFFSET_OF_IOCON(PIO3_0),
+        OFFSET_OF_IOCON(PIO3_1),
+        OFFSET_OF_IOCON(PIO3_2),
+        OFFSET_OF_IOCON(PIO3_3),
+        OFFSET_OF_IOCON(PIO3_4),
+        OFFSET_OF_IOCON(PIO3_5),
+        0
+    }
+};
+
+#undef OFFSET_OF_IOCON
+
 /**
  * Get a pointer to a low level IO configuration register.
  *
@@ -0,0 +1,183 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_PROFILER Run-time profiler
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Lightweight cycle accurate profiler for the main loop and interrupt handlers
+ * @details The profiler uses the SysTick counter together with the millisecond
+ *          system time as cycle accurate time stamp source. For every probe the
+ *          number of calls, the minimum, maximum and total duration as well as a
+ *          log2 histogram of the durations are collected.
+ *
+ *          The probes are only compiled in if @ref PROFILING is defined. Otherwise all
+ *          PROFILE_xxx macros expand to nothing. profiler.cpp, with the statistics
+ *          of all probes, is always part of the sblib library, so the unit tests
+ *          can use it. As the sblib is a static library, the linker only adds it to
+ *          the firmware when the application calls a profiler function directly.
+ *
+ *          Example:
+ *
+ *              void someHandler()
+ *              {
+ *                  PROFILE_SCOPE(PROFILE_USER_0);
+ *                  ...
+ *              }
+ *              ...
+ *              PROFILE_DUMP(serial);
+ *
+ * @{
+ *
+ * @file   profiler.h
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#ifndef SBLIB_PROFILER_H_
+#define SBLIB_PROFILER_H_
+
+#include <stdint.h>
+#include <sblib/libconfig.h>
+#include <sblib/types.h>
+#include <sblib/utils.h>
+
+class Print;
+
+/**
+ * The profiling probes.
+ * The PROFILE_USER_x probes are free to use by the application.
+ */
+enum ProfileProbe : uint8_t
+{
+    PROFILE_BCU_LOOP,                 //!< @ref BcuBase::loop
+    PROFILE_PROCESS_TELEGRAM,         //!< @ref TLayer4::processTelegram
+    PROFILE_SEND_NEXT_GROUP_TELEGRAM, //!< @ref ComObjects::sendNextGroupTelegram
+    PROFILE_FLUSH_USER_MEMORY,        //!< @ref BcuDefault::flushUserMemory
+    PROFILE_BUS_TIMER_ISR,            //!< @ref Bus::timerInterruptHandler
+    PROFILE_USER_0,                   //!< free to use by the application
+    PROFILE_USER_1,                   //!< free to use by the application
+    PROFILE_USER_2,                   //!< free to use by the application
+    PROFILE_USER_3,                   //!< free to use by the application
+    PROFILE_PROBE_COUNT               //!< number of probes, must be the last entry
+};
+
+#define PROFILE_HISTOGRAM_BUCKETS (16) //!< Number of log2 histogram buckets per probe
+#define PROFILE_HISTOGRAM_SHIFT   (5)  //!< Bucket 0 holds all durations below 2^(PROFILE_HISTOGRAM_SHIFT + 1) cycles
+
+/**
+ * The statistics collected for one probe. All durations are in CPU clock cycles.
+ *
+ * Bucket n of the histogram counts the durations d with
+ * 2^(n + PROFILE_HISTOGRAM_SHIFT) <= d < 2^(n + PROFILE_HISTOGRAM_SHIFT + 1).
+ * So bucket 0 holds all durations below 2^(PROFILE_HISTOGRAM_SHIFT + 1) and the last
+ * bucket all longer durations.
+ * Histogram counters saturate at 0xffff.
+ */
+struct ProfileStats
+{
+    uint32_t count;      //!< Number of measurements
+    uint32_t minCycles;  //!< Shortest measured duration
+    uint32_t maxCycles;  //!< Longest measured duration
+    uint64_t sumCycles;  //!< Sum of all measured durations
+    uint16_t histogram[PROFILE_HISTOGRAM_BUCKETS]; //!< log2 histogram of the durations
+};
+
+/**
+ * Size in bytes of the serialized statistics of one probe, see @ref profilerRead
+ */
+#define PROFILE_SERIALIZED_SIZE (4 + 4 + 4 + 4 + 2 * PROFILE_HISTOGRAM_BUCKETS)
+
+/**
+ * Get a cycle accurate time stamp.
+ *
+ * The time stamp is built from the millisecond system time and the SysTick counter
+ * value. A SysTick reload which was not yet handled by the SysTick_Handler, e.g. because
+ * we are called from an interrupt with higher priority, is taken into account.
+ * The time stamp wraps around after 2^32 cycles (~89s at 48MHz), so only use
+ * it to calculate short durations.
+ *
+ * @return Number of CPU clock cycles since the SysTick timer was started.
+ */
+uint32_t profilerCycles();
+
+/**
+ * Add a measured duration to the statistics of a probe.
+ *
+ * @param probe  - the probe to add the measurement to
+ * @param cycles - the duration in CPU clock cycles
+ */
+void profilerRecord(ProfileProbe probe, uint32_t cycles);
+
+/**
+ * Clear the statistics of all probes.
+ */
+void profilerReset();
+
+/**
+ * Get the statistics of a probe.
+ *
+ * @param probe - the probe
+ * @return The statistics of the probe.
+ */
+const ProfileStats& profilerStats(ProfileProbe probe);
+
+/**
+ * Print the statistics of all probes which were hit at least once.
+ * Durations are printed in microseconds.
+ *
+ * @param out - where to print to, e.g. serial
+ */
+void profilerDump(Print& out);
+
+/**
+ * Serialize the statistics of a probe, e.g. to answer a property or memory read.
+ * Format (big endian): count (4), min (4), max (4), average (4) in cycles,
+ * followed by the histogram buckets (2 each).
+ *
+ * @param probe  - the probe
+ * @param buffer - the buffer to write to
+ * @param maxLen - the size of the buffer
+ * @return Number of bytes written, 0 if the buffer is too small.
+ */
+int profilerRead(ProfileProbe probe, byte* buffer, int maxLen);
+
+/**
+ * Measures the time between its construction and destruction and adds it to a probe.
+ * Use it with @ref PROFILE_SCOPE.
+ */
+class ProfileScope
+{
+public:
+    ProfileScope(ProfileProbe aProbe) :
+        probe(aProbe),
+        start(profilerCycles())
+    {}
+
+    ~ProfileScope()
+    {
+        profilerRecord(probe, profilerCycles() - start);
+    }
+
+private:
+    ProfileProbe probe;
+    uint32_t start;
+};
+
+#if defined(PROFILING)
+    /** Measure the duration of the enclosing scope and add it to probe */
+#   define PROFILE_SCOPE(probe) ProfileScope CPP_CONCAT_EXPAND(profileScope_, __LINE__)(probe)
+    /** Print the statistics of all probes to out */
+#   define PROFILE_DUMP(out) profilerDump(out)
+    /** Clear the statistics of all probes */
+#   define PROFILE_RESET() profilerReset()
+#else
+#   define PROFILE_SCOPE(probe)
+#   define PROFILE_DUMP(out)
+#   define PROFILE_RESET()
+#endif
+
+#endif /* SBLIB_PROFILER_H_ */
+/** @}*/
@@ -42,6 +42,8 @@ enum eLastError {
   ERROR_TIMER_NOT_REACHED = 8
 };
 
+class Timer;
+
 /****************************************************************************
 * DHT Class
 *****************************************************************************/
@@ -60,10 +62,52 @@ public:
   float ConvertTemperature(eScale Scale);
   float CalcdewPointFast(float celsius, float humidity);
   //float CalcdewPoint(float celsius, float humidity);
+
+  /*
+   * Capture based, non-blocking reading. The pin must be the capture input
+   * channel of the timer, e.g. PIO1_5 for CT32B0_CAP0 of timer32_0. The timer
+   * is used exclusively and ticks with 1us, its interrupt handler must be
+   * created with DHT_TIMER_INTERRUPT_HANDLER. The start pulse is ended by a
+   * match interrupt, the bits are decoded from the falling edges captured
+   * in the interrupt. It runs at a lower priority than the bus timer.
+   */
+  void DHTTimerInit(Timer& timer, int captureChannel);
+  void DHTTimerInterruptHandler();
+
+  /*
+   * Start a non-blocking read. Returns false if the last read is less than
+   * leadTime ago (unless bForceRead) or a read is in progress, see _lastError.
+   */
+  bool startReadData(bool bForceRead =false);
+
+  /*
+   * Call from the main loop. Returns true once after a non-blocking read finished
+   * successfully, _lastHumidity and _lastTemperature are updated then. While
+   * reading _lastError is BUS_BUSY, after a failed read it tells the reason.
+   */
+  bool finishReadData();
+
 private:
   int  _pin, _lastReadTime;
   uint32_t _maxcycles;
   uint32_t expectPulse(bool level);
+  bool decodeData();
+
+  // Capture based reading
+  Timer *_timer = nullptr;
+  uint8_t _captureChannel;
+  volatile uint8_t _readState = 0;   // eReadState
+  volatile uint8_t _edgeCount;       // Falling edges received
+  uint16_t _lastEdge;                // Timer value of the last falling edge
 };
 
+/*
+ * Create the interrupt handler for the timer of the non-blocking read. Example:
+ *
+ * DHT dht;
+ * DHT_TIMER_INTERRUPT_HANDLER(TIMER32_0_IRQHandler, dht);
+ */
+#define DHT_TIMER_INTERRUPT_HANDLER(handler, dhtObj) \
+    extern "C" void handler() { dhtObj.DHTTimerInterruptHandler(); }
+
 #endif /* dht_h */
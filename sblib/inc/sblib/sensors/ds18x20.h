@@ -34,6 +34,14 @@ enum eDsType {
 };
 #endif
 
+// State of the queued scratchpad read of a device
+enum eDsAsyncState {
+  DS_ASYNC_IDLE = 0,    // Nothing queued
+  DS_ASYNC_QUEUED,      // Read is queued or in progress
+  DS_ASYNC_DONE,        // Read finished, processResults() converts it
+  DS_ASYNC_FAILED       // Device did not answer
+};
+
 // Ds18x20 device struct
 struct sDS18x20
 {
@@ -52,6 +60,8 @@ struct sDS18x20
   bool conversionStarted;
   // System time at which started conversion is readable
   unsigned int readyAt;
+  // eDsAsyncState, changed by the OneWire timer interrupt
+  volatile uint8_t asyncState;
 };
 
 /*
@@ -62,6 +72,10 @@ class DS18x20
 private:
   OneWire _OW_DS18x;
 
+  void convertScratchpad(sDS18x20* sDev);
+  static void conversionStartedCallback(void* context, bool bSuccess);
+  static void readDoneCallback(void* context, bool bSuccess);
+
 public:
   // time it takes for a reading
   // TODO: These vary:
@@ -184,6 +198,74 @@ public:
   * Returned value: Converted value
   */
   float ConvertTemperature(float fTemperature, eScale Scale);
+
+ /*
+  * Function name:  DS18x20TimerInit
+  * Descriptions:   Use the timer for the non-blocking functions startConversionAllAsync(),
+  *                 readResultAllAsync() and processResults(). Call it after DS18x20Init()
+  *                 and create the interrupt handler with DS18X20_TIMER_INTERRUPT_HANDLER.
+  *                 Search() is still blocking, call it before any async function.
+  * parameters:     timer, e.g. timer32_0
+  * Returned value: none
+  */
+  void DS18x20TimerInit(Timer& timer);
+
+ /*
+  * Function name:  DS18x20TimerInterruptHandler
+  * Descriptions:   Interrupt handler of the timer, see DS18X20_TIMER_INTERRUPT_HANDLER.
+  */
+  void DS18x20TimerInterruptHandler();
+
+/*
+ * Function name:  startConversionAllAsync
+ *
+ * Descriptions:   Queues the temperature conversion of all devices with a
+ *                 single Skip ROM command. Returns at once, the 1-Wire
+ *                 communication is done by the timer interrupt.
+ *
+ * Returned value: true, if the conversion was queued.
+ */
+  bool startConversionAllAsync();
+
+/*
+ * Function name:  readResultAllAsync
+ *
+ * Descriptions:   Queues the scratchpad read of every device whose conversion
+ *                 is ready. Devices that do not fit into the queue are
+ *                 queued by the next call. Call it from the main loop.
+ *
+ * Returned value: true, if one or more reads were queued.
+ */
+  bool readResultAllAsync();
+
+/*
+ * Function name:  processResults
+ *
+ * Descriptions:   Converts the finished scratchpad reads to temperatures.
+ *                 Call it from the main loop.
+ *
+ * Returned value: true, if one or more devices were read successfully.
+ *                 following global object parameters will be filled:
+ *                 last_temperature - the current read temperature
+ *                 lastReadOK       - will be set to true if read was successful
+ */
+  bool processResults();
+
+/*
+ * Function name:  asyncBusy
+ *
+ * Returned value: true, if queued 1-Wire operations are pending.
+ */
+  bool asyncBusy();
 };
 
+/*
+ * Create the interrupt handler for the timer of the non-blocking functions. Example:
+ *
+ * DS18x20 ds;
+ * DS18X20_TIMER_INTERRUPT_HANDLER(TIMER32_0_IRQHandler, ds);
+ */
+#define DS18X20_TIMER_INTERRUPT_HANDLER(handler, dsObj) \
+    extern "C" void handler() { dsObj.DS18x20TimerInterruptHandler(); }
+
 #endif /* ds18x20_h */
@@ -0,0 +1,171 @@
+/*
+ *  shift_register.h - Chain of shift registers on a SPI port
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_shift_register_h
+#define sblib_shift_register_h
+
+#include <sblib/ioports.h>
+#include <sblib/spi.h>
+#include <sblib/types.h>
+
+/**
+ * The maximum number of 8 bit shift registers in a chain.
+ */
+#ifndef SHIFT_REGISTER_MAX_LENGTH
+#   define SHIFT_REGISTER_MAX_LENGTH 8
+#endif
+
+
+/**
+ * A chain of 8 bit serial-in / parallel-out shift registers with an output latch,
+ * like the 74HC595, that is driven by a SPI port. The serial input of the first
+ * register is connected to MOSI, the shift clock to SCK and the latch clock of all
+ * registers to a GPIO pin.
+ *
+ * The outputs are set in a shadow image. update() sends the image to the chain and
+ * latches it, but only if the image was changed. The image is sent in 16 bit frames
+ * if the chain has an even number of registers, so 64 outputs need 4 SPI frames.
+ *
+ * Output 0 is Q0 of the first register of the chain, output 8 is Q0 of the second
+ * register, and so on.
+ *
+ * Example:
+ *
+ *     ShiftRegisterChain outputs(SPI_PORT_0, PIO0_9, PIO2_11, PIO0_2, 4);
+ *     ...
+ *     outputs.begin();
+ *     ...
+ *     outputs.set(17, true);
+ *     outputs.set(18, false);
+ *     outputs.update();
+ *
+ * The SPI port cannot be used for other devices while the chain uses it.
+ */
+class ShiftRegisterChain
+{
+public:
+    /**
+     * Create a shift register chain. The pin pinData must be capable of SPI MOSI for
+     * the selected SPI port, the pin pinClock must be capable of SPI CLK for the selected
+     * SPI port.
+     *
+     * @param spiPort - the SPI port to use, e.g. SPI_PORT_0
+     * @param pinData - the digital pin for the serial data, e.g. PIO0_9
+     * @param pinClock - the digital pin for the shift clock, e.g. PIO2_11
+     * @param pinLatch - the digital pin for the latch clock, e.g. PIO0_2
+     * @param length - the number of 8 bit shift registers, at most SHIFT_REGISTER_MAX_LENGTH
+     */
+    ShiftRegisterChain(int spiPort, int pinData, int pinClock, int pinLatch, int length);
+
+    /**
+     * Begin using the shift register chain. All outputs are switched off.
+     *
+     * @param clockDiv - the divider for the SPI clock, see SPI::setClockDivider()
+     */
+    void begin(int clockDiv = 4);
+
+    /**
+     * End using the shift register chain. The outputs keep their state.
+     */
+    void end();
+
+    /**
+     * Set an output in the image.
+     *
+     * @param output - the number of the output, starting with 0
+     * @param value - the value of the output
+     */
+    void set(int output, bool value);
+
+    /**
+     * Get an output from the image.
+     *
+     * @param output - the number of the output, starting with 0
+     * @return The value of the output.
+     */
+    bool get(int output) const;
+
+    /**
+     * Set all outputs of a register in the image.
+     *
+     * @param reg - the number of the register, starting with 0 for the first register
+     * @param value - the outputs Q0..Q7 as bits 0..7
+     */
+    void setRegister(int reg, byte value);
+
+    /**
+     * Get all outputs of a register from the image.
+     *
+     * @param reg - the number of the register, starting with 0 for the first register
+     * @return The outputs Q0..Q7 as bits 0..7.
+     */
+    byte getRegister(int reg) const;
+
+    /**
+     * Test if the image was changed since it was last sent.
+     *
+     * @return True if the image was changed.
+     */
+    bool changed() const;
+
+    /**
+     * Send the image to the shift registers and latch it, if the image was changed.
+     *
+     * In asynchronous mode the image is sent by the SPI interrupt, and the latch is
+     * set by the next call of update() or wait() after the transfer is done. Call
+     * update() regularly in this mode, e.g. in loop().
+     *
+     * @param async - true to send the image in the background.
+     * @return True if a new image was sent or latched.
+     */
+    bool update(bool async = false);
+
+    /**
+     * Wait until a transfer of update() is done and latch the image.
+     */
+    void wait();
+
+protected:
+    /**
+     * Convert the image to the SPI frames, in the order of sending.
+     *
+     * @return The number of frames.
+     */
+    int prepareFrames();
+
+    /**
+     * Latch the shifted image to the outputs.
+     */
+    void latch();
+
+protected:
+    SPI spi;
+    const int pinLatch;
+    const int length;
+    bool dirty;
+    bool transferring;
+    byte image[SHIFT_REGISTER_MAX_LENGTH];
+    uint16_t frames[SHIFT_REGISTER_MAX_LENGTH];
+};
+
+
+inline bool ShiftRegisterChain::get(int output) const
+{
+    return (image[output >> 3] & (1 << (output & 7))) != 0;
+}
+
+inline byte ShiftRegisterChain::getRegister(int reg) const
+{
+    return image[reg];
+}
+
+inline bool ShiftRegisterChain::changed() const
+{
+    return dirty;
+}
+
+#endif /*sblib_shift_register_h*/
@@ -223,7 +223,7 @@ protected:
     int        recCount;
     int        errors;
 public:
-    bool       finished;
+    volatile bool finished;
 };
 
 
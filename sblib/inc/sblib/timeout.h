@@ -29,6 +29,8 @@ class Timeout
  *     t.start(10); // starts a timeout which will expire in 10ms
  *
  *     t.expired(); // returns of the timeout has already expired or not
+ *
+ * For timers with callbacks see SoftTimer in sblib/timer_wheel.h.
  */
 {
 public:
@@ -25,6 +25,20 @@ class Timer;
  */
 void delay(unsigned int msec);
 
+/**
+ * Sleep until an interrupt occurs, but at most a number of milliseconds.
+ * Instead of waking up with every millisecond tick, the SysTick is reprogrammed
+ * to expire only once at the end of the sleep. The system time is corrected when
+ * waking up, before the interrupt that woke the processor is handled, so the
+ * interrupt handlers see the correct millis() and micros().
+ *
+ * The sleep is limited by the 24 bit SysTick counter, e.g. to 349 milliseconds
+ * with a 48MHz system clock.
+ *
+ * @param msec - the maximum number of milliseconds to sleep, 0 does not sleep at all.
+ */
+void sleepUntilInterrupt(unsigned int msec);
+
 /**
  * The number of minimal Microseconds possible for delayMicroseconds().
  */
@@ -72,6 +86,16 @@ void setMillis(unsigned int newSystemTime);
  */
 unsigned int millis();
 
+/**
+ * Get the number of microseconds that elapsed since the last reset or processor start.
+ * The value is built from the millisecond system time and the SysTick counter, so it
+ * can also be called from an interrupt handler with a higher priority than the SysTick.
+ * Please note that the value overflows and restarts at zero after 71,5 minutes.
+ *
+ * @return The number of microseconds.
+ */
+unsigned int micros();
+
 /**
  * Get the number of milliseconds that elapsed since the reference time.
  *
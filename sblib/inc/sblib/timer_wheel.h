@@ -0,0 +1,214 @@
+/*
+ *  timer_wheel.h - Software timers that are managed by a hierarchical timer wheel
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+#ifndef sblib_timer_wheel_h
+#define sblib_timer_wheel_h
+
+#include <sblib/types.h>
+
+/**
+ * The number of bits of the slot index of a level of the timer wheel.
+ */
+#define TIMER_WHEEL_SLOT_BITS 4
+
+/**
+ * The number of slots of a level of the timer wheel.
+ */
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+
+/**
+ * The number of levels of the timer wheel. A level covers TIMER_WHEEL_SLOTS times
+ * the time of the level below, the lowest level has slots of 1 millisecond.
+ * Longer timeouts than the wheel covers (approx. 17 minutes) are supported too,
+ * they pass through the top level more than once.
+ */
+#define TIMER_WHEEL_LEVELS 5
+
+/**
+ * The return value of TimerWheel::idleTime() when no timer is running.
+ */
+#define TIMER_WHEEL_IDLE_FOREVER 0xffffffff
+
+class SoftTimer;
+
+
+/**
+ * Interface for the receivers of software timer callbacks.
+ */
+class TimerCallback
+{
+public:
+    /**
+     * Called from TimerWheel::dispatch() when a timer expired.
+     *
+     * @param timer - the expired timer
+     */
+    virtual void timerExpired(SoftTimer* timer) = 0;
+};
+
+
+/**
+ * A software timer that is managed by the timer wheel. Starting and stopping
+ * the timer takes constant time, independent of the number of running timers.
+ *
+ * When the timer expires, TimerWheel::dispatch() calls the callback of the timer.
+ * A timer without callback can be polled with expired(), like a Timeout.
+ *
+ * Example:
+ *
+ *     SoftTimer t;
+ *     ...
+ *     t.start(10); // starts a timer which will expire in 10ms
+ *     ...
+ *     if (t.expired())
+ *         ...
+ */
+class SoftTimer
+{
+public:
+    /**
+     * Create a stopped timer.
+     *
+     * @param callback - the receiver of the callback when the timer expires, may be 0
+     */
+    SoftTimer(TimerCallback* callback = 0);
+
+    /**
+     * Destroy the timer. The timer is stopped.
+     */
+    ~SoftTimer();
+
+    /**
+     * Start the timer. A running timer is restarted.
+     *
+     * @param ms - the timeout in milliseconds, 0 stops the timer.
+     */
+    void start(unsigned int ms);
+
+    /**
+     * Stop the timer.
+     */
+    void stop();
+
+    /**
+     * Test if the timer expired. The expiry is reported only once, the timer is
+     * stopped afterwards.
+     *
+     * @return True if the timer expired since it was started.
+     */
+    bool expired();
+
+    /**
+     * Test if the timer was started and the expiry was not reported yet.
+     *
+     * @return True if the timer is started.
+     */
+    bool started() const;
+
+    /**
+     * Test if the timer is stopped.
+     *
+     * @return True if the timer is stopped.
+     */
+    bool stopped() const;
+
+private:
+    friend class TimerWheel;
+
+    TimerCallback* callback;   //!< The receiver of the callback, may be 0
+    SoftTimer* next;           //!< The next timer in the slot of the timer wheel
+    SoftTimer** link;          //!< The pointer to this timer in the slot, 0 if the timer is not running
+    unsigned int expires;      //!< The system time when the timer expires
+    bool fired;                //!< True if the timer expired and expired() did not report it yet
+};
+
+
+/**
+ * A hierarchical timer wheel that manages the software timers. The time base is the
+ * system time of the SysTick interrupt, see millis().
+ *
+ * dispatch() must be called from the main loop, it calls the callbacks of the expired
+ * timers. This is done by BcuBase::loop(). The time for dispatch() depends on the time
+ * since the last call and not on the number of running timers.
+ */
+class TimerWheel
+{
+public:
+    TimerWheel();
+
+    /**
+     * Process the expired timers. Called from the main loop.
+     */
+    void dispatch();
+
+    /**
+     * Get the time until the next timer can expire. The main loop can sleep for this
+     * time when there is nothing else to do. The time can be shorter than the time to
+     * the real expiry of the next timer, but never longer.
+     *
+     * @return The time in milliseconds, TIMER_WHEEL_IDLE_FOREVER if no timer is running.
+     */
+    unsigned int idleTime() const;
+
+    /**
+     * Get the number of running timers.
+     *
+     * @return The number of running timers.
+     */
+    unsigned int running() const;
+
+private:
+    friend class SoftTimer;
+
+    void add(SoftTimer* timer);
+    void remove(SoftTimer* timer);
+    void cascade(int level);
+    void expire();
+    void rebase();
+    unsigned int ticksToNextEvent() const;
+
+    SoftTimer* slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS]; //!< The lists of timers
+    unsigned int current;  //!< The system time that was processed last
+    unsigned int count;    //!< The number of running timers
+};
+
+/**
+ * The timer wheel of the software timers.
+ */
+extern TimerWheel timerWheel;
+
+
+inline SoftTimer::SoftTimer(TimerCallback* callback)
+    : callback(callback)
+    , next(0)
+    , link(0)
+    , expires(0)
+    , fired(false)
+{
+}
+
+inline SoftTimer::~SoftTimer()
+{
+    stop();
+}
+
+inline bool SoftTimer::started() const
+{
+    return link || fired;
+}
+
+inline bool SoftTimer::stopped() const
+{
+    return !started();
+}
+
+inline unsigned int TimerWheel::running() const
+{
+    return count;
+}
+
+#endif /*sblib_timer_wheel_h*/
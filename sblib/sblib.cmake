@@ -4,6 +4,7 @@ set(SBLIB_CORE_SRC
 #        inc/sblib/hardware/gpio_lpc11xx_gnax.h
         inc/sblib/internal/iap.h
         inc/sblib/analog_pin.h
+        inc/sblib/analog_sampler.h
         inc/sblib/arrays.h
         inc/sblib/bits.h
         inc/sblib/buffered_stream.h
@@ -20,13 +21,17 @@ set(SBLIB_CORE_SRC
         inc/sblib/math.h
         inc/sblib/mem_mapper.h
         inc/sblib/onewire.h
+        inc/sblib/pin.h
         inc/sblib/platform.h
         inc/sblib/print.h
+        inc/sblib/profiler.h
         inc/sblib/serial.h
+        inc/sblib/shift_register.h
         inc/sblib/spi.h
         inc/sblib/stream.h
         inc/sblib/timeout.h
         inc/sblib/timer.h
+        inc/sblib/timer_wheel.h
         inc/sblib/types.h
         inc/sblib/usr_callback.h
         inc/sblib/utils.h
@@ -40,6 +45,7 @@ set(SBLIB_CORE_SRC
         src/lpc11xx/digital_pin_pulse.cpp
         src/lpc11xx/platform.cpp
         src/analog_pin.cpp
+        src/analog_sampler.cpp
         src/arrays.cpp
         src/buffered_stream.cpp
         src/debounce.cpp
@@ -51,12 +57,16 @@ set(SBLIB_CORE_SRC
         src/mem_mapper.cpp
         src/new.cpp
         src/onewire.cpp
+        src/onewire_timer.cpp
         src/print.cpp
+        src/profiler.cpp
         src/serial.cpp
         src/serial0.cpp
+        src/shift_register.cpp
         src/spi.cpp
         src/stream.cpp
         src/timer.cpp
+        src/timer_wheel.cpp
         src/utils.cpp
         src/version.cpp
 )
@@ -71,11 +81,13 @@ set(SBLIB_KNX_SRC
         inc/sblib/eib/bcu_base.h
 #        inc/sblib/eib/bcu_const.h
         inc/sblib/eib/bcu_default.h
+        inc/sblib/eib/bcu_static.h
         inc/sblib/eib/bcu1.h
         inc/sblib/eib/bcu2.h
         inc/sblib/eib/bus.h
         inc/sblib/eib/bus_const.h
         inc/sblib/eib/bus_debug.h
+        inc/sblib/eib/bus_monitor.h
 #        inc/sblib/eib/callback_bcu.h
 #        inc/sblib/eib/callback_bus.h
         inc/sblib/eib/com_objects.h
@@ -85,6 +97,7 @@ set(SBLIB_KNX_SRC
         inc/sblib/eib/com_objectsMASK0705.h
         inc/sblib/eib/com_objectsSYSTEMB.h
         inc/sblib/eib/datapoint_types.h
+        inc/sblib/eib/ft12_interface.h
         inc/sblib/eib/knx_lpdu.h
         inc/sblib/eib/knx_npdu.h
         inc/sblib/eib/knx_tlayer4.h
@@ -98,6 +111,7 @@ set(SBLIB_KNX_SRC
         inc/sblib/eib/propertiesSYSTEMB.h
         inc/sblib/eib/property_types.h
         inc/sblib/eib/systemb.h
+        inc/sblib/eib/tp_uart.h
         inc/sblib/eib/types.h
         inc/sblib/eib/typesBCU1.h
         inc/sblib/eib/typesBCU2.h
@@ -132,12 +146,14 @@ set(SBLIB_KNX_SRC
         src/eib/bcu2.cpp
         src/eib/bus.cpp
         src/eib/bus_debug.cpp
+        src/eib/bus_monitor.cpp
 #        src/eib/callback_bcu.cpp
         src/eib/com_objects.cpp
         src/eib/com_objectsBCU1.cpp
         src/eib/com_objectsBCU2.cpp
         src/eib/com_objectsSYSTEMB.cpp
         src/eib/datapoint_types.cpp
+        src/eib/ft12_interface.cpp
         src/eib/hardware_descriptor.cpp
         src/eib/knx_tlayer4.cpp
         src/eib/mask0701.cpp
@@ -148,6 +164,7 @@ set(SBLIB_KNX_SRC
         src/eib/propertiesSYSTEMB.cpp
         src/eib/property_types.cpp
         src/eib/systemb.cpp
+        src/eib/tp_uart.cpp
         src/eib/userEeprom.cpp
         src/eib/userRam.cpp
 )
@@ -159,6 +176,7 @@ set(SBLIB_PERIPHERIE_SRC
         inc/sblib/i2c/ds3231.h
         inc/sblib/i2c/iaq-core.h
         inc/sblib/i2c/sensirion_gas_index_algorithm.h
+        inc/sblib/i2c/sensirion_gas_index_algorithm_fix16.h
         inc/sblib/i2c/SGP4x.h
         inc/sblib/i2c/SHT1x.h
         inc/sblib/i2c/SHT2x.h
@@ -177,6 +195,7 @@ set(SBLIB_PERIPHERIE_SRC
         src/i2c/ds3231.cpp
         src/i2c/iaq-core.cpp
         src/i2c/sensirion_gas_index_algorithm.cpp
+        src/i2c/sensirion_gas_index_algorithm_fix16.cpp
         src/i2c/SGP4x.cpp
         src/i2c/SHT1x.cpp
         src/i2c/SHT2x.cpp
@@ -0,0 +1,173 @@
+/*
+ *  analog_sampler.cpp - Interrupt driven background sampling of the analog inputs
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/analog_sampler.h>
+
+#include <sblib/analog_pin.h>
+#include <sblib/interrupt.h>
+#include <sblib/platform.h>
+
+// ADC conversion complete
+#define ADC_DONE  0x80000000
+
+// ADC overrun
+#define ADC_OVERRUN  0x40000000
+
+// Burst mode: convert the selected channels continuously
+#define ADC_BURST  (1 << 16)
+
+// Maximum clock for AD conversion
+#define ADC_MAX_CLOCK  4500000
+
+
+AnalogSampler analogSampler;
+
+extern "C" void ADC_IRQHandler()
+{
+    analogSampler.interruptHandler();
+}
+
+void AnalogSampler::begin(unsigned int channels, unsigned int oversampling, unsigned int adcClock)
+{
+    end();
+
+    channels &= 0xff;
+    if (!channels)
+        return;
+
+    if (oversampling < 1)
+        oversampling = 1;
+    else if (oversampling > 0xffff)
+        oversampling = 0xffff;
+
+    if (adcClock > ADC_MAX_CLOCK)
+        adcClock = ADC_MAX_CLOCK;
+    else if (adcClock < 1)
+        adcClock = 1;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        Channel& ch = channelData[i];
+        ch.sum = 0;
+        ch.accu = 0;
+        ch.accuCount = 0;
+        ch.pos = 0;
+        ch.fill = 0;
+        ch.latest = 0;
+        ch.count = 0;
+    }
+    this->oversampling = oversampling;
+    overrunCount = 0;
+
+    analogBegin();
+
+    unsigned int clockDiv = (SystemCoreClock / LPC_SYSCON->SYSAHBCLKDIV) / adcClock;
+    if (clockDiv > 0)
+        --clockDiv;
+    if (clockDiv > 0xff)
+        clockDiv = 0xff;
+
+    // Interrupt once per scan, when the highest selected channel is done
+    unsigned int lastChannel = 7;
+    while (!(channels & (1 << lastChannel)))
+        --lastChannel;
+    LPC_ADC->INTEN = 1 << lastChannel;
+
+    for (int i = 0; i < 8; ++i)
+        LPC_ADC->DR[i]; // read the channels to clear the "done" flags
+
+    this->channels = channels;
+
+    // Set lower priority for the ADC than the bus access timer has.
+    NVIC_SetPriority(ADC_IRQn, 1);
+    enableInterrupt(ADC_IRQn);
+
+    LPC_ADC->CR = channels | (clockDiv << 8) | ADC_BURST;
+}
+
+void AnalogSampler::end()
+{
+    if (!channels)
+        return;
+
+    LPC_ADC->CR = 0;
+    disableInterrupt(ADC_IRQn);
+    LPC_ADC->INTEN = 0x100; // reset value
+    channels = 0;
+    analogEnd();
+}
+
+int AnalogSampler::value(int channel) const
+{
+    const Channel& ch = channelData[channel];
+    if (!ch.count)
+        return -1;
+    return ch.latest;
+}
+
+int AnalogSampler::average(int channel) const
+{
+    const Channel& ch = channelData[channel];
+
+    noInterrupts();
+    unsigned int sum = ch.sum;
+    unsigned int fill = ch.fill;
+    interrupts();
+
+    if (!fill)
+        return -1;
+    return (sum + (fill >> 1)) / fill;
+}
+
+void AnalogSampler::interruptHandler()
+{
+    unsigned int mask = channels;
+    for (int channel = 0; mask; ++channel, mask >>= 1)
+    {
+        if (!(mask & 1))
+            continue;
+
+        // Reading the data register clears the "done" and the "overrun" flag
+        unsigned int regVal = LPC_ADC->DR[channel];
+        if (!(regVal & ADC_DONE))
+            continue;
+
+        if (regVal & ADC_OVERRUN)
+            ++overrunCount;
+
+        addConversion(channelData[channel], (regVal >> 6) & 0x3ff);
+    }
+}
+
+/*
+ * Add a conversion result to the oversampling accumulator of the channel, and
+ * store the decimated value when enough conversions are collected.
+ */
+void AnalogSampler::addConversion(Channel& ch, unsigned int value)
+{
+    ch.accu += value;
+    if (++ch.accuCount < oversampling)
+        return;
+
+    value = (ch.accu + (oversampling >> 1)) / oversampling;
+    ch.accu = 0;
+    ch.accuCount = 0;
+
+    if (ch.fill < ANALOG_SAMPLER_BUFFER_SIZE)
+        ++ch.fill;
+    else
+        ch.sum -= ch.values[ch.pos];
+
+    ch.sum += value;
+    ch.values[ch.pos] = value;
+    if (++ch.pos >= ANALOG_SAMPLER_BUFFER_SIZE)
+        ch.pos = 0;
+
+    ch.latest = value;
+    ++ch.count;
+}
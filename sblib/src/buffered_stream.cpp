@@ -31,6 +31,21 @@ int BufferedStream::peek()
     return readBuffer[readHead];
 }
 
+void BufferedStream::received(byte ch)
+{
+    if (receiveCallback)
+    {
+        receiveCallback->byteReceived(ch);
+    }
+    else if (!readBufferFull())
+    {
+        readBuffer[readTail] = ch;
+
+        ++readTail;
+        readTail &= BufferedStream::BUFFER_SIZE_MASK;
+    }
+}
+
 int BufferedStream::available()
 {
     int num = readTail - readHead;
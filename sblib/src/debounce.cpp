@@ -10,6 +10,9 @@
 
 #include <sblib/debounce.h>
 
+#include <sblib/digital_pin.h>
+#include <sblib/interrupt.h>
+#include <sblib/platform.h>
 #include <sblib/timer.h>
 
 
@@ -34,3 +37,85 @@ int Debouncer::debounce(int current, unsigned int timeout)
 
     return valid;
 }
+
+
+DebouncerBank::DebouncerBank()
+:ports()
+,time(0)
+{
+}
+
+void DebouncerBank::addPins(int port, unsigned int pinMask)
+{
+    PortState& ps = ports[port];
+    unsigned int current = gpioPorts[port]->DATA & pinMask;
+
+    noInterrupts();
+    ps.mask |= pinMask;
+    ps.state = (ps.state & ~pinMask) | current;
+    ps.count0 |= pinMask;
+    ps.count1 |= pinMask;
+    ps.changes &= ~pinMask;
+    interrupts();
+}
+
+void DebouncerBank::addPin(int pin)
+{
+    addPins(digitalPinToPort(pin), digitalPinToBitMask(pin));
+}
+
+bool DebouncerBank::sample()
+{
+    unsigned int any = 0;
+
+    for (PortState* ps = ports; ps < ports + DEBOUNCER_BANK_PORTS; ++ps)
+    {
+        if (!ps->mask)
+            continue;
+
+        // The counters of the pins without a difference are reset to 3,
+        // the others count down. A pin toggles when its counter wraps to 3.
+        unsigned int delta = (gpioPorts[ps - ports]->DATA ^ ps->state) & ps->mask;
+        ps->count0 = ~(ps->count0 & delta);
+        ps->count1 = ps->count0 ^ (ps->count1 & delta);
+
+        unsigned int toggle = delta & ps->count0 & ps->count1;
+        ps->state ^= toggle;
+        ps->changes |= toggle;
+        any |= toggle;
+    }
+
+    return any != 0;
+}
+
+bool DebouncerBank::debounce(unsigned int interval)
+{
+    const unsigned int now = millis();
+    if ((int) (now - (time + interval)) >= 0)
+    {
+        time = now;
+        sample();
+    }
+
+    for (int port = 0; port < DEBOUNCER_BANK_PORTS; ++port)
+    {
+        if (ports[port].changes)
+            return true;
+    }
+    return false;
+}
+
+bool DebouncerBank::pinValue(int pin) const
+{
+    return (value(digitalPinToPort(pin)) & digitalPinToBitMask(pin)) != 0;
+}
+
+unsigned int DebouncerBank::changed(int port)
+{
+    noInterrupts();
+    unsigned int result = ports[port].changes;
+    ports[port].changes = 0;
+    interrupts();
+
+    return result;
+}
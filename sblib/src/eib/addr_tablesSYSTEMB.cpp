@@ -11,21 +11,5 @@
 
 int AddrTablesSYSTEMB::indexOfAddr(int addr)
 {
-    byte* tab = addrTable();
-    int num = 0;
-
-    if (tab)
-        num = (tab[0] << 8) + tab[1];
-    tab += 2;
-
-    int addrHigh = addr >> 8;
-    int addrLow = addr & 255;
-
-    for (int i = 1; i <= num; ++i, tab += 2)
-    {
-        if (tab[0] == addrHigh && tab[1] == addrLow)
-            return i;
-    }
-
-    return -1;
+    return indexOfAddr(*this, addr);
 }
@@ -7,10 +7,12 @@
  *  published by the Free Software Foundation.
  */
 
+#include <sblib/core.h>
 #include <sblib/io_pin_names.h>
 #include <sblib/eib/knx_lpdu.h>
 #include <sblib/eib/bcu_base.h>
 #include <sblib/eib/bus.h>
+#include <sblib/profiler.h>
 
 static Bus* timerBusObj;
 // The interrupt handler for the EIB bus access object
@@ -21,16 +23,18 @@ BUS_TIMER_INTERRUPT_HANDLER(TIMER16_1_IRQHandler, (*timerBusObj))
 #endif
 
 BcuBase::BcuBase(UserRam* userRam, AddrTables* addrTables) :
-        TLayer4(maxTelegramSize()),
-        bus(new Bus(this, timer16_1, PIN_EIB_RX, PIN_EIB_TX, CAP0, MAT0)),
+        TLayer4(),
+        bus(&busInstance),
         progPin(PIN_PROG),
         userRam(userRam),
         addrTables(addrTables),
         comObjects(nullptr),
         progButtonDebouncer(),
+        progButtonTime(0),
         restartType(RestartType::None),
         restartSendDisconnect(false),
-        restartTimeout(Timeout())
+        restartTimeout(),
+        busInstance(this, timer16_1, PIN_EIB_RX, PIN_EIB_TX, CAP0, MAT0)
 {
     timerBusObj = bus;
     setFatalErrorPin(progPin);
@@ -45,6 +49,8 @@ void BcuBase::_begin()
 
 void BcuBase::loop()
 {
+    PROFILE_SCOPE(PROFILE_BCU_LOOP);
+    timerWheel.dispatch();
     bus->loop();
     TLayer4::loop();
 
@@ -68,6 +74,7 @@ void BcuBase::loop()
     {
         // Detect the falling edge of pressing the prog button
         pinMode(progPin, INPUT|PULL_UP);
+        progButtonTime = millis();
         int oldValue = progButtonDebouncer.value();
         if (!progButtonDebouncer.debounce(digitalRead(progPin), 50) && oldValue)
         {
@@ -112,6 +119,39 @@ void BcuBase::loop()
     }
 }
 
+unsigned int BcuBase::idleTime()
+{
+    if (bus->telegramReceived() || bus->sendingFrame() || directConnection() ||
+        sendTelegramPending() || (restartType != RestartType::None))
+    {
+        return 0;
+    }
+
+    unsigned int idle = timerWheel.idleTime();
+    if (progPin)
+    {
+        int nextSample = progButtonTime + BCU_PROG_BUTTON_POLL_TIME - millis();
+        if (nextSample <= 0)
+        {
+            return 0;
+        }
+        if ((unsigned int) nextSample < idle)
+        {
+            idle = nextSample;
+        }
+    }
+    return idle;
+}
+
+int BcuBase::indexOfGroupAddress(int addr)
+{
+    if (addrTables == nullptr)
+    {
+        return -1;
+    }
+    return addrTables->indexOfAddr(addr);
+}
+
 bool BcuBase::setProgrammingMode(bool newMode)
 {
     if (!progPin)
@@ -163,11 +203,6 @@ bool BcuBase::programmingMode() const
     return (userRam->status() & BCU_STATUS_PROGRAMMING_MODE) == BCU_STATUS_PROGRAMMING_MODE;
 }
 
-int BcuBase::maxTelegramSize()
-{
-    return 23;
-}
-
 void BcuBase::discardReceivedTelegram()
 {
     bus->discardReceivedTelegram();
@@ -12,6 +12,7 @@
 #include <sblib/eib/bcu_default.h>
 #include <string.h>
 #include <sblib/eib/bus.h>
+#include <sblib/profiler.h>
 
 #if defined(INCLUDE_SERIAL)
 #   include <sblib/serial.h>
@@ -154,6 +155,44 @@ void BcuDefault::loop()
     }
 }
 
+unsigned int BcuDefault::idleTime()
+{
+    if (!enabled)
+    {
+        return BcuBase::idleTime();
+    }
+
+    unsigned int idle = BcuBase::idleTime();
+    if (userEeprom->isModified())
+    {
+        // The flush waits for the write delay, or for the end of the direct connection
+        unsigned int writeDelay = userEeprom->writeDelayRemaining();
+        if (directConnection() || writeDelay == 0)
+        {
+            return 0;
+        }
+        if (writeDelay < idle)
+        {
+            idle = writeDelay;
+        }
+    }
+
+    if (sendGrpTelEnabled && applicationRunning() && comObjects->transmissionRequested())
+    {
+        // The next group telegram waits for the rate limit
+        unsigned int sinceSent = elapsed(groupTelSent);
+        if (sinceSent >= groupTelWaitMillis)
+        {
+            return 0;
+        }
+        if (groupTelWaitMillis - sinceSent < idle)
+        {
+            idle = groupTelWaitMillis - sinceSent;
+        }
+    }
+    return idle;
+}
+
 void BcuDefault::end()
 {
     flushUserMemory(UsrCallbackType::bcu_end);
@@ -590,6 +629,7 @@ void BcuDefault::softSystemReset()
 
 bool BcuDefault::flushUserMemory(UsrCallbackType reason)
 {
+    PROFILE_SCOPE(PROFILE_FLUSH_USER_MEMORY);
 ///\todo workaround for lib test cases running into an infinitive loop
 #ifndef IAP_EMULATION
     bus->pause();
@@ -16,27 +16,41 @@
 #include <sblib/eib/knx_npdu.h>
 #include <sblib/core.h>
 #include <sblib/interrupt.h>
+#include <sblib/pin.h>
 #include <sblib/platform.h>
 #include <sblib/eib/addr_tables.h>
 #include <sblib/eib/bcu_base.h>
 #include <sblib/eib/bus_const.h>
 #include <sblib/eib/bus_debug.h>
+#include <sblib/eib/tp_uart.h>
+#include <sblib/profiler.h>
+#include <string.h>
 
 // constructor for Bus object. Initialize basic interface parameter to bus and set SM to IDLE
 Bus::Bus(BcuBase* bcuInstance, Timer& aTimer, int aRxPin, int aTxPin, TimerCapture aCaptureChannel, TimerMatch aPwmChannel)
-:bcu(bcuInstance)
+:telegram(rxBuffers[0])
+,bcu(bcuInstance)
 ,timer(aTimer)
 ,rxPin(aRxPin)
 ,txPin(aTxPin)
 ,captureChannel(aCaptureChannel)
 ,pwmChannel(aPwmChannel)
+,monitor(nullptr)
+,sendCallback(nullptr)
+,transceiver(nullptr)
+,rx_telegram(rxBuffers[1])
+,rxBuffers()
+,rxHistory()
+,rxHistoryNext(0)
+,rxDestination(RX_DESTINATION_UNKNOWN)
 {
+    static_assert(sizeof(rxBuffers[0]) == BcuBase::maxTelegramSize(), "Bus: the receive buffers must hold the largest telegram");
+
     timeChannel = (TimerMatch) ((pwmChannel + 2) & 3);  // +2 to be compatible to old code during refactoring
     state = Bus::INIT;
     sendRetriesMax = NACK_RETRY_DEFAULT;
     sendBusyRetriesMax = BUSY_RETRY_DEFAULT;
     setKNX_TX_Pin(txPin);
-    telegram = new byte[bcu->maxTelegramSize()]();
 }
 
 /**
@@ -56,10 +70,22 @@ void Bus::begin()
 
     telegramLen = 0;
     rx_error = RX_OK;
+    memset(rxHistory, 0, sizeof(rxHistory));
+    rxHistoryNext = 0;
 
     tx_error = TX_OK;
     sendCurTelegram = nullptr;
     prepareForSending();
+
+    if (transceiver)
+    {
+        sendAck = 0;
+        nextByteIndex = 0;
+        rxDestination = RX_DESTINATION_UNKNOWN;
+        transceiver->begin(this);
+        return;
+    }
+
     //initialize bus-timer( e.g. defined as 16bit timer1)
     timer.setIRQPriority(0); // ensure highest IRQ-priority for the Bus timer
     timer.begin();
@@ -109,13 +135,17 @@ void Bus::begin()
     ); // DB_BUS
 
 #ifdef PIO_FOR_TEL_END_IND
-    pinMode(PIO_FOR_TEL_END_IND, OUTPUT);
-    digitalWrite(PIO_FOR_TEL_END_IND, 0);
+    Pin<PIO_FOR_TEL_END_IND>::mode<OUTPUT>();
+    Pin<PIO_FOR_TEL_END_IND>::clear();
 #endif
 }
 
 void Bus::pause(bool waitForTelegramSent)
 {
+    // The transceiver keeps the bus timing by itself
+    if (transceiver)
+        return;
+
     auto paused = false;
 
     while (!paused)
@@ -146,6 +176,9 @@ void Bus::resume()
     // or WAIT_50BT_FOR_NEXT_RX_OR_PENDING_TX_OR_IDLE. That costs quite some code size, though, so
     // take the easy (and small) route.
 
+    if (transceiver)
+        return;
+
     noInterrupts();
     initState();
     interrupts();
@@ -207,7 +240,8 @@ void Bus::sendTelegram(unsigned char* telegram, unsigned short length)
 {
     prepareTelegram(telegram, length);
 
-    // Wait until there is space in the sending queue
+    // Wait until there is space in the sending queue. The bus timer interrupt, or the
+    // receive interrupt of the transceiver's serial port, ends sending the current telegram.
     while (sendCurTelegram != nullptr);
 
     sendCurTelegram = telegram;
@@ -225,6 +259,12 @@ void Bus::sendTelegram(unsigned char* telegram, unsigned short length)
         serial.println();
     );
 
+    if (transceiver)
+    {
+        transceiver->send(telegram, length + 1);
+        return;
+    }
+
     // Start sending if the bus is idle or sending will be triggered in WAIT_50BT_FOR_NEXT_RX_OR_PENDING_TX_OR_IDLE after finishing current TX/RX
     noInterrupts();
     if (state == IDLE)
@@ -332,7 +372,7 @@ void Bus::prepareForSending()
  *
  * Output data:
  *    processTel: indicate telegram reception to the looping function by setting <processTel> to true
- *    telegram[]: received telegram in telegram buffer <telegram[]>, length in telegramLen
+ *    telegram[]: received telegram, the rx buffer is swapped with the buffer of <telegram[]>, length in telegramLen
  *    telegramLen: rx telegram length
  *    sendAck:  !0:  RX process need to send ack to sending side back, set wait timer accordingly
  *
@@ -362,6 +402,14 @@ void Bus::handleTelegram(bool valid)
         }
     );
 
+    if (monitor && nextByteIndex)
+    {
+        if (nextByteIndex == 1) // an acknowledge frame has no checksum, only the parity is checked
+            monitor->capture(rx_telegram, 1, BUS_MONITOR_ACK | (this->valid ? BUS_MONITOR_VALID : 0), rx_error & ~RX_CHECKSUM_ERROR);
+        else
+            monitor->capture(rx_telegram, nextByteIndex, valid ? BUS_MONITOR_VALID : 0, rx_error);
+    }
+
     sendAck = 0; // clear any pending ACK TX
     int time = SEND_WAIT_TIME -  PRE_SEND_TIME; // default wait time after bus action
     state = Bus::WAIT_50BT_FOR_NEXT_RX_OR_PENDING_TX_OR_IDLE;//  default next state is wait for 50 bit times for pending tx or new rx
@@ -373,79 +421,14 @@ void Bus::handleTelegram(bool valid)
     // Received a valid telegram with correct checksum and valid control byte (normal data frame with preamble bits)?
     //todo extended tel, check tel len, give upper layer error info
     if (nextByteIndex >= 8 && valid && (( rx_telegram[0] & VALID_DATA_FRAME_TYPE_MASK) == VALID_DATA_FRAME_TYPE_VALUE)
-        && nextByteIndex <= bcu->maxTelegramSize()  )
+        && nextByteIndex <= MAX_TELEGRAM_SIZE  )
     {
-        int destAddr = (rx_telegram[3] << 8) | rx_telegram[4];
-        bool processTel = false;
-
-        // Only process the telegram if it is for us
-        if (rx_telegram[5] & 0x80) // group address or physical address
-        {
-            processTel = (destAddr == 0); // broadcast
-            processTel |= (bcu->addrTables != nullptr) && (bcu->addrTables->indexOfAddr(destAddr) >= 0); // known group address
-        }
-        else if (destAddr == bcu->ownAddress())
+        sendAck = acceptTelegram();
+        if (sendAck)
         {
-            processTel = true;
-        }
-
-        // with disabled TL we also process the telegram, so the application (e.g. ft12, knx-if) can handle it completely by itself
-        processTel |= !(bcu->userRam->status() & BCU_STATUS_TRANSPORT_LAYER);
-
-        DB_TELEGRAM(telRXNotProcessed = !processTel);
-
-        if (processTel)
-        {// check for repeated telegram, did we already received it
-            // check the repeat bit in header and compare with previous received telegram still stored in the telegram[] buffer
-            bool already_received = false;
-            if (!(rx_telegram[0] & SB_TEL_REPEAT_FLAG)) // a repeated tel
-            {// compare telegrams
-                if ((rx_telegram[0] & ~SB_TEL_REPEAT_FLAG) == (telegram[0] & ~SB_TEL_REPEAT_FLAG))
-                {// same header -> compare remaining bytes, excluding the checksum byte
-                    int i;
-                    for (i = 1; (i < nextByteIndex - 1) && (rx_telegram[i] == telegram[i]); i++);
-                    if (i == nextByteIndex - 1) {
-                        already_received = true;
-                    }
-                }
-            }
-
-            // check for space in rx buffer for next telegram, if no space available, send nothing
-            if (telegramLen)
-            {
-                // KNX Spec. 2.1. 3/2/2 2.4.1 p.38
-                // Device should only send a LL_BUSY if it knows that the telegram can be processed within the next 100ms.
-                // Since we know nothing about the running application we better send nothing
-                sendAck = 0;
-                rx_error |= RX_BUFFER_BUSY;
-            }
-            else
-            {
-                sendAck = SB_BUS_ACK;
-                // store data in telegram buffer for higher layers, set telegramLen to indicate data available
-                if (!already_received)
-                {
-                    for (int i = 0; i < nextByteIndex; i++) telegram[i] = rx_telegram[i];
-                    telegramLen = nextByteIndex;
-                    rx_error = RX_OK;
-                }
-            }
-
-            // LL_ACK only allowed, if link layer is in normal mode, not busmonitor mode
-            auto suppressAck = !(bcu->userRam->status() & BCU_STATUS_LINK_LAYER);
-            // LL_ACK only allowed for L_Data frames
-            suppressAck |= rx_telegram[0] & SB_TEL_DATA_FRAME_FLAG;
-            if (suppressAck)
-            {
-                sendAck = 0;
-            }
-
-            if (sendAck)
-            {
-                // ACK has priority, no rx/tx in between
-                state = Bus::RECV_WAIT_FOR_ACK_TX_START;
-                time = SEND_ACK_WAIT_TIME - PRE_SEND_TIME;
-            }
+            // ACK has priority, no rx/tx in between
+            state = Bus::RECV_WAIT_FOR_ACK_TX_START;
+            time = SEND_ACK_WAIT_TIME - PRE_SEND_TIME;
         }
     }
     else if (nextByteIndex == 1 && wait_for_ack_from_remote) // Received a spike or a bus acknowledgment, only parity, no checksum
@@ -518,6 +501,7 @@ void Bus::handleTelegram(bool valid)
 #ifdef BUSMONITOR
     rx_error = RX_OK;
 #endif
+    rxDestination = RX_DESTINATION_UNKNOWN;
 
     //we received a telegram, next action wait to send ack back or wait 50 bit times for next rx/tx (todo check for improved noise margin with cap event disabled)
     //timer.captureMode(captureChannel, FALLING_EDGE); // no capture during wait- improves bus noise margin l
@@ -525,6 +509,166 @@ void Bus::handleTelegram(bool valid)
     timer.match(timeChannel, time - 1); // todo adjust time value by processing timer since we had the end of telegram detection
 }
 
+int Bus::acceptTelegram()
+{
+    byte controlByte = rx_telegram[0]; // rx_telegram is swapped with telegram below
+
+    // Only process the telegram if it is for us. This is usually decided already while receiving
+    // the rest of the telegram, so the time until the ACK does not depend on the size of the address table.
+    if (rxDestination == RX_DESTINATION_UNKNOWN)
+    {
+        checkDestination();
+    }
+    bool processTel = (rxDestination == RX_DESTINATION_OURS);
+
+    DB_TELEGRAM(telRXNotProcessed = !processTel);
+
+    if (!processTel)
+    {
+        return 0;
+    }
+
+    int ack;
+
+    // check for repeated telegram, did we already received it
+    // check the repeat bit in header and compare with the recently handed over telegrams
+    bool already_received = !(controlByte & SB_TEL_REPEAT_FLAG) && isRepeatedTelegram();
+
+    if (already_received)
+    {
+        // we have it already, acknowledge it again so the sender stops repeating
+        ack = SB_BUS_ACK;
+    }
+    // check for space in rx buffer for next telegram, if no space available, send nothing
+    else if (telegramLen)
+    {
+        // KNX Spec. 2.1. 3/2/2 2.4.1 p.38
+        // Device should only send a LL_BUSY if it knows that the telegram can be processed within the next 100ms.
+        // Since we know nothing about the running application we better send nothing
+        ack = 0;
+        rx_error |= RX_BUFFER_BUSY;
+    }
+    else
+    {
+        ack = SB_BUS_ACK;
+        // hand the rx buffer over to the higher layers without copying, set telegramLen to indicate data available.
+        // The previous telegram buffer receives the next telegram.
+        rememberTelegram();
+        byte* received = rx_telegram;
+        rx_telegram = telegram;
+        telegram = received;
+        telegramLen = nextByteIndex;
+        rx_error = RX_OK;
+    }
+
+    if (!acknowledgeAllowed(controlByte))
+    {
+        ack = 0;
+    }
+    return ack;
+}
+
+bool Bus::acknowledgeAllowed(byte controlByte) const
+{
+    // LL_ACK only allowed, if link layer is in normal mode, not busmonitor mode
+    if (!(bcu->userRam->status() & BCU_STATUS_LINK_LAYER))
+    {
+        return false;
+    }
+    // LL_ACK only allowed for L_Data frames
+    return !(controlByte & SB_TEL_DATA_FRAME_FLAG);
+}
+
+void Bus::handleTransceiverTelegram(bool valid)
+{
+    if (!valid)
+    {
+        rx_error |= RX_CHECKSUM_ERROR;
+    }
+
+    if (monitor)
+    {
+        monitor->capture(rx_telegram, nextByteIndex, valid ? BUS_MONITOR_VALID : 0, rx_error);
+    }
+
+#ifndef BUSMONITOR
+    if (nextByteIndex >= 8 && valid && ((rx_telegram[0] & VALID_DATA_FRAME_TYPE_MASK) == VALID_DATA_FRAME_TYPE_VALUE)
+        && nextByteIndex <= MAX_TELEGRAM_SIZE)
+    {
+        acceptTelegram();
+    }
+    else
+    {
+        rx_error |= RX_INVALID_TELEGRAM_ERROR;
+    }
+#endif
+
+    rxDestination = RX_DESTINATION_UNKNOWN;
+    nextByteIndex = 0;
+}
+
+/*
+ * Decide from the header in rx_telegram whether the telegram is for us.
+ *
+ * Called while receiving, as soon as the destination address is received, so the ACK does not wait for it.
+ */
+void Bus::checkDestination()
+{
+    int destAddr = (rx_telegram[3] << 8) | rx_telegram[4];
+    bool forUs = false;
+
+    if (rx_telegram[5] & 0x80) // group address or physical address
+    {
+        forUs = (destAddr == 0); // broadcast
+        forUs |= (bcu->indexOfGroupAddress(destAddr) >= 0); // known group address
+    }
+    else if (destAddr == bcu->ownAddress())
+    {
+        forUs = true;
+    }
+
+    // with disabled TL we also process the telegram, so the application (e.g. ft12, knx-if) can handle it completely by itself
+    forUs |= !(bcu->userRam->status() & BCU_STATUS_TRANSPORT_LAYER);
+
+    rxDestination = forUs ? RX_DESTINATION_OURS : RX_DESTINATION_OTHER;
+}
+
+void Bus::rxSignature(RxSignature& signature) const
+{
+    // The repeat flag is part of the checksum, so the checksum is normalized to the repeat flag being cleared
+    byte controlByte = rx_telegram[0];
+    byte checksum = rx_telegram[nextByteIndex - 1] ^ (controlByte & SB_TEL_REPEAT_FLAG);
+
+    signature.addresses = ((unsigned int) rx_telegram[1] << 24) | (rx_telegram[2] << 16) | (rx_telegram[3] << 8) | rx_telegram[4];
+    signature.header = ((controlByte | SB_TEL_REPEAT_FLAG) << 16) | (rx_telegram[5] << 8) | checksum;
+}
+
+bool Bus::isRepeatedTelegram(bool checksumReceived) const
+{
+    RxSignature signature;
+    rxSignature(signature);
+    unsigned int now = millis();
+    unsigned int headerMask = checksumReceived ? 0xffffffff : 0xffffff00;
+
+    for (int i = 0; i < RX_HISTORY_SIZE; ++i)
+    {
+        const RxSignature& entry = rxHistory[i];
+        if (((entry.header ^ signature.header) & headerMask) == 0 && entry.addresses == signature.addresses &&
+            now - entry.time < RX_HISTORY_TIMEOUT)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Bus::rememberTelegram()
+{
+    rxSignature(rxHistory[rxHistoryNext]);
+    rxHistory[rxHistoryNext].time = millis();
+    rxHistoryNext = (rxHistoryNext + 1) % RX_HISTORY_SIZE;
+}
+
 /*
  * Finish the telegram sending process.
  *
@@ -534,8 +678,13 @@ void Bus::finishSendingTelegram()
 {
     if (sendCurTelegram != nullptr)
     {
+        byte* sentTelegram = sendCurTelegram;
+        bool successful = !(tx_error & TX_RETRY_ERROR);
+
         sendCurTelegram = nullptr;
-        bcu->finishedSendingTelegram(!(tx_error & TX_RETRY_ERROR));
+        bcu->finishedSendingTelegram(successful);
+        if (sendCallback)
+            sendCallback->telegramSent(sentTelegram, successful);
     }
 
     prepareForSending();
@@ -563,6 +712,7 @@ void Bus::encounteredCollision()
  */
 __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
 {
+    PROFILE_SCOPE(PROFILE_BUS_TIMER_ISR);
     bool timeout;
     int time;
     unsigned int dt, tv, cv;
@@ -661,6 +811,7 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
         );
 
         nextByteIndex = 0;
+        rxDestination = RX_DESTINATION_UNKNOWN;
         rx_error  = RX_OK;
         checksum = 0xff;
         sendAck = 0;
@@ -695,7 +846,7 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
             }
             DB_TELEGRAM(telRXEndTime = telRXTelByteEndTime);
 #           ifdef PIO_FOR_TEL_END_IND
-                digitalWrite(PIO_FOR_TEL_END_IND, 1); // set handleTelegram() PIO
+                Pin<PIO_FOR_TEL_END_IND>::set(); // set handleTelegram() PIO
 #           endif
             handleTelegram(valid && !checksum);
             break;
@@ -784,10 +935,17 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
             if ( (!nextByteIndex) && (currentByte & PREAMBLE_MASK) )
                 rx_error |= RX_PREAMBLE_ERROR;// preamble error, continue to read bytes - possibility to discard the telegram at higher layer
 
-            if (nextByteIndex < bcu->maxTelegramSize())
+            if (nextByteIndex < MAX_TELEGRAM_SIZE)
             {
                 rx_telegram[nextByteIndex++] = currentByte;
                 checksum ^= currentByte;
+#ifndef BUSMONITOR
+                // the destination is complete, decide now if the telegram is for us while the rest is still on the bus
+                if (nextByteIndex == 6)
+                {
+                    checkDestination();
+                }
+#endif
             }
             else
             {
@@ -844,6 +1002,7 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
         timer.matchMode(timeChannel, RESET | INTERRUPT); //reset timer after bit pulse end
         timer.captureMode(captureChannel, FALLING_EDGE | INTERRUPT );
         nextByteIndex = 0;
+        rxDestination = RX_DESTINATION_UNKNOWN;
         tx_error = TX_OK;
         state = Bus::SEND_START_BIT;
 
@@ -942,6 +1101,7 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
         timer.match(timeChannel, time + (BIT_PULSE_TIME - 1)); // end of bit pulse 35us later
         timer.matchMode(timeChannel, RESET | INTERRUPT); //reset timer after bit pulse end
         nextByteIndex = 0;
+        rxDestination = RX_DESTINATION_UNKNOWN;
         tx_error = TX_OK;
         state = Bus::SEND_START_BIT;
 
@@ -1011,7 +1171,7 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
             state = Bus::SEND_BIT_0; // start bit edge in time, prepare to send bit 0 when timer times out (rising edge)
 #       ifdef PIO_FOR_TEL_END_IND
             if (sendAck)
-                digitalWrite(PIO_FOR_TEL_END_IND, 0);
+                Pin<PIO_FOR_TEL_END_IND>::clear();
 #       endif
             break;
         }
@@ -1141,6 +1301,12 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
                         rx_telegram[i] = b;
                         checksum ^= b;
                     }
+#ifndef BUSMONITOR
+                    if (nextByteIndex >= 6)
+                    {
+                        checkDestination();
+                    }
+#endif
                 }
 
                 // Scale back bitMask to match the collided bit. pwmChannel is when we would have sent
@@ -1349,6 +1515,11 @@ __attribute__((optimize("Os"))) void Bus::timerInterruptHandler()
 
 void Bus::loop()
 {
+    if (transceiver)
+    {
+        transceiver->loop();
+    }
+
     ///\todo implement enabled property
     /*
     if (!enabled)
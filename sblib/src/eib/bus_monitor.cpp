@@ -0,0 +1,96 @@
+/*
+ *  bus_monitor.cpp - Capture of all bus frames for a binary bus monitor stream
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/eib/bus_monitor.h>
+
+#include <sblib/bits.h>
+#include <sblib/buffered_stream.h>
+#include <sblib/interrupt.h>
+#include <sblib/timer.h>
+
+// Mask for the indexes of the ring buffer
+#define BUFFER_MASK (BUS_MONITOR_BUFFER_SIZE - 1)
+
+
+BusMonitor::BusMonitor()
+{
+    head = 0;
+    tail = 0;
+    lostCount = 0;
+    lostRecords = false;
+}
+
+void BusMonitor::clear()
+{
+    noInterrupts();
+    head = 0;
+    tail = 0;
+    lostCount = 0;
+    lostRecords = false;
+    interrupts();
+}
+
+void BusMonitor::capture(const byte* frame, int length, int flags, unsigned short errors)
+{
+    unsigned int pos = head;
+    unsigned int space = (tail - pos - 1) & BUFFER_MASK;
+
+    if (length > 255 || (unsigned int) (BUS_MONITOR_HEADER_SIZE + length) > space)
+    {
+        ++lostCount;
+        lostRecords = true;
+        return;
+    }
+
+    if (lostRecords)
+    {
+        flags |= BUS_MONITOR_LOST;
+        lostRecords = false;
+    }
+
+    unsigned int now = micros();
+    byte header[BUS_MONITOR_HEADER_SIZE] = {
+        BUS_MONITOR_SYNC, (byte) length, (byte) flags,
+        (byte) lowByte(errors), (byte) highByte(errors),
+        (byte) now, (byte) (now >> 8), (byte) (now >> 16), (byte) (now >> 24)
+    };
+
+    for (int i = 0; i < BUS_MONITOR_HEADER_SIZE; ++i)
+    {
+        buffer[pos] = header[i];
+        pos = (pos + 1) & BUFFER_MASK;
+    }
+
+    for (int i = 0; i < length; ++i)
+    {
+        buffer[pos] = frame[i];
+        pos = (pos + 1) & BUFFER_MASK;
+    }
+
+    head = pos;
+}
+
+int BusMonitor::stream(BufferedStream& out)
+{
+    int count = available();
+    int space = out.availableForWrite();
+    if (count > space)
+        count = space;
+
+    unsigned int pos = tail;
+    int written;
+    for (written = 0; written < count; ++written)
+    {
+        if (!out.write(buffer[pos]))
+            break;
+        pos = (pos + 1) & BUFFER_MASK;
+    }
+
+    tail = pos;
+    return written;
+}
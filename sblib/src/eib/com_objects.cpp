@@ -181,34 +181,17 @@
 #include <sblib/eib/com_objects.h>
 
 #include <sblib/eib/addr_tables.h>
-#include <sblib/eib/knx_lpdu.h>
-#include <sblib/eib/apci.h>
 #include <sblib/eib/property_types.h>
 #include <sblib/eib/bcu_base.h>
 #include <sblib/eib/bus.h>
 
-#if defined(DUMP_COM_OBJ)
-#   include <sblib/serial.h>
-#endif
-
-#ifdef DUMP_COM_OBJ
-#   define d(x) x
-#else
-#   define d(x)
-#endif
-
-/** The COMFLAG_UPDATE flag, moved to the high nibble */
-#define COMFLAG_UPDATE_HIGH (COMFLAG_UPDATE << 4)
-
-/** The COMFLAG_TRANS_MASK mask, moved to the high nibble */
-#define COMFLAG_TRANS_MASK_HIGH (COMFLAG_TRANS_MASK << 4)
-
 ComObjects::ComObjects(BcuBase* bcuInstance) :
     bcu(bcuInstance),
     le_ptr(BIG_ENDIAN),
     transmitting_object_no(INVALID_OBJECT_NUMBER),
     sendNextObjIndex(0),
-    nextUpdatedObjIndex(0)
+    nextUpdatedObjIndex(0),
+    transmissionPending(true)
 {
 }
 
@@ -218,33 +201,12 @@ ComObjects::~ComObjects()
 
 int ComObjects::telegramObjectSize(int objno)
 {
-    int type = objectType(objno);
-    if (type < BIT_7) return 0;
-    return objectSize(objno);
+    return telegramObjectSize(*this, objno);
 }
 
 void ComObjects::addObjectFlags(int objno, int flags)
 {
-    byte* flagsTab = objectFlagsTable();
-    if(flagsTab == 0)
-    	return;
-
-
-    if (objno & 1)
-        flags <<= 4;
-
-    d(serial.print(" addObjFlags in (obj, flags): ");)
-  	d(serial.print(objno, DEC, 2);)
-    d(serial.print(", ");)
-  	d(serial.print(flags, HEX, 2);)
-  	d(serial.print(", is: ");)
-  	d(serial.print(flagsTab[objno >> 1], HEX, 2);)
-
-    flagsTab[objno >> 1] |= flags;
-
-    d(serial.print(", out: ");)
-	d(serial.print(flagsTab[objno >> 1], HEX, 2);)
-	d(serial.println();)
+    addObjectFlags(*this, objno, flags);
 }
 
 void ComObjects::setObjectFlags(int objno, int flags)
@@ -256,7 +218,12 @@ void ComObjects::setObjectFlags(int objno, int flags)
     }
     flagsPtr += objno >> 1; // "select" high or low nibble according to objno odd or even
 
-    d(
+    if ((flags & COMFLAG_TRANSREQ) == COMFLAG_TRANSREQ)
+    {
+        transmissionPending = true;
+    }
+
+    DB_COM_OBJ(
       serial.print(" setObjFlags obj: ", objno, DEC, 2);
       serial.print(" is: ", *flagsPtr, HEX, 2);
 	  serial.print(" to: ", flags, HEX, 2);
@@ -272,7 +239,7 @@ void ComObjects::setObjectFlags(int objno, int flags)
         *flagsPtr &= 0xf0;
         *flagsPtr |= flags;
     }
-	d(serial.println(" out: ", *flagsPtr, HEX, 2);)
+	DB_COM_OBJ(serial.println(" out: ", *flagsPtr, HEX, 2);)
 }
 
 unsigned int ComObjects::objectRead(int objno)
@@ -330,26 +297,7 @@ inline int ComObjects::objectCount()
 
 int ComObjects::firstObjectAddr(int objno)
 {
-    byte* assocTab = bcu->addrTables->assocTable();
-    byte* assocTabEnd = assocTab + (*assocTab << 1);
-
-    for (++assocTab; assocTab < assocTabEnd; assocTab += 2)
-    {
-        if (assocTab[1] != objno)
-        {
-            continue;
-        }
-        uint16_t addressTablePos = (assocTab[0]) + 1; // +1 because first address in addressTable is our own address
-
-        if (addressTablePos > bcu->addrTables->addrCount())
-        {
-            continue;
-        }
-
-        byte* addr = bcu->addrTables->addrTable() + 1 + (assocTab[0] << 1);
-        return ((addr[0] << 8) | addr[1]);
-    }
-    return (0);
+    return firstObjectAddr(*bcu->addrTables, objno);
 }
 
 void ComObjects::sendGroupReadTelegram(int objno, int addr)
@@ -367,198 +315,21 @@ void ComObjects::sendGroupReadTelegram(int objno, int addr)
 
 void ComObjects::sendGroupWriteTelegram(int objno, int addr, bool isResponse)
 {
-    byte* valuePtr = objectValuePtr(objno);
-    int objSize = telegramObjectSize(objno);
-    byte addData = 0;
-    ApciCommand cmd;
-
-    auto sendBuffer = bcu->acquireSendBuffer();
-    ///\todo Set routing count and priority according to the parameters set from ETS in the EEPROM, add ID/objno for result association from bus-layer
-    initLpdu(sendBuffer, PRIORITY_LOW, false, FRAME_STANDARD);
-    setDestinationAddress(sendBuffer, addr);
-    sendBuffer[5] = 0xe0 | ((objSize + 1) & 0x0f);
-
-    isResponse ? cmd = APCI_GROUP_VALUE_RESPONSE_PDU : cmd = APCI_GROUP_VALUE_WRITE_PDU;
-
-    if (objSize)
-        reverseCopy(sendBuffer + 8, valuePtr, objSize);
-    else
-        addData = *valuePtr;
-
-    setApciCommand(sendBuffer, cmd, addData);
-
-    // Process this telegram in the receive queue (if there is a local receiver of this group address)
-    processGroupTelegram(addr, APCI_GROUP_VALUE_WRITE_PDU, sendBuffer, objno);
-
-    bcu->sendPreparedTelegram();
-    transmitting_object_no = objno; //save transmitting object for status check
+    sendGroupWriteTelegram(*this, *bcu->addrTables, objno, addr, isResponse);
 }
 
 bool ComObjects::sendNextGroupTelegram()
 {
-    byte* flagsTab = objectFlagsTable();
-    if(flagsTab == nullptr)
-    {
-        return (false);
-    }
-
-    uint16_t addr;
-    uint8_t flags;
-    uint16_t config;
-    uint16_t numObjs = objectCount();
-    if (numObjs == 0)
-    {
-        return (false);
-    }
-    sendNextObjIndex %= numObjs;
-
-	//const ComConfig* configTab = &objectConfig(0);
-///\todo BUG This commented out section can lead to LL_BUSY responses of the Bus and it wont recover from that state
-/*
-    // pending transmission status check, switch off interrupts to avoid reading/storing changing data
-    noInterrupts();
-	if ( !(transmitting_object_no == INVALID_OBJECT_NUMBER) && bcu->bus->getBusTXStateValid() )
-	{
-		//check if state ok and update RAM Flag of object
-		if ( !bcu->bus->sendTelegramState())
-		{
-			// set RAM Status flag to ok : clear COMFLAG_TRANS_MASK	and possible DATAREQ
-         	unsigned int mask = (COMFLAG_TRANS_MASK |COMFLAG_DATAREQ )  << (transmitting_object_no & 1 ? 4 :  0);
-            flagsTab[transmitting_object_no >> 1] &= ~mask;
-		}
-		else
-		{
-            //set status to error, clear COMFLAG_TRANS_MASK and set COMFLAG_ERROR
-            unsigned int mask = (COMFLAG_TRANS_MASK |COMFLAG_DATAREQ)  << (transmitting_object_no & 1 ? 4 :  0);
-            flagsTab[transmitting_object_no >> 1] &= ~mask;
-            mask = (COMFLAG_ERROR) << (transmitting_object_no & 1 ? 4 :  0);
-            flagsTab[transmitting_object_no >> 1] |= mask;
-		}
-
-		// clear pending status check
-		transmitting_object_no = INVALID_OBJECT_NUMBER;
-		bcu->bus->setBusTXStateValid(false);
-	}
-	interrupts();
-*/
-///\todo BUG END
-    // scan all objects, read config and group address of object
-    for (uint16_t objno = sendNextObjIndex; objno < numObjs; ++objno)
-    {
-/*        uint8_t* h = (objectConfigTable() + 3); // 1 tablesize 2 RAM-Flags-Table Pointer
-        h = h + objno * 4;
-        serial.print("obj ", objno, DEC); serial.print(" ");serial.print(((ComConfigBCU2*)h)->DataPtrType[0]));
-        d(
-
-        );
-        return (const ComConfigBCU2*) (objectConfigTable() + 1 + sizeof(ComConfigBCU2::DataPtrType) + objno * sizeof(ComConfigBCU2) );
-
-        Data Pointer // low mem
-        Config Octet
-        Type Octet  // high mem
-*/
-        const ComConfig& configTab = objectConfig(objno);
-        config = configTab.config;
-        addr = firstObjectAddr(objno);
-
-        // check if <transmit enable> and <communication enable> is set in the config for the resp. object.
-        if ((addr == 0) || !(config & COMCONF_COMM)|| !(config & COMCONF_TRANS))
-        {
-             continue;  // no communication allowed or no grp-adr associated, next obj.
-        }
-
-        // check ram-flags for read or write request
-    	flags = flagsTab[objno >> 1];
-        if (objno & 1)
-        {
-            flags >>= 4;
-        }
-
-        if ((flags & COMFLAG_TRANSREQ) == COMFLAG_TRANSREQ)
-        {
-            //app is triggering a object read or write request on the bus
-            if (flags & COMFLAG_DATAREQ)
-            	// app triggered a read request on the bus - no further search for local objects belonging to the same group,
-            	// they will be updated by the response to the read request
-                sendGroupReadTelegram(objno, addr);
-            else
-            	// app triggered a write request on the bus  and check for additional associations to Grp Addr for local writes
-            	sendGroupWriteTelegram(objno, addr, false);
-
-            // we set the status to TRANSMITING (0x02), clear DATAREQ flag
-          	unsigned int mask = (COMFLAG_TRANS_MASK | COMFLAG_DATAREQ)  << (objno & 1 ? 4 :  0);
-            flagsTab[objno >> 1] &= ~mask;
-            mask = (COMFLAG_ERROR) << (objno & 1 ? 4 :  0);
-            flagsTab[objno >> 1] |= mask;
-
-
-            sendNextObjIndex = objno + 1;
-            return true;
-        }
-    }
-
-    sendNextObjIndex++; // nothing found to send, lets prepare for next round
-    return false;
+    return sendNextGroupTelegram(*this, *bcu->addrTables);
 }
 
 int ComObjects::nextUpdatedObject()
 {
-    byte* flagsTab = objectFlagsTable();
-    if(flagsTab == nullptr)
-    {
-    	return (INVALID_OBJECT_NUMBER);
-    }
-
-    uint8_t flags;
-    uint16_t numObjs = objectCount();
-
-    if (numObjs == 0)
-    {
-        return (INVALID_OBJECT_NUMBER);
-    }
-    nextUpdatedObjIndex = 0; ///\todo this is old behavior
-    //nextUpdatedObjIndex %= numObjs; ///\todo this should be a less resource intense alternative, even more could be here optimized
-
-    for (uint16_t objno = nextUpdatedObjIndex; objno < numObjs; ++objno)
-    {
-        flags = flagsTab[objno >> 1]; // gets the same byte twice
-
-        if (objno & 1) flags &= COMFLAG_UPDATE_HIGH; // check high or low nibble
-        else flags &= COMFLAG_UPDATE;
-
-        // d(serial.print(" obj: ", objno, DEC); serial.println(", fi: ", flags, HEX, 2);)
-
-        if (flags)
-        {
-            // fi = flags in, fo = flags out
-            d(serial.print(" flags set obj: ", objno, DEC); serial.print(", fi: ", flags, HEX, 2); serial.print("; ");)
-
-        	flagsTab[objno >> 1] &= ~flags;
-            nextUpdatedObjIndex = objno + 1;
-
-            d(serial.println(" fo: ", flagsTab[objno >> 1], HEX, 2);)
-			return objno;
-        }
-    }
-    nextUpdatedObjIndex++; // nothing found to send, lets prepare for next round
-    return INVALID_OBJECT_NUMBER;
+    return nextUpdatedObject(*this);
 }
 
 void ComObjects::processGroupWriteTelegram(int objno, byte* tel)
 {
-    byte* valuePtr = objectValuePtr(objno);
-
-    if (valuePtr == nullptr)
-    {
-        IF_DEBUG(fatalError(););
-        return;
-    }
-
-    int count = telegramObjectSize(objno);
-
-    if (count > 0) reverseCopy(valuePtr, tel + 8, count);
-    else *valuePtr = tel[7] & 0x3f;
-
-    addObjectFlags(objno, COMFLAG_UPDATE);
+    processGroupWriteTelegram(*this, objno, tel);
 }
 
@@ -16,37 +16,12 @@
 
 int ComObjectsBCU1::objectSize(int objno)
 {
-    // The size of the object types BIT_7...VARDATA in bytes
-    const byte objectTypeSizes[10] = { 1, 1, 2, 3, 4, 6, 8, 10, 14, 14 };
-
-    int type = objectType(objno);
-    if (type < BIT_7)
-        return 1;
-    if (type <= VARDATA)
-        return objectTypeSizes[type - BIT_7];
-    return -1;
+    return objectSize(*this, objno);
 }
 
 byte* ComObjectsBCU1::objectValuePtr(int objno)
 {
-    // The object configuration
-    const ComConfigBCU1* cfg = objectConfigBCU1(objno);
-    if (cfg == nullptr)
-    {
-        return (nullptr);
-    }
-    uint16_t addrObjValue = cfg->dataPtr;
-    uint8_t* objValuePtr;
-    if (cfg->baseConfig.config & COMCONF_VALUE_TYPE) // 0 in user RAM, >0 in user EEPROM
-    {
-        addrObjValue += ((BcuDefault*)bcu)->userEeprom->startAddr();
-        objValuePtr = ((BcuDefault*)bcu)->userMemoryPtr(addrObjValue);
-    }
-    else
-    {
-        objValuePtr = ((BcuDefault*)bcu)->userMemoryPtr(addrObjValue);
-    }
-    return (objValuePtr);
+    return objectValuePtr(*this, objno);
 }
 
 /*
@@ -67,70 +42,7 @@ byte* ComObjectsBCU1::objectValuePtr(int objno)
  */
 void ComObjectsBCU1::processGroupTelegram(uint16_t addr, int apci, byte* tel, int trg_objno)
 {
-/**
- * Spec: Resources 4.11.2 Group Object Association Table - Realization Type 1
- */
-    const byte* assocTab = bcu->addrTables->assocTable();
-    const int endAssoc = 1 + (*assocTab) * 2;
-    int objno, objConf;
-
-    DB_COM_OBJ(
-            serial.print("grpAddr ", mainGroup(addr));
-            serial.print("/", middleGroup(addr));
-            serial.print("/", lowGroup(addr));
-            serial.print(": gapos ");
-            );
-    // Convert the group address into the index of the group address table
-    const int gapos = bcu->addrTables->indexOfAddr(addr);
-    if (gapos < 0)
-    {
-        DB_COM_OBJ(serial.println("not found"););
-        return;
-    }
-    else
-    {
-        DB_COM_OBJ(serial.println(gapos););
-    }
-
-    // Loop over all entries in the association table, as one group address
-    // could be assigned to multiple com-objects.
-    for (int idx = 1; idx < endAssoc; idx += 2)
-    {
-        // Check if grp-address index in assoc table matches the dest grp address index
-        if (gapos != assocTab[idx])
-        {
-            continue;
-        }
-        // We found an association for our addr
-        objno = assocTab[idx + 1];  // Get the com-object number from the assoc table
-        DB_COM_OBJ(serial.println("objno  : ", objno););
-
-        if (objno == trg_objno)
-        {
-            DB_COM_OBJ(serial.println("triggered by app ", objno););
-            continue; // no update of the object triggered by the app
-        }
-
-        //DB_COM_OBJ(serial.println("commsTabAddr: 0x", ((UserEepromBCU1*)((BcuDefault*)bcu)->userEeprom)->commsTabAddr(), HEX););
-        objConf = objectConfig(objno).config;
-        DB_COM_OBJ(serial.println("objConf: 0x", objno, HEX, 2););
-
-
-
-        if (apci == APCI_GROUP_VALUE_WRITE_PDU || apci == APCI_GROUP_VALUE_RESPONSE_PDU)
-        {
-            // Check if communication and write are enabled
-            if ((objConf & COMCONF_WRITE_COMM) == COMCONF_WRITE_COMM)
-                processGroupWriteTelegram(objno, tel); // set update flag and update value of object
-        }
-        else if (apci == APCI_GROUP_VALUE_READ_PDU)
-        {
-            // Check if communication and read are enabled
-            if ((objConf & COMCONF_READ_COMM) == COMCONF_READ_COMM)
-                // we received read-request from bus - so send response back and search for more associations
-                sendGroupWriteTelegram(objno, addr, true); // send write to the bus and update all associated local objects
-        }
-    }
+    processGroupTelegram(*this, *bcu->addrTables, addr, apci, tel, trg_objno);
 }
 
 byte* ComObjectsBCU1::objectConfigTable() // stored in eeprom
@@ -156,14 +68,9 @@ byte* ComObjectsBCU1::objectFlagsTable() // stored in RAM
     return ((BcuDefault*)bcu)->userMemoryPtr(*objCfgTablePtr);
 }
 
-inline const ComConfig& ComObjectsBCU1::objectConfig(int objno) { return objectConfigBCU1(objno)->baseConfig; }
+inline const ComConfig& ComObjectsBCU1::objectConfig(int objno) { return objectConfig(*this, objno); }
 
 inline const ComConfigBCU1* ComObjectsBCU1::objectConfigBCU1(int objno)
 {
-	byte *objConfigTable = objectConfigTable();
-	if (objConfigTable == nullptr)
-	{
-	    return (nullptr);
-	}
-    return (const ComConfigBCU1*) (objConfigTable + 1 + sizeof(ComConfigBCU1::DataPtrType) + objno * sizeof(ComConfigBCU1) );
+    return objectConfigBCU1(*this, objno);
 }
@@ -11,16 +11,7 @@
 
 byte* ComObjectsBCU2::objectValuePtr(int objno)
 {
-    // The object configuration
-    const ComConfigBCU2* cfg = objectConfigBCU2(objno);
-
-    // TODO Should handle userRam.segment0addr and userRam.segment1addr here
-    // if (cfg.config & COMCONF_VALUE_TYPE) // 0 if segment 0, !=0 if segment 1
-    const byte * addr = (const byte *) &cfg->dataPtr;
-    if (le_ptr == LITTLE_ENDIAN)
-        return ((BcuDefault*)bcu)->userMemoryPtr(makeWord(addr[1], addr[0]));
-    else
-        return ((BcuDefault*)bcu)->userMemoryPtr(makeWord(addr[0], addr[1]));
+    return objectValuePtr(*this, objno);
 }
 
 byte* ComObjectsBCU2::objectConfigTable()
@@ -48,16 +39,10 @@ byte* ComObjectsBCU2::objectFlagsTable()
 
 const ComConfigBCU2* ComObjectsBCU2::objectConfigBCU2(int objno)
 {
-    const byte* configTable = objectConfigTable();
-    if (configTable == nullptr)
-    {
-        return (nullptr);
-    }
-    uint16_t offSet = 1 + sizeof(ComConfigBCU2::DataPtrType) + objno * sizeof(ComConfigBCU2);
-    return (const ComConfigBCU2*) (configTable + offSet);
+    return objectConfigBCU2(*this, objno);
 }
 
 const ComConfig& ComObjectsBCU2::objectConfig(int objno)
 {
-    return objectConfigBCU2(objno)->baseConfig;
+    return objectConfig(*this, objno);
 }
@@ -13,26 +13,12 @@
 
 int ComObjectsSYSTEMB::objectSize(int objno)
 {
-    // KNX spec v2.1 3/5/1 p. 178 (section 4.12.5.2.4.1.4)
-    // The size of the object types 6...20 in bytes
-    const byte objectTypeSizes[15] = { 1, 1, 2, 3, 4, 6, 8, 10, 14, 5, 7, 9, 11, 12, 13 };
-
-    int type = objectType(objno);
-    if (type < BIT_7)
-        return 1;
-    if (type < 21)
-        return objectTypeSizes[type - BIT_7];
-    if (type < 255)
-        return (type -6);
-    return 252;
+    return objectSize(*this, objno);
 }
 
 byte* ComObjectsSYSTEMB::objectValuePtr(int objno)
 {
-    int ramAddr = bcu->userRam->startAddr() + 2;
-    for (int i = 1; i < objno; i++)
-        ramAddr += objectSize(i);
-    return ((BcuDefault*)bcu)->userMemoryPtr(ramAddr);
+    return objectValuePtr(*this, objno);
 }
 
 /*
@@ -53,47 +39,8 @@ byte* ComObjectsSYSTEMB::objectValuePtr(int objno)
  */
 void ComObjectsSYSTEMB::processGroupTelegram(uint16_t addr, int apci, byte* tel, int trg_objno)
 {
-    //
-    // Spec: Resources 4.11.4 Group Object Association Table - Realization Type 6
-    //
-    const ComConfig* configTab = &objectConfig(0);
-    const byte* assocTab = bcu->addrTables->assocTable();
-    const int endAssoc = 2 +  makeWord(assocTab[0], assocTab[1]) * 4;   // length field has 2 octets and each entry has 4 octets on SYSTEM B
-    int objno, objConf;
-
-    // Convert the group address into the index into the group address table
-    const int gapos = bcu->addrTables->indexOfAddr(addr);
-    if (gapos < 0) return;
-
-    // Loop over all entries in the association table, as one group address
-    // could be assigned to multiple com-objects.
-    for (int idx = 2; idx < endAssoc; idx += 4)
-    {
-        // Check if grp-address index in assoc table matches the dest grp address index
-        int gadest = makeWord(assocTab[idx], assocTab[idx +1]); // get destination group address index
-        if (gapos == gadest) // We found an association for our addr
-        {
-            objno = makeWord(assocTab[idx +2], assocTab[idx +3]);  // Get the com-object number from the assoc table
-            if (objno == trg_objno)
-             	continue; // no update of the object triggered by the app
-
-            objConf = configTab[objno].config;
-
-            if (apci == APCI_GROUP_VALUE_WRITE_PDU || apci == APCI_GROUP_VALUE_RESPONSE_PDU)
-            {
-                // Check if communication and write are enabled
-                if ((objConf & COMCONF_WRITE_COMM) == COMCONF_WRITE_COMM)
-                    processGroupWriteTelegram(objno, tel); // set update flag and update value of object
-            }
-            else if (apci == APCI_GROUP_VALUE_READ_PDU)
-            {
-                // Check if communication and read are enabled
-                if ((objConf & COMCONF_READ_COMM) == COMCONF_READ_COMM)
-                   	// we received read-request from bus - so send response back and search for more associations
-                    sendGroupWriteTelegram(objno, addr, true);
-            }
-        }
-    }
+    // The overrides are protected here, so the shared implementation calls them through ComObjects
+    processGroupTelegram(static_cast<ComObjects&>(*this), *bcu->addrTables, addr, apci, tel, trg_objno);
 }
 
 byte* ComObjectsSYSTEMB::objectConfigTable()
@@ -111,7 +58,7 @@ byte* ComObjectsSYSTEMB::objectFlagsTable()
     return ((BcuDefault*)bcu)->userMemoryPtr(makeWord(configTable[1], configTable[2]));
 }
 
-inline const ComConfig& ComObjectsSYSTEMB::objectConfig(int objno)
+const ComConfig& ComObjectsSYSTEMB::objectConfig(int objno)
 {
-    return (*(const ComConfigSYSTEMB*) (objectConfigTable() + 2 + (objno -1) * sizeof(ComConfigSYSTEMB) )).baseConfig;
+    return objectConfig(*this, objno);
 }
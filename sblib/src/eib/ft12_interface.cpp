@@ -0,0 +1,320 @@
+/*
+ *  ft12_interface.cpp - Serial KNX data link interface with FT1.2 framing
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/eib/ft12_interface.h>
+
+#include <sblib/buffered_stream.h>
+#include <sblib/eib/bcu_base.h>
+#include <sblib/eib/userRam.h>
+#include <sblib/timer.h>
+
+// FT1.2 frame bytes
+#define FT12_START_FIXED     0x10
+#define FT12_START_VARIABLE  0x68
+#define FT12_END             0x16
+#define FT12_ACK             0xe5
+
+// FT1.2 control field
+#define CF_DIR_TO_HOST       0x80  // direction bit, frame from the device to the host
+#define CF_PRM               0x40  // frame from the primary station
+#define CF_FCB               0x20  // frame count bit
+#define CF_FCV               0x10  // frame count bit is valid
+#define CF_FUNCTION_MASK     0x0f
+#define CF_FUNCTION_RESET    0x00
+#define CF_FUNCTION_DATA     0x03
+
+// Control field of the frames to the host, without the frame count bit
+#define CF_TO_HOST (CF_DIR_TO_HOST | CF_PRM | CF_FCV | CF_FUNCTION_DATA)
+
+// Size of a variable length frame without the telegram
+#define FRAME_OVERHEAD 8
+
+// Size of the telegram header: control byte, source, destination, address type + hop count + length
+#define TELEGRAM_HEADER_SIZE 6
+
+/** The states of receiving a frame from the host */
+enum Ft12RxState
+{
+    RX_IDLE,          //!< Waiting for the start of a frame
+    RX_FIXED_CF,      //!< Fixed length frame: waiting for the control field
+    RX_FIXED_CS,      //!< Fixed length frame: waiting for the checksum
+    RX_FIXED_END,     //!< Fixed length frame: waiting for the end byte
+    RX_LENGTH,        //!< Variable length frame: waiting for the length
+    RX_LENGTH_REPEAT, //!< Variable length frame: waiting for the repeated length
+    RX_START_REPEAT,  //!< Variable length frame: waiting for the repeated start byte
+    RX_DATA,          //!< Variable length frame: receiving control field and data
+    RX_CHECKSUM,      //!< Variable length frame: waiting for the checksum
+    RX_END            //!< Variable length frame: waiting for the end byte
+};
+
+
+Ft12Interface::Ft12Interface(BcuBase* bcu, BufferedStream& port)
+    : bcu(bcu)
+    , port(port)
+    , first(0)
+    , count(0)
+    , rxState(RX_IDLE)
+    , rxLength(0)
+    , rxPos(0)
+    , rxSum(0)
+    , hostFcb(false)
+    , sendFcb(true)
+    , rxTime(0)
+    , active(false)
+    , savedStatus(0)
+{
+    for (int i = 0; i < FT12_WINDOW_SIZE; ++i)
+        queue[i].state = SLOT_FREE;
+}
+
+void Ft12Interface::begin()
+{
+    end();
+
+    savedStatus = bcu->userRam->status();
+    if (savedStatus & BCU_STATUS_TRANSPORT_LAYER)
+    {
+        bcu->userRam->status() ^= BCU_STATUS_TRANSPORT_LAYER | BCU_STATUS_PARITY;
+    }
+
+    bcu->bus->setSendCallback(this);
+    active = true;
+}
+
+void Ft12Interface::end()
+{
+    bcu->bus->setSendCallback(nullptr);
+
+    if (active)
+    {
+        bcu->userRam->status() = savedStatus;
+        active = false;
+    }
+
+    for (int i = 0; i < FT12_WINDOW_SIZE; ++i)
+        queue[i].state = SLOT_FREE;
+    first = 0;
+    count = 0;
+    rxState = RX_IDLE;
+    hostFcb = false;
+    sendFcb = true;
+}
+
+int Ft12Interface::freeSlots() const
+{
+    return FT12_WINDOW_SIZE - count;
+}
+
+void Ft12Interface::loop()
+{
+    if (rxState != RX_IDLE && elapsed(rxTime) > FT12_RX_TIMEOUT)
+        rxState = RX_IDLE;
+
+    while (port.available())
+    {
+        rxTime = millis();
+        receivedByte(port.read());
+    }
+
+    // Confirm the sent telegrams, in the order they were requested
+    while (count && queue[first].state >= SLOT_SENT)
+    {
+        Slot& slot = queue[first];
+        if (!sendFrame(FT12_L_DATA_CON, slot.telegram, slot.length, slot.state == SLOT_FAILED ? 1 : 0))
+            break;
+
+        slot.state = SLOT_FREE;
+        first = (first + 1) % FT12_WINDOW_SIZE;
+        --count;
+    }
+
+    // Hand the next telegram to the bus when it is not sending
+    for (int i = 0; i < count; ++i)
+    {
+        Slot& slot = queue[(first + i) % FT12_WINDOW_SIZE];
+        if (slot.state == SLOT_SENDING)
+            break;
+
+        if (slot.state == SLOT_WAITING)
+        {
+            if (!bcu->bus->sendingFrame())
+            {
+                slot.state = SLOT_SENDING;
+                bcu->bus->sendTelegram(slot.telegram, slot.length);
+            }
+            break;
+        }
+    }
+
+    // Pass the received telegram to the host, without the checksum
+    if (bcu->bus->telegramReceived())
+    {
+        int length = bcu->bus->telegramLen - 1;
+        if (length <= 0 || sendFrame(FT12_L_DATA_IND, bcu->bus->telegram, length))
+            bcu->bus->discardReceivedTelegram();
+    }
+}
+
+void Ft12Interface::telegramSent(byte* telegram, bool successful)
+{
+    for (int i = 0; i < FT12_WINDOW_SIZE; ++i)
+    {
+        Slot& slot = queue[i];
+        if (slot.state == SLOT_SENDING && slot.telegram == telegram)
+        {
+            slot.state = successful ? SLOT_SENT : SLOT_FAILED;
+            break;
+        }
+    }
+}
+
+void Ft12Interface::receivedByte(byte ch)
+{
+    switch (rxState)
+    {
+    case RX_IDLE:
+        if (ch == FT12_START_FIXED)
+            rxState = RX_FIXED_CF;
+        else if (ch == FT12_START_VARIABLE)
+            rxState = RX_LENGTH;
+        break; // acknowledges and garbage are ignored
+
+    case RX_FIXED_CF:
+        frame[0] = ch;
+        rxState = RX_FIXED_CS;
+        break;
+
+    case RX_FIXED_CS:
+        rxState = (ch == frame[0]) ? RX_FIXED_END : RX_IDLE;
+        break;
+
+    case RX_FIXED_END:
+        rxState = RX_IDLE;
+        if (ch == FT12_END)
+            receivedFrame(1, true);
+        break;
+
+    case RX_LENGTH:
+        rxLength = ch;
+        rxState = (ch >= 1 && ch <= sizeof(frame)) ? RX_LENGTH_REPEAT : RX_IDLE;
+        break;
+
+    case RX_LENGTH_REPEAT:
+        rxState = (ch == rxLength) ? RX_START_REPEAT : RX_IDLE;
+        break;
+
+    case RX_START_REPEAT:
+        rxState = (ch == FT12_START_VARIABLE) ? RX_DATA : RX_IDLE;
+        rxPos = 0;
+        rxSum = 0;
+        break;
+
+    case RX_DATA:
+        frame[rxPos++] = ch;
+        rxSum += ch;
+        if (rxPos >= rxLength)
+            rxState = RX_CHECKSUM;
+        break;
+
+    case RX_CHECKSUM:
+        rxState = (ch == rxSum) ? RX_END : RX_IDLE;
+        break;
+
+    case RX_END:
+        rxState = RX_IDLE;
+        if (ch == FT12_END)
+            receivedFrame(rxLength, false);
+        break;
+
+    default:
+        rxState = RX_IDLE;
+        break;
+    }
+}
+
+void Ft12Interface::receivedFrame(int length, bool fixed)
+{
+    byte cf = frame[0];
+
+    if (cf & CF_DIR_TO_HOST)
+        return; // an echo of our own frames
+
+    if (fixed)
+    {
+        if ((cf & (CF_PRM | CF_FUNCTION_MASK)) == (CF_PRM | CF_FUNCTION_RESET))
+        {
+            hostFcb = false;
+            sendFcb = true;
+        }
+        port.write(FT12_ACK);
+        return;
+    }
+
+    if ((cf & (CF_PRM | CF_FUNCTION_MASK)) != (CF_PRM | CF_FUNCTION_DATA))
+        return;
+
+    bool fcb = (cf & CF_FCB) != 0;
+    bool repetition = (cf & CF_FCV) && fcb == hostFcb;
+
+    if (!repetition && length >= 2 && frame[1] == FT12_L_DATA_REQ)
+    {
+        if (!requestSend(frame + 2, length - 2))
+            return; // the window is full, the host will repeat the frame
+    }
+
+    hostFcb = fcb;
+    port.write(FT12_ACK);
+}
+
+bool Ft12Interface::requestSend(const byte* data, int length)
+{
+    if (count >= FT12_WINDOW_SIZE)
+        return false;
+
+    Slot& slot = queue[(first + count) % FT12_WINDOW_SIZE];
+
+    // The length must match the length field of the telegram, else it is confirmed negatively
+    bool valid = length > TELEGRAM_HEADER_SIZE && length == TELEGRAM_HEADER_SIZE + 1 + (data[5] & 0x0f);
+
+    if (length > FT12_MAX_TELEGRAM_SIZE - 1)
+        length = FT12_MAX_TELEGRAM_SIZE - 1;
+    for (int i = 0; i < length; ++i)
+        slot.telegram[i] = data[i];
+    slot.length = length;
+    slot.state = valid ? SLOT_WAITING : SLOT_FAILED;
+    ++count;
+    return true;
+}
+
+bool Ft12Interface::sendFrame(byte code, const byte* telegram, int length, byte ctrlBits)
+{
+    if (port.availableForWrite() < length + FRAME_OVERHEAD)
+        return false;
+
+    byte cf = CF_TO_HOST | (sendFcb ? CF_FCB : 0);
+    byte sum = cf + code;
+    sendFcb = !sendFcb;
+
+    port.write(FT12_START_VARIABLE);
+    port.write(length + 2);
+    port.write(length + 2);
+    port.write(FT12_START_VARIABLE);
+    port.write(cf);
+    port.write(code);
+    for (int i = 0; i < length; ++i)
+    {
+        byte ch = telegram[i];
+        if (!i)
+            ch |= ctrlBits;
+        port.write(ch);
+        sum += ch;
+    }
+    port.write(sum);
+    port.write(FT12_END);
+    return true;
+}
@@ -22,9 +22,11 @@
 #include <sblib/timeout.h>
 #include <sblib/timer.h>
 #include <sblib/eib/knx_tlayer4.h>
+#include <sblib/eib/bcu_base.h>
 #include <sblib/eib/knx_lpdu.h>
 #include <sblib/eib/knx_npdu.h>
 #include <sblib/libconfig.h>
+#include <sblib/profiler.h>
 #include <cstring>
 
 #if defined(INCLUDE_SERIAL)
@@ -229,12 +231,13 @@ void dumpLogHeader()
     );
 }
 
-TLayer4::TLayer4(uint8_t maxTelegramLength):
-    sendTelegram(new byte[maxTelegramLength]()),
-    sendConnectedTelegram(new byte[maxTelegramLength]()),
-    sendConnectedTelegram2(new byte[maxTelegramLength]())
+TLayer4::TLayer4():
+    sendTelegram(),
+    sendConnectedTelegram(),
+    sendConnectedTelegram2()
 {
-
+    static_assert(sizeof(sendTelegram) == BcuBase::maxTelegramSize() && sizeof(sendConnectedTelegram) == BcuBase::maxTelegramSize() &&
+                  sizeof(sendConnectedTelegram2) == BcuBase::maxTelegramSize(), "TLayer4: the send buffers must hold the largest telegram");
 }
 
 void TLayer4::_begin()
@@ -255,7 +258,8 @@ void TLayer4::_begin()
     connectedAddr = 0;
     seqNoSend = -1;
     seqNoRcv = -1;
-    connectedTime = 0;
+    connectionTimer.stop();
+    ackTimer.stop();
     enabled = true;
 
     dumpLogHeader();
@@ -266,6 +270,7 @@ void TLayer4::_begin()
 
 void TLayer4::processTelegram(unsigned char *telegram, uint8_t telLength)
 {
+    PROFILE_SCOPE(PROFILE_PROCESS_TELEGRAM);
     processTelegramInternal(telegram, telLength);
     discardReceivedTelegram();
 }
@@ -745,9 +750,9 @@ void TLayer4::actionA01Connect(uint16_t address)
     connectedAddr = address;
     seqNoSend = 0;
     seqNoRcv = 0;
-    connectedTime = millis(); // "start connection timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "start connection timeout timer"
     setTL4State(TLayer4::OPEN_IDLE);
-    dump2(lastTick = connectedTime;); // for debug logging
+    dump2(lastTick = millis();); // for debug logging
 }
 
 void TLayer4::actionA02sendAckPduAndProcessApci(ApciCommand apciCmd, const int8_t seqNo, unsigned char *telegram, uint8_t telLength)
@@ -757,7 +762,7 @@ void TLayer4::actionA02sendAckPduAndProcessApci(ApciCommand apciCmd, const int8_
     sendConControlTelegram(T_ACK_PDU, connectedAddr, seqNo);
     seqNoRcv++;                 // increment sequence counter
     seqNoRcv &= 0x0F;           // handle overflow
-    connectedTime = millis(); // "restart the connection timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "restart the connection timeout timer"
 
     byte * sendBuffer;
     volatile SendTelegramBufferState * sendBufferState;
@@ -797,14 +802,14 @@ void TLayer4::actionA03sendAckPduAgain(const int8_t seqNo)
     dump2(serial.println("ERROR A03sendAckPduAgain "));
     sendConControlTelegram(T_ACK_PDU, connectedAddr, seqNo);
     repeatedT_ACKcount++; // counting for statistics
-    connectedTime = millis(); // "restart the connection timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "restart the connection timeout timer"
 }
 
 void TLayer4::actionA04SendNAck(const uint8_t seqNo)
 {
     dump2(serial.println("ERROR actionA04SendNAck"));
     sendConControlTelegram(T_NACK_PDU, connectedAddr, seqNo);
-    connectedTime = millis(); // "restart the connection timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "restart the connection timeout timer"
 }
 
 void TLayer4::actionA05DisconnectUser()
@@ -864,8 +869,8 @@ void TLayer4::actionA07SendDirectTelegram()
     );
     sendPreparedConnectedTelegram();
     repCount = 0;
-    sentTelegramTime = millis(); // "start the acknowledge timeout timer"
-    connectedTime = millis(); // "restart the connection timeout timer"
+    ackTimer.start(TL4_T_ACK_TIMEOUT_MS); // "start the acknowledge timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "restart the connection timeout timer"
 }
 
 void TLayer4::actionA08IncrementSequenceNumber()
@@ -873,7 +878,7 @@ void TLayer4::actionA08IncrementSequenceNumber()
     dump2(serial.print("A08IncrementSequenceNumber "));
     seqNoSend++;
     seqNoSend &= 0x0F;
-    connectedTime = millis(); // "restart the connection timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "restart the connection timeout timer"
     sendConnectedTelegramBufferState = TELEGRAM_FREE;
 
     if (sendConnectedTelegramBuffer2State != TELEGRAM_FREE)
@@ -893,8 +898,8 @@ void TLayer4::actionA09RepeatMessage()
 
     sendPreparedConnectedTelegram();
     repCount++;
-    sentTelegramTime = millis(); // "start the acknowledge timeout timer"
-    connectedTime = millis(); // "restart the connection timeout timer"
+    ackTimer.start(TL4_T_ACK_TIMEOUT_MS); // "start the acknowledge timeout timer"
+    connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "restart the connection timeout timer"
 }
 
 void TLayer4::actionA10Disconnect(uint16_t address)
@@ -917,7 +922,7 @@ void TLayer4::loop()
         return;
 
     // Send a disconnect after TL4_CONNECTION_TIMEOUT_MS milliseconds inactivity
-    if ((state != TLayer4::CLOSED) && (elapsed(connectedTime) >= TL4_CONNECTION_TIMEOUT_MS))
+    if ((state != TLayer4::CLOSED) && connectionTimer.expired())
     {
         // event E16
         actionA06DisconnectAndClose();
@@ -932,7 +937,7 @@ void TLayer4::loop()
     }
 
     // Repeat the message after TL4_T_ACK_TIMEOUT_MS milliseconds
-    if ((state == TLayer4::OPEN_WAIT) && (elapsed(sentTelegramTime) >= TL4_T_ACK_TIMEOUT_MS))
+    if ((state == TLayer4::OPEN_WAIT) && ackTimer.expired())
     {
         if (repCount < TL4_MAX_REPETITION_COUNT)
         {
@@ -965,6 +970,8 @@ void TLayer4::resetConnection()
 
     sendConnectedTelegramBufferState = TELEGRAM_FREE;
     sendConnectedTelegramBuffer2State = TELEGRAM_FREE;
+    connectionTimer.stop();
+    ackTimer.stop();
 }
 
 bool TLayer4::setTL4State(TLayer4::TL4State newState)
@@ -60,7 +60,33 @@ const PropertyDef* PropertiesBCU2::propertyDef(int objectIdx, PropertyID propert
         DB_PROPERTIES(serial.print("propertyDef: ");printObjectIdx(objectIdx); serial.println(" not implemented!"););
         return nullptr;
     }
-    return findProperty(propertyId, propertiesTab()[objectIdx]);
+
+    if (lastPropertyDef && lastObjectIdx == objectIdx && lastPropertyDef->id == propertyId)
+        return lastPropertyDef;
+
+    const PropertyDef* def = findProperty(propertyId, propertiesTab()[objectIdx]);
+    if (def)
+    {
+        lastPropertyDef = def;
+        lastObjectIdx = objectIdx;
+    }
+    return def;
+}
+
+int PropertiesBCU2::numProperties(int objectIdx)
+{
+    if (objectIdx < 0 || objectIdx >= NUM_PROP_OBJECTS)
+        return 0;
+
+    if (!propertyCount[objectIdx])
+    {
+        const PropertyDef* table = propertiesTab()[objectIdx];
+        int count = 0;
+        while (table[count].id)
+            ++count;
+        propertyCount[objectIdx] = count;
+    }
+    return propertyCount[objectIdx];
 }
 
 /**
@@ -679,7 +705,9 @@ bool PropertiesBCU2::propertyDescReadTelegram(int objectIdx, PropertyID property
 
     if (propertyId)
         def = propertyDef(objectIdx, propertyId);
-    else def = &propertiesTab()[objectIdx][index];
+    else if (index < numProperties(objectIdx))
+        def = &propertiesTab()[objectIdx][index];
+    else def = nullptr;
 
     sendBuffer[10] = index;
 
@@ -0,0 +1,255 @@
+/*
+ *  tp_uart.cpp - Data link layer on a TP transceiver chip that is attached to a serial port
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/eib/tp_uart.h>
+
+#include <sblib/interrupt.h>
+#include <sblib/timer.h>
+#include <sblib/eib/bus.h>
+#include <sblib/eib/bus_const.h>
+
+// The control byte of a received data frame, standard or extended
+#define DATA_FRAME_MASK  (SB_TEL_DATA_FRAME_FLAG | SB_TEL_ACK_FRAME_FLAG | SB_TEL_ACK_REQ_FLAG | SB_TEL_NULL_FLAG)
+#define DATA_FRAME_VALUE (SB_TEL_ACK_FRAME_FLAG)
+
+// The mask of the services that are identified by their lower bits
+#define STATE_IND_MASK 0x07
+#define DATA_CON_MASK  0x7f
+
+// The bit of L_Data.con that is set if the frame was acknowledged
+#define DATA_CON_POSITIVE 0x80
+
+/** The states of receiving from the transceiver */
+enum TpUartRxState
+{
+    RX_IDLE,  //!< Waiting for a frame or a service
+    RX_FRAME, //!< Receiving a frame
+    RX_ECHO   //!< Receiving the frame that we sent
+};
+
+/** The states of sending the telegram of Bus::sendCurTelegram */
+enum TpUartTxState
+{
+    TX_IDLE,       //!< No telegram is being sent
+    TX_WAIT_RESET, //!< The telegram is written when the transceiver has finished resetting
+    TX_WAIT_CON    //!< The telegram was written, waiting for L_Data.con
+};
+
+
+TpUart::TpUart(BufferedStream& port)
+    : bus(nullptr)
+    , port(port)
+    , rxState(RX_IDLE)
+    , rxChecksum(0)
+    , rxLength(0)
+    , rxTime(0)
+    , txState(TX_IDLE)
+    , txLength(0)
+    , txTime(0)
+    , resetPending(false)
+    , lastState(0)
+{
+}
+
+void TpUart::begin(Bus* bus)
+{
+    this->bus = bus;
+    rxState = RX_IDLE;
+    txState = TX_IDLE;
+    lastState = 0;
+
+    // The transceiver can answer before write() returns
+    resetPending = true;
+    port.setReceiveCallback(this);
+    port.write(TP_UART_RESET_REQ);
+}
+
+void TpUart::loop()
+{
+    noInterrupts();
+    checkReceiveTimeout();
+
+    // A confirmation that arrives later is ignored
+    bool confirmationMissing = (txState == TX_WAIT_CON && elapsed(txTime) > TP_UART_CON_TIMEOUT);
+    if (confirmationMissing)
+    {
+        txState = TX_IDLE;
+    }
+    interrupts();
+
+    if (confirmationMissing)
+    {
+        confirm(false);
+    }
+}
+
+void TpUart::send(const byte* telegram, int length)
+{
+    txLength = length;
+
+    // The transceiver ignores the frame while it resets. The receive interrupt
+    // must not write U_AckInformation in between the bytes of the frame.
+    noInterrupts();
+    if (resetPending)
+    {
+        txState = TX_WAIT_RESET;
+    }
+    else
+    {
+        writeFrame();
+    }
+    interrupts();
+}
+
+void TpUart::writeFrame()
+{
+    const byte* telegram = bus->sendCurTelegram;
+    int last = txLength - 1;
+
+    // U_L_DataStart is U_L_DataContinue of the first byte
+    for (int i = 0; i < last; ++i)
+    {
+        port.write(TP_UART_DATA_CONTINUE | i);
+        port.write(telegram[i]);
+    }
+    port.write(TP_UART_DATA_END | last);
+    port.write(telegram[last]);
+
+    txState = TX_WAIT_CON;
+    txTime = millis();
+}
+
+void TpUart::confirm(bool successful)
+{
+    txState = TX_IDLE;
+    if (bus->sendCurTelegram == nullptr)
+        return;
+
+    if (!successful)
+        bus->tx_error |= TX_RETRY_ERROR;
+    bus->finishSendingTelegram();
+}
+
+void TpUart::checkReceiveTimeout()
+{
+    if (rxState != RX_IDLE && elapsed(rxTime) > TP_UART_RX_TIMEOUT)
+    {
+        bus->rx_error |= RX_LENGTH_ERROR;
+        rxState = RX_IDLE;
+    }
+}
+
+void TpUart::byteReceived(byte ch)
+{
+    // A truncated frame must not be continued by the next one, even if loop() did not run in between
+    checkReceiveTimeout();
+    rxTime = millis();
+
+    if (rxState != RX_IDLE)
+    {
+        receivedFrameByte(ch);
+    }
+    else if ((ch & DATA_FRAME_MASK) == DATA_FRAME_VALUE)
+    {
+        rxState = RX_FRAME;
+        rxChecksum = 0;
+        rxLength = 0;
+        bus->nextByteIndex = 0;
+        bus->rx_error = RX_OK;
+        receivedFrameByte(ch);
+    }
+    else if ((ch & DATA_CON_MASK) == TP_UART_DATA_CON)
+    {
+        if (txState == TX_WAIT_CON)
+            confirm(ch & DATA_CON_POSITIVE);
+    }
+    else if (ch == TP_UART_RESET_IND)
+    {
+        resetPending = false;
+        if (txState == TX_WAIT_RESET)
+        {
+            writeFrame();
+        }
+        else if (txState == TX_WAIT_CON)
+        {
+            // An unexpected reset lost the telegram that was sent
+            confirm(false);
+        }
+    }
+    else if ((ch & STATE_IND_MASK) == TP_UART_STATE_IND)
+    {
+        lastState = ch & ~STATE_IND_MASK;
+    }
+}
+
+void TpUart::receivedFrameByte(byte ch)
+{
+    int index = bus->nextByteIndex++;
+    if (index < MAX_TELEGRAM_SIZE)
+    {
+        bus->rx_telegram[index] = ch;
+    }
+    rxChecksum ^= ch;
+
+    byte* telegram = bus->rx_telegram;
+    bool standardFrame = telegram[0] & SB_TEL_LONG_FRAME_FLAG;
+
+    if (standardFrame && index == 5)
+    {
+        rxLength = 8 + (ch & 0x0f);
+
+        // Our own frame, without the repeat flag
+        const byte* sent = bus->sendCurTelegram;
+        if (sent != nullptr && ((sent[0] ^ telegram[0]) & ~SB_TEL_REPEAT_FLAG) == 0 &&
+            sent[1] == telegram[1] && sent[2] == telegram[2] && sent[3] == telegram[3] &&
+            sent[4] == telegram[4] && sent[5] == telegram[5])
+        {
+            rxState = RX_ECHO;
+        }
+        else
+        {
+            acknowledgeFrame();
+        }
+    }
+    else if (!standardFrame && index == 6)
+    {
+        rxLength = 9 + ch;
+    }
+
+    if (bus->nextByteIndex != rxLength)
+        return;
+
+    if (rxState == RX_ECHO)
+    {
+        bus->nextByteIndex = 0;
+    }
+    else
+    {
+        bus->handleTransceiverTelegram(rxChecksum == 0xff);
+    }
+    rxState = RX_IDLE;
+}
+
+void TpUart::acknowledgeFrame()
+{
+    // The transceiver needs to know now if it shall acknowledge the frame
+    bus->checkDestination();
+    const byte* telegram = bus->rx_telegram;
+    if (bus->rxDestination != Bus::RX_DESTINATION_OURS || !bus->acknowledgeAllowed(telegram[0]))
+        return;
+
+    // Like Bus::acceptTelegram(), acknowledge a repetition of a telegram that was handed over,
+    // and a new telegram only if there is space for it. The repetition is recognized by the
+    // header, the checksum is not received yet.
+    byte flags = TP_UART_ACK_ADDRESSED;
+    bool repeated = !(telegram[0] & SB_TEL_REPEAT_FLAG) && bus->isRepeatedTelegram(false);
+    if (bus->telegramLen && !repeated)
+        flags |= TP_UART_ACK_BUSY;
+
+    port.write(TP_UART_ACK_INFO | flags);
+}
@@ -6,6 +6,7 @@
  */
 
 #include <sblib/eib/userEeprom.h>
+#include <sblib/interrupt.h>
 #include <sblib/internal/iap.h>
 #include <sblib/eib/bcu_base.h>
 #include <sblib/eib/bus.h>
@@ -112,9 +113,9 @@ void UserEeprom::writeUserEeprom()
     interrupts();
 }
 
-UserEeprom::UserEeprom(unsigned int start, unsigned int size, unsigned int flashSize) :
+UserEeprom::UserEeprom(unsigned int start, unsigned int size, unsigned int flashSize, byte* data) :
 		Memory(start, size),
-		userEepromData(new byte[size]()),
+		userEepromData(data),
 		userEepromFlashSize(flashSize)
 {
     readUserEeprom();
@@ -152,7 +153,7 @@ void UserEeprom::modified(bool newModified)
     userEepromModified = newModified;
     if (userEepromModified)
     {
-        writeUserEepromTime = millis() + 50;
+        writeUserEepromTime = millis() + USER_EEPROM_WRITE_DELAY;
     }
     else
     {
@@ -162,9 +163,17 @@ void UserEeprom::modified(bool newModified)
 
 bool UserEeprom::writeDelayElapsed() const
 {
-    bool elapsed = userEepromModified;
-    elapsed |= ((int)millis() - (int)writeUserEepromTime) > 0;
-    return (elapsed);
+    return (writeDelayRemaining() == 0);
+}
+
+unsigned int UserEeprom::writeDelayRemaining() const
+{
+    if (!userEepromModified)
+    {
+        return 0;
+    }
+    int remaining = (int)writeUserEepromTime - (int)millis();
+    return (remaining > 0) ? remaining : 0;
 }
 
 bool UserEeprom::isModified() const
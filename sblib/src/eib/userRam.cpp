@@ -22,13 +22,14 @@
 #include <sblib/bits.h>
 #include <cstring>
 
-UserRam::UserRam(uint32_t start, uint32_t size, uint32_t shadowSize) :
+UserRam::UserRam(uint32_t start, uint32_t size, uint32_t shadowSize, uint8_t* data) :
         Memory(start, size + shadowSize),
-        userRamData(new uint8_t[size + shadowSize]()),
+        userRamData(data),
         _status(0),
         _runState(0),
         shadowSize(shadowSize)
 {
+    memset(userRamData, 0, size + shadowSize);
     endAddress -= shadowSize;
     sizeTotal -= shadowSize;
 }
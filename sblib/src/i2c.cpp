@@ -32,6 +32,7 @@
  */
 
 #include <sblib/i2c.h>
+#include <sblib/pin.h>
 
 
 /*****************************************************************************
@@ -60,12 +61,8 @@ bool i2c_initialized = false;
  /* Configuration of standard I2C Pins on LPC1115 */
 static void Init_I2C_PinMux(void)
 {
-	LPC_IOCON->PIO0_4 = (LPC_IOCON->PIO0_4
-	                  & ~0x3F)    /*  I2C I/O config */
-	                  | 0x01;    /* I2C SCL */
-	LPC_IOCON->PIO0_5 = (LPC_IOCON->PIO0_5
-	                  & ~0x3F)
-	                  | 0x01;    /* I2C SDA */
+	Pin<PIO0_4>::mode<PINMODE_FUNC(PF_SCL) | I2C_FASTPLUS_BIT>(); /* I2C SCL */
+	Pin<PIO0_5>::mode<PINMODE_FUNC(PF_SDA) | I2C_FASTPLUS_BIT>(); /* I2C SDA */
 }
 
 /* State machine handler for I2C0 and I2C1 */
@@ -105,7 +102,7 @@ static void i2c_app_init(I2C_ID_T id, int speed)
 	Chip_I2C_SetClockRate(id, speed);
 
 	/* Set default mode to interrupt */
-	i2c_set_mode(id, true);
+	i2c_set_mode(id, false);
 }
 
 
@@ -156,6 +153,9 @@ struct i2c_interface {
 	I2C_XFER_T *mXfer;	/* Current active xfer pointer */
 	I2C_XFER_T *sXfer;	/* Pointer to store xfer when bus is busy */
 	uint32_t flags;		/* Flags used by I2C master and slave */
+	I2C_MASTER_REQ_T *mReq;		/* Active master request, head of the queue */
+	I2C_MASTER_REQ_T *mReqTail;	/* Last queued master request */
+	I2C_XFER_T *wXfer;	/* Transfer a blocking call waits for */
 };
 
 /* Slave interface structure */
@@ -166,7 +166,7 @@ struct i2c_slave_interface {
 
 /* I2C interfaces */
 static struct i2c_interface i2c[I2C_NUM_INTERFACE] = {
-	{LPCOPEN_I2C, /*SYSCTL_CLOCK_I2C,*/ Chip_I2C_EventHandler, 0, 0, 0, 0}
+	{LPCOPEN_I2C, /*SYSCTL_CLOCK_I2C,*/ Chip_I2C_EventHandler, 0, 0, 0, 0, 0, 0, 0}
 };
 
 static struct i2c_slave_interface i2c_slave[I2C_NUM_INTERFACE][I2C_SLAVE_NUM_INTERFACE];
@@ -209,6 +209,13 @@ static inline void startMasterXfer(LPC_I2C_T *pI2C)
 	pI2C->CONSET = I2C_CON_I2EN | I2C_CON_STA;
 }
 
+/* Start the next master transfer after the STOP of the previous one */
+static inline void startMasterXferAfterStop(LPC_I2C_T *pI2C)
+{
+	/* STO is still set if the STOP is not on the bus yet, the START follows it */
+	pI2C->CONSET = I2C_CON_I2EN | I2C_CON_STA;
+}
+
 /* Enable I2C and enable slave transfers */
 static inline void startSlaverXfer(LPC_I2C_T *pI2C)
 {
@@ -219,6 +226,14 @@ static inline void startSlaverXfer(LPC_I2C_T *pI2C)
 	pI2C->CONSET = I2C_CON_I2EN | I2C_CON_AA;
 }
 
+/* Enable slave transfers after the STOP of the previous master transfer */
+static inline void startSlaverXferAfterStop(LPC_I2C_T *pI2C)
+{
+	/* STO is still set if the STOP is not on the bus yet, AA takes effect after it */
+	pI2C->CONCLR = I2C_CON_STA;
+	pI2C->CONSET = I2C_CON_I2EN | I2C_CON_AA;
+}
+
 /* Check if I2C bus is free */
 static inline int isI2CBusFree(LPC_I2C_T *pI2C)
 {
@@ -281,6 +296,44 @@ static I2C_SLAVE_ID lookupSlaveIndex(LPC_I2C_T *pI2C, uint8_t slaveAddr)
 	return I2C_SLAVE_GENERAL;
 }
 
+/* Make the request the active one and start it */
+static void activateMasterReq(struct i2c_interface *iic, I2C_MASTER_REQ_T *req, bool afterStop)
+{
+	iic->mXfer = req->xfer;
+	req->startTime = millis();
+
+	/* If slave xfer not in progress */
+	if (!iic->sXfer) {
+		if (afterStop) {
+			startMasterXferAfterStop(iic->ip);
+		}
+		else {
+			startMasterXfer(iic->ip);
+		}
+	}
+}
+
+/* Remove the finished active request from the queue and start the next one */
+static I2C_MASTER_REQ_T *finishMasterReq(struct i2c_interface *iic)
+{
+	I2C_MASTER_REQ_T *req = iic->mReq;
+
+	iic->mReq = req->next;
+	if (iic->mReq) {
+		activateMasterReq(iic, iic->mReq, true);
+	}
+	else {
+		iic->mReqTail = 0;
+		iic->mXfer = 0;
+
+		/* Start slave if one is active, without waiting for the STOP in the interrupt */
+		if (SLAVE_ACTIVE(iic)) {
+			startSlaverXferAfterStop(iic->ip);
+		}
+	}
+	return req;
+}
+
 /* Master transfer state change handler handler */
 int handleMasterXferState(LPC_I2C_T *pI2C, I2C_XFER_T  *xfer)
 {
@@ -444,9 +497,11 @@ void Chip_I2C_EventHandler(I2C_ID_T id, I2C_EVENT_T event)
 		return;
 	}
 
-	stat = &iic->mXfer->status;
+	stat = &iic->wXfer->status;
 	/* Wait for the status to change */
-	while (*stat == I2C_STATUS_BUSY) {}
+	while (*stat == I2C_STATUS_BUSY) {
+		Chip_I2C_MasterCheckTimeout(id);
+	}
 }
 
 /* Chip polling event handler */
@@ -460,12 +515,13 @@ void Chip_I2C_EventHandlerPolling(I2C_ID_T id, I2C_EVENT_T event)
 		return;
 	}
 
-	stat = &iic->mXfer->status;
+	stat = &iic->wXfer->status;
 	/* Call the state change handler till xfer is done */
 	while (*stat == I2C_STATUS_BUSY) {
 		if (Chip_I2C_IsStateChanged(id)) {
 			Chip_I2C_MasterStateHandler(id);
 		}
+		Chip_I2C_MasterCheckTimeout(id);
 	}
 }
 
@@ -523,34 +579,99 @@ I2C_EVENTHANDLER_T Chip_I2C_GetMasterEventHandler(I2C_ID_T id)
 	return i2c[id].mEvent;
 }
 
-/* Transmit and Receive data in master mode */
-int Chip_I2C_MasterTransfer(I2C_ID_T id, I2C_XFER_T *xfer)
+/* Queue a master transfer */
+void Chip_I2C_MasterSubmit(I2C_ID_T id, I2C_MASTER_REQ_T *req)
 {
 	struct i2c_interface *iic = &i2c[id];
+	I2C_XFER_T *xfer = req->xfer;
 
-	iic->mEvent(id, I2C_EVENT_LOCK);
+	req->txBuff = xfer->txBuff;
+	req->txSz = xfer->txSz;
+	req->rxBuff = xfer->rxBuff;
+	req->rxSz = xfer->rxSz;
+	req->next = 0;
 	xfer->status = I2C_STATUS_BUSY;
-	iic->mXfer = xfer;
 
-	/* If slave xfer not in progress */
-	if (!iic->sXfer) {
-		startMasterXfer(iic->ip);
+	noInterrupts();
+	if (iic->mReqTail) {
+		iic->mReqTail->next = req;
+		iic->mReqTail = req;
 	}
-	iic->mEvent(id, I2C_EVENT_WAIT);
-	iic->mXfer = 0;
+	else {
+		iic->mReq = iic->mReqTail = req;
+		activateMasterReq(iic, req, false);
+	}
+	interrupts();
+}
 
-	/* Wait for stop condition to appear on bus */
-	while (!isI2CBusFree(iic->ip)) {}
+/* Set up a transfer and its request and queue it */
+void Chip_I2C_MasterSubmitXfer(I2C_ID_T id, I2C_MASTER_REQ_T *req, I2C_XFER_T *xfer, uint8_t slaveAddr,
+							   const uint8_t *txBuff, int txSz, uint8_t *rxBuff, int rxSz)
+{
+	*xfer = {};
+	xfer->slaveAddr = slaveAddr;
+	xfer->txBuff = txBuff;
+	xfer->txSz = txSz;
+	xfer->rxBuff = rxBuff;
+	xfer->rxSz = rxSz;
 
-	/* Start slave if one is active */
-	if (SLAVE_ACTIVE(iic)) {
-		startSlaverXfer(iic->ip);
+	*req = {};
+	req->xfer = xfer;
+	req->retries = I2C_MASTER_RETRIES;
+	req->timeoutMs = I2C_MASTER_TIMEOUT_MS;
+	Chip_I2C_MasterSubmit(id, req);
+}
+
+/* Abort the active master transfer after its timeout */
+void Chip_I2C_MasterCheckTimeout(I2C_ID_T id)
+{
+	struct i2c_interface *iic = &i2c[id];
+	I2C_MASTER_REQ_T *req;
+
+	noInterrupts();
+	req = iic->mReq;
+	if (!req || !req->timeoutMs || (millis() - req->startTime) < req->timeoutMs) {
+		interrupts();
+		return;
 	}
 
+	/* Release the bus */
+	req->xfer->status = I2C_STATUS_TIMEOUT;
+	iic->ip->CONCLR = I2C_CON_SI | I2C_CON_STA | I2C_CON_AA;
+	iic->ip->CONSET = I2C_CON_STO;
+	finishMasterReq(iic);
+	interrupts();
+
+	if (req->callback) {
+		req->callback(req);
+	}
+}
+
+/* Queue a transfer and wait until it is done */
+static int masterTransferWait(I2C_ID_T id, I2C_XFER_T *xfer, uint8_t retries)
+{
+	struct i2c_interface *iic = &i2c[id];
+	I2C_MASTER_REQ_T req = {0};
+
+	req.xfer = xfer;
+	req.retries = retries;
+	req.timeoutMs = I2C_MASTER_TIMEOUT_MS;
+
+	iic->mEvent(id, I2C_EVENT_LOCK);
+	Chip_I2C_MasterSubmit(id, &req);
+	iic->wXfer = xfer;
+	iic->mEvent(id, I2C_EVENT_WAIT);
+	iic->wXfer = 0;
 	iic->mEvent(id, I2C_EVENT_UNLOCK);
 	return (int) xfer->status;
 }
 
+/* Transmit and Receive data in master mode */
+int Chip_I2C_MasterTransfer(I2C_ID_T id, I2C_XFER_T *xfer)
+{
+	return masterTransferWait(id, xfer, 0);
+}
+
 /* Master tx only */
 int Chip_I2C_MasterSend(I2C_ID_T id, uint8_t slaveAddr, const uint8_t *buff, uint8_t len)
 {
@@ -558,7 +679,7 @@ int Chip_I2C_MasterSend(I2C_ID_T id, uint8_t slaveAddr, const uint8_t *buff, uin
 	xfer.slaveAddr = slaveAddr;
 	xfer.txBuff = buff;
 	xfer.txSz = len;
-	while (Chip_I2C_MasterTransfer(id, &xfer) == I2C_STATUS_ARBLOST) {}
+	masterTransferWait(id, &xfer, I2C_MASTER_RETRIES);
 	return len - xfer.txSz;
 }
 
@@ -573,7 +694,7 @@ int Chip_I2C_MasterCmdRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t cmd, uint8_t
 	xfer.txSz = 1;
 	xfer.rxBuff = buff;
 	xfer.rxSz = len;
-	while (Chip_I2C_MasterTransfer(id, &xfer) == I2C_STATUS_ARBLOST) {}
+	masterTransferWait(id, &xfer, I2C_MASTER_RETRIES);
 	return len - xfer.rxSz;
 }
 
@@ -588,7 +709,7 @@ int Chip_I2C_MasterWriteRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t *cmd, uint8
 	xfer.txSz = txlen;
 	xfer.rxBuff = buff;
 	xfer.rxSz = rxlen;
-	while (Chip_I2C_MasterTransfer(id, &xfer) == I2C_STATUS_ARBLOST) {}
+	masterTransferWait(id, &xfer, I2C_MASTER_RETRIES);
 	return rxlen - xfer.rxSz;
 }
 
@@ -599,7 +720,7 @@ int Chip_I2C_MasterRead(I2C_ID_T id, uint8_t slaveAddr, uint8_t *buff, int len)
 	xfer.slaveAddr = slaveAddr;
 	xfer.rxBuff = buff;
 	xfer.rxSz = len;
-	while (Chip_I2C_MasterTransfer(id, &xfer) == I2C_STATUS_ARBLOST) {}
+	masterTransferWait(id, &xfer, I2C_MASTER_RETRIES);
 	return len - xfer.rxSz;
 }
 
@@ -612,9 +733,36 @@ int Chip_I2C_IsMasterActive(I2C_ID_T id)
 /* State change handler for master transfer */
 void Chip_I2C_MasterStateHandler(I2C_ID_T id)
 {
-	if (!handleMasterXferState(i2c[id].ip, i2c[id].mXfer)) {
-		i2c[id].mEvent(id, I2C_EVENT_DONE);
+	struct i2c_interface *iic = &i2c[id];
+	I2C_MASTER_REQ_T *req = iic->mReq;
+
+	if (!req) {
+		/* Nothing to do, e.g. the transfer was aborted by its timeout */
+		iic->ip->CONCLR = I2C_CON_SI;
+		return;
+	}
+
+	if (handleMasterXferState(iic->ip, req->xfer)) {
+		return;
+	}
+
+	if (req->xfer->status == I2C_STATUS_ARBLOST && req->retries) {
+		/* Restart the transfer when the bus is free again */
+		req->retries--;
+		req->xfer->txBuff = req->txBuff;
+		req->xfer->txSz = req->txSz;
+		req->xfer->rxBuff = req->rxBuff;
+		req->xfer->rxSz = req->rxSz;
+		req->xfer->status = I2C_STATUS_BUSY;
+		startMasterXfer(iic->ip);
+		return;
+	}
+
+	finishMasterReq(iic);
+	if (req->callback) {
+		req->callback(req);
 	}
+	iic->mEvent(id, I2C_EVENT_DONE);
 }
 
 /* Setup slave function */
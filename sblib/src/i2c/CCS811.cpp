@@ -28,8 +28,16 @@
 #include <sblib/digital_pin.h>
 
 
-CCS811Class::CCS811Class() {
-  // empty constructor, just because.
+// Time to wait after asserting the WAKE pin in the non-blocking functions.
+// 2 ticks of the millisecond timer are at least 1ms, well above the recommended 50us.
+#define WAKE_TIMEOUT_MS 2
+
+CCS811Class::CCS811Class() :
+  _measureState(MEASURE_IDLE),
+  _measureValid(false),
+  _measureXfer(),
+  _measureReq(),
+  _measureBuffer() {
 }
 
 bool CCS811Class::begin(uint8_t I2C_ADDR, int WAKE_PIN) {
@@ -189,12 +197,62 @@ bool CCS811Class::getData(void) {
 	  return false;
   }
 
-  CO2 = ((uint8_t) buffer[0] << 8) + buffer[1];
-  TVOC = ((uint8_t) buffer[2] << 8) + buffer[3];
+  storeData(buffer);
+  return true;
+}
 
+// start reading the CO2 and TVOC Data from CSS811 without waiting
+// call poll() from the main loop until it returns true
+bool CCS811Class::startMeasurement(void) {
+  if (_measureState != MEASURE_IDLE)
+    return false;
+
+  digitalWrite(_WAKE_PIN, false);
+  _measureTimeout.start(WAKE_TIMEOUT_MS);
+  _measureState = MEASURE_WAKE;
   return true;
 }
 
+// process the measurement started with startMeasurement(), never waits
+// returns true once when the measurement is finished, successful or not
+bool CCS811Class::poll(void) {
+  switch (_measureState) {
+    case MEASURE_WAKE:
+      if (_measureTimeout.expired()) {
+        // reading ALG_RESULT_DATA clears DATA_READY bit in 0x00
+        Chip_I2C_MasterSubmitXfer(I2C0, &_measureReq, &_measureXfer, _I2C_ADDR,
+                                  &ALG_RESULT_DATA, 1, _measureBuffer, sizeof(_measureBuffer));
+        _measureState = MEASURE_READ;
+      }
+      return false;
+
+    case MEASURE_READ:
+      if (_measureXfer.status == I2C_STATUS_BUSY) {
+        Chip_I2C_MasterCheckTimeout(I2C0);
+        return false;
+      }
+      digitalWrite(_WAKE_PIN, true);
+      _measureValid = (_measureXfer.status == I2C_STATUS_DONE);
+      if (_measureValid)
+        storeData(_measureBuffer);
+      _measureState = MEASURE_IDLE;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// true if the last measurement finished by poll() updated CO2 and TVOC
+bool CCS811Class::result(void) {
+  return _measureValid;
+}
+
+void CCS811Class::storeData(const uint8_t *buffer) {
+  CO2 = ((uint8_t) buffer[0] << 8) + buffer[1];
+  TVOC = ((uint8_t) buffer[2] << 8) + buffer[3];
+}
+
 int CCS811Class::readTVOC(void) {
   return TVOC;
 }
@@ -25,12 +25,23 @@ SGP4xClass::SGP4xClass():
         rawNoxTics(0),
         vocIndexValue(-1),
         noxIndexValue(-1),
-        featureSet(0)
+        featureSet(0),
+        measureState(MeasureState::idle),
+        measureResult(SGP4xResult::readError),
+        measureXfer(),
+        measureReq(),
+        measureCommand(),
+        measureBuffer()
 {
+#ifdef GAS_INDEX_FIXED_POINT
+    GasIndexAlgorithmFix16_init(&voc_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_VOC);
+    GasIndexAlgorithmFix16_init(&nox_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_NOX);
+#else
     // init VOC index algorithm with default sampling interval
     GasIndexAlgorithm_init_with_sampling_interval(&voc_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, GasIndexAlgorithm_DEFAULT_SAMPLING_INTERVAL);
     // init NOx index algorithm with default sampling interval
     GasIndexAlgorithm_init_with_sampling_interval(&nox_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_NOX, GasIndexAlgorithm_DEFAULT_SAMPLING_INTERVAL);
+#endif
 }
 
 SGP4xResult SGP4xClass::readSensor(Sgp4xCommand command, uint8_t * commandBuffer, uint8_t commandBufferSize,
@@ -66,14 +77,19 @@ SGP4xResult SGP4xClass::readSensor(Sgp4xCommand command, uint8_t * commandBuffer
         return SGP4xResult::readError;
     }
 
+    return checkResponse(readBuffer, bytesProcessed);
+}
+
+SGP4xResult SGP4xClass::checkResponse(const uint8_t * readBuffer, uint8_t readBufferSize)
+{
     // crc8 checksum is transmitted after every word (2 bytes)
     // including the checksum we have to receive a multiple of 3 bytes
-    if ((bytesProcessed == 0) || ((bytesProcessed % 3) != 0))
+    if ((readBufferSize == 0) || ((readBufferSize % 3) != 0))
     {
         return SGP4xResult::invalidByteCount;
     }
 
-    for (uint8_t i = 0; i < bytesProcessed; i = i + 3)
+    for (uint8_t i = 0; i < readBufferSize; i = i + 3)
     {
         if (crc8(&readBuffer[i], 2) != readBuffer[i+2])
         {
@@ -91,10 +107,16 @@ SGP4xResult SGP4xClass::init(uint32_t samplingIntervalMs)
 	rawNoxTics = 0;
 	vocIndexValue = -1;
 	noxIndexValue = -1;
+#ifdef GAS_INDEX_FIXED_POINT
+	fix16_t samplingInterval = (fix16_t)(((uint64_t)samplingIntervalMs << 16) / 1000);
+	GasIndexAlgorithmFix16_init_with_sampling_interval(&voc_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, samplingInterval);
+	GasIndexAlgorithmFix16_init_with_sampling_interval(&nox_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_NOX, samplingInterval);
+#else
 	// init VOC index algorithm with provided sampling interval
 	GasIndexAlgorithm_init_with_sampling_interval(&voc_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, (float)(samplingIntervalMs/1000.f));
 	// init NOx index algorithm with provided sampling interval
 	GasIndexAlgorithm_init_with_sampling_interval(&nox_algorithm_params, GasIndexAlgorithm_ALGORITHM_TYPE_NOX, (float)(samplingIntervalMs/1000.f));
+#endif
     return executeConditioning();
 }
 
@@ -143,15 +165,18 @@ SGP4xResult SGP4xClass::executeSelfTest() {
     return SGP4xResult::success;
 }
 
-SGP4xResult SGP4xClass::measureRawSignal(float relativeHumidity, float temperature, bool useCompensation)
+void SGP4xClass::setupMeasureCommand(uint8_t * cmdBuffer, float relativeHumidity, float temperature, bool useCompensation)
 {
-    uint8_t readBuffer[6];
-    uint8_t readBufferSize = sizeof(readBuffer)/sizeof(*readBuffer);
-    // default static command without temperature/humidity correction
+    cmdBuffer[0] = highByte((uint16_t)Sgp4xCommand::measureRaw);
+    cmdBuffer[1] = lowByte((uint16_t)Sgp4xCommand::measureRaw);
+
+    // default parameters without temperature/humidity correction
     // (same parameter byte values as with 50% relative humidity at 25 degree celsius)
-    //                      0x26, 0x19, 0x80, 0x00, 0xA2, 0x66, 0x66, 0x93
-    uint8_t cmdBuffer[8] = {0x00, 0x00, 0x80, 0x00, 0xA2, 0x66, 0x66, 0x93};
-    uint8_t commandBufferSize = sizeof(cmdBuffer)/sizeof(*cmdBuffer);
+    static const uint8_t defaultParameters[6] = {0x80, 0x00, 0xA2, 0x66, 0x66, 0x93};
+    for (uint8_t i = 0; i < sizeof(defaultParameters); i++)
+    {
+        cmdBuffer[2 + i] = defaultParameters[i];
+    }
 
     uint16_t relativeHumidityTicks;
     uint16_t temperatureTicks;
@@ -172,6 +197,29 @@ SGP4xResult SGP4xClass::measureRawSignal(float relativeHumidity, float temperatu
         cmdBuffer[6] = lowByte(temperatureTicks);
         cmdBuffer[7] = crc8(&cmdBuffer[5], 2);
     }
+}
+
+void SGP4xClass::processRawSignals(const uint8_t * readBuffer)
+{
+	rawVocTics = makeWord(readBuffer[0], readBuffer[1]);
+	rawNoxTics = makeWord(readBuffer[3], readBuffer[4]);
+#ifdef GAS_INDEX_FIXED_POINT
+	GasIndexAlgorithmFix16_process(&voc_algorithm_params, rawVocTics, &vocIndexValue);
+	GasIndexAlgorithmFix16_process(&nox_algorithm_params, rawNoxTics, &noxIndexValue);
+#else
+	GasIndexAlgorithm_process(&voc_algorithm_params, rawVocTics , &vocIndexValue);
+	GasIndexAlgorithm_process(&nox_algorithm_params, rawNoxTics, &noxIndexValue);
+#endif
+}
+
+SGP4xResult SGP4xClass::measureRawSignal(float relativeHumidity, float temperature, bool useCompensation)
+{
+    uint8_t readBuffer[6];
+    uint8_t readBufferSize = sizeof(readBuffer)/sizeof(*readBuffer);
+    uint8_t cmdBuffer[8];
+    uint8_t commandBufferSize = sizeof(cmdBuffer)/sizeof(*cmdBuffer);
+
+    setupMeasureCommand(cmdBuffer, relativeHumidity, temperature, useCompensation);
 
     // max. duration for processing sgp41_measure_raw_signals is 50ms
     SGP4xResult result = readSensor(Sgp4xCommand::measureRaw, cmdBuffer, commandBufferSize, readBuffer, readBufferSize, 50);
@@ -180,12 +228,7 @@ SGP4xResult SGP4xClass::measureRawSignal(float relativeHumidity, float temperatu
         return result;
     }
 
-	rawVocTics = makeWord(readBuffer[0], readBuffer[1]);
-	GasIndexAlgorithm_process(&voc_algorithm_params, rawVocTics , &vocIndexValue);
-
-	rawNoxTics = makeWord(readBuffer[3], readBuffer[4]);
-	GasIndexAlgorithm_process(&nox_algorithm_params, rawNoxTics, &noxIndexValue);
-
+    processRawSignals(readBuffer);
 	return SGP4xResult::success;
 }
 
@@ -194,6 +237,86 @@ SGP4xResult SGP4xClass::measureRawSignal()
     return measureRawSignal(50.f, 25.f, false);
 }
 
+bool SGP4xClass::startMeasurement(float relativeHumidity, float temperature, bool useCompensation)
+{
+    if (measureState != MeasureState::idle)
+    {
+        return false;
+    }
+
+    setupMeasureCommand(measureCommand, relativeHumidity, temperature, useCompensation);
+    Chip_I2C_MasterSubmitXfer(I2C0, &measureReq, &measureXfer, eSGP4xAddress, measureCommand, sizeof(measureCommand), nullptr, 0);
+    measureState = MeasureState::command;
+    return true;
+}
+
+bool SGP4xClass::startMeasurement()
+{
+    return startMeasurement(50.f, 25.f, false);
+}
+
+bool SGP4xClass::poll()
+{
+    switch (measureState)
+    {
+    case MeasureState::command:
+    case MeasureState::read:
+        if (measureXfer.status == I2C_STATUS_BUSY)
+        {
+            Chip_I2C_MasterCheckTimeout(I2C0);
+            return false;
+        }
+        break;
+
+    case MeasureState::conversion:
+        if (measureTimeout.expired())
+        {
+            Chip_I2C_MasterSubmitXfer(I2C0, &measureReq, &measureXfer, eSGP4xAddress, nullptr, 0, measureBuffer, sizeof(measureBuffer));
+            measureState = MeasureState::read;
+        }
+        return false;
+
+    default:
+        return false;
+    }
+
+    if (measureState == MeasureState::command)
+    {
+        if (measureXfer.status != I2C_STATUS_DONE)
+        {
+            return finishMeasurement(SGP4xResult::sendError);
+        }
+        // max. duration for processing sgp41_measure_raw_signals is 50ms
+        measureTimeout.start(50);
+        measureState = MeasureState::conversion;
+        return false;
+    }
+
+    if (measureXfer.status != I2C_STATUS_DONE)
+    {
+        return finishMeasurement(SGP4xResult::readError);
+    }
+
+    SGP4xResult result = checkResponse(measureBuffer, sizeof(measureBuffer));
+    if (result == SGP4xResult::success)
+    {
+        processRawSignals(measureBuffer);
+    }
+    return finishMeasurement(result);
+}
+
+SGP4xResult SGP4xClass::result()
+{
+    return measureResult;
+}
+
+bool SGP4xClass::finishMeasurement(SGP4xResult result)
+{
+    measureResult = result;
+    measureState = MeasureState::idle;
+    return true;
+}
+
 SGP4xResult SGP4xClass::getSerialnumber(uint8_t * serialNumber, uint8_t length)
 {
 	uint8_t readBuffer[9];
@@ -47,6 +47,9 @@
 #define WATER_VAPOR         (17.62f) //!< constant for water vapor
 #define BAROMETRIC_PRESSURE (243.5f) //!< constant for barometric pressure
 
+#define MEASURE_HI_DURATION_MS (10)  //!< max. duration of a high repeatability measurement is 8.3ms
+#define MEASURE_TIMEOUT_MS     (300) //!< timeout for I2C communication of a measurement
+
 bool SHT4xClass::init(void)
 {
 	i2c_lpcopen_init();
@@ -71,6 +74,81 @@ bool SHT4xClass::measureHighPrecision()
     return true;
 }
 
+bool SHT4xClass::startMeasurement()
+{
+    if (measureState != MeasureState::idle)
+    {
+        return false;
+    }
+
+    measureStart = millis();
+    measureCommand = (uint8_t)Sht4xCommand::measHi;
+    Chip_I2C_MasterSubmitXfer(I2C0, &measureReq, &measureXfer, eSHT4xAddress, &measureCommand, sizeof(measureCommand), nullptr, 0);
+    measureState = MeasureState::command;
+    return true;
+}
+
+bool SHT4xClass::poll()
+{
+    switch (measureState)
+    {
+    case MeasureState::command:
+    case MeasureState::read:
+        if (measureXfer.status == I2C_STATUS_BUSY)
+        {
+            Chip_I2C_MasterCheckTimeout(I2C0);
+            return false;
+        }
+        break;
+
+    case MeasureState::conversion:
+        if (measureTimeout.expired())
+        {
+            Chip_I2C_MasterSubmitXfer(I2C0, &measureReq, &measureXfer, eSHT4xAddress, nullptr, 0, measureBuffer, sizeof(measureBuffer));
+            measureState = MeasureState::read;
+        }
+        return false;
+
+    default:
+        return false;
+    }
+
+    if (measureState == MeasureState::command)
+    {
+        if (measureXfer.status != I2C_STATUS_DONE)
+        {
+            return finishMeasurement(false);
+        }
+        measureTimeout.start(MEASURE_HI_DURATION_MS);
+        measureState = MeasureState::conversion;
+        return false;
+    }
+
+    // the sensor does not acknowledge the read while the conversion is running
+    if (measureXfer.status == I2C_STATUS_NAK && (millis() - measureStart) < MEASURE_TIMEOUT_MS)
+    {
+        measureTimeout.start(1);
+        measureState = MeasureState::conversion;
+        return false;
+    }
+
+    if (measureXfer.status != I2C_STATUS_DONE ||
+        measureBuffer[2] != crc8(measureBuffer, 2) ||
+        measureBuffer[5] != crc8(measureBuffer + 3, 2))
+    {
+        return finishMeasurement(false);
+    }
+
+    this->temperature = convertTicksToCelsius((measureBuffer[0] << 8) | measureBuffer[1]);
+    this->humidity = convertTicksToPercentRH((measureBuffer[3] << 8) | measureBuffer[4]);
+    return finishMeasurement(true);
+}
+
+bool SHT4xClass::result()
+{
+    return measureValid;
+}
+
 bool SHT4xClass::measureHighPrecisionTicks(uint16_t &temperatureTicks, uint16_t &humidityTicks)
 {
 	uint8_t buffer[6] = {};
@@ -146,6 +224,13 @@ uint32_t SHT4xClass::getSerialnumber(void)
 /******************************************************************************
  * Private Functions
  ******************************************************************************/
+bool SHT4xClass::finishMeasurement(bool valid)
+{
+    measureValid = valid;
+    measureState = MeasureState::idle;
+    return true;
+}
+
 bool SHT4xClass::writeCommand(Sht4xCommand command)
 {
 	uint8_t cmd = (uint8_t)command;
@@ -169,6 +169,26 @@ bool BH1750::setMTreg(byte MTreg) {
  *
  */
 bool BH1750::measurementReady(bool maxWait) {
+  // Wait for new measurement to be possible.
+  // Measurements have a maximum measurement time and a typical measurement
+  // time. The maxWait argument determines which measurement wait time is
+  // used when a one-time mode is being used. The typical (shorter)
+  // measurement time is used by default and if maxWait is set to True then
+  // the maximum measurement time will be used. See data sheet pages 2, 5
+  // and 7 for more details.
+  unsigned long currentTimestamp = millis();
+  if (currentTimestamp - lastReadTimestamp >= measurementTime(maxWait)) {
+    return true;
+  } else
+    return false;
+}
+
+/**
+ * Get the measurement time of the current mode and MTreg
+ * @param maxWait a boolean if to use the typical or maximum time
+ * @return the measurement time in milliseconds
+ */
+unsigned long BH1750::measurementTime(bool maxWait) {
   unsigned long delaytime = 0;
   switch (BH1750_MODE) {
     case BH1750::CONTINUOUS_HIGH_RES_MODE:
@@ -187,18 +207,7 @@ bool BH1750::measurementReady(bool maxWait) {
     default:
       break;
   }
-  // Wait for new measurement to be possible.
-  // Measurements have a maximum measurement time and a typical measurement
-  // time. The maxWait argument determines which measurement wait time is
-  // used when a one-time mode is being used. The typical (shorter)
-  // measurement time is used by default and if maxWait is set to True then
-  // the maximum measurement time will be used. See data sheet pages 2, 5
-  // and 7 for more details.
-  unsigned long currentTimestamp = millis();
-  if (currentTimestamp - lastReadTimestamp >= delaytime) {
-    return true;
-  } else
-    return false;
+  return delaytime;
 }
 
 /**
@@ -223,36 +232,137 @@ float BH1750::readLightLevel() {
   // value
   uint8_t buf[] = {0, 0};
   if (2 == Chip_I2C_MasterRead(I2C0, BH1750_I2CADDR, &buf[0], 2)) {
-    level = (float) (buf[0] << 8 | buf[1]);
+    level = convertLevel(buf[0] << 8 | buf[1]);
   }
   lastReadTimestamp = millis();
+  return level;
+}
+
+/**
+ * Start a measurement without waiting for it.
+ * A one time mode sends its mode command first, a continuous mode waits for
+ * the next measurement. Call poll() from the main loop until it returns true.
+ * @return true if the measurement was started,
+ *         false if one is still running or the sensor is not configured
+ */
+bool BH1750::startMeasurement() {
+  if (measureState != MEASURE_IDLE || BH1750_MODE == UNCONFIGURED) {
+    return false;
+  }
+
+  switch (BH1750_MODE) {
+    case BH1750::ONE_TIME_HIGH_RES_MODE:
+    case BH1750::ONE_TIME_HIGH_RES_MODE_2:
+    case BH1750::ONE_TIME_LOW_RES_MODE:
+      measureBuffer[0] = BH1750_MODE;
+      Chip_I2C_MasterSubmitXfer(I2C0, &measureReq, &measureXfer, BH1750_I2CADDR, &measureBuffer[0], 1, nullptr, 0);
+      measureState = MEASURE_COMMAND;
+      break;
+
+    default:
+      startConversionTimeout();
+      break;
+  }
+  return true;
+}
+
+/**
+ * Process the measurement started with startMeasurement(). Never waits.
+ * @return true once when the measurement is finished, successful or not
+ */
+bool BH1750::poll() {
+  switch (measureState) {
+    case MEASURE_COMMAND:
+      if (measureXfer.status == I2C_STATUS_BUSY) {
+        Chip_I2C_MasterCheckTimeout(I2C0);
+        return false;
+      }
+      if (measureXfer.status != I2C_STATUS_DONE) {
+        return finishMeasurement(-1.0f);
+      }
+      lastReadTimestamp = millis();
+      startConversionTimeout();
+      return false;
+
+    case MEASURE_CONVERSION:
+      if (measureTimeout.expired()) {
+        Chip_I2C_MasterSubmitXfer(I2C0, &measureReq, &measureXfer, BH1750_I2CADDR, nullptr, 0, measureBuffer, sizeof(measureBuffer));
+        measureState = MEASURE_READ;
+      }
+      return false;
+
+    case MEASURE_READ:
+      if (measureXfer.status == I2C_STATUS_BUSY) {
+        Chip_I2C_MasterCheckTimeout(I2C0);
+        return false;
+      }
+      lastReadTimestamp = millis();
+      if (measureXfer.status != I2C_STATUS_DONE) {
+        return finishMeasurement(-1.0f);
+      }
+      return finishMeasurement(convertLevel(measureBuffer[0] << 8 | measureBuffer[1]));
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * Light level of the last measurement finished by poll()
+ * @return Light level in lux like readLightLevel(), -1 : no valid value
+ */
+float BH1750::result() {
+  return measureLevel;
+}
+
+/**
+ * Wait for the maximum measurement time since the last read
+ */
+void BH1750::startConversionTimeout() {
+  unsigned long elapsed = millis() - lastReadTimestamp;
+  unsigned long delaytime = measurementTime(true);
+  measureTimeout.start(elapsed < delaytime ? delaytime - elapsed : 1);
+  measureState = MEASURE_CONVERSION;
+}
+
+bool BH1750::finishMeasurement(float level) {
+  measureLevel = level;
+  measureState = MEASURE_IDLE;
+  return true;
+}
+
+/**
+ * Convert a raw sensor value to lux
+ * @param raw the two bytes read from the sensor
+ * @return Light level in lux
+ */
+float BH1750::convertLevel(uint16_t raw) {
+  float level = (float) raw;
 
-  if (level != -1.0f) {
 // Print raw value if debug enabled
 #ifdef BH1750_DEBUG
-    LOG("[BH1750] Raw value: %d", pretty(level));
+  LOG("[BH1750] Raw value: %d", pretty(level));
 #endif
 
-    if (BH1750_MTreg != BH1750_DEFAULT_MTREG) {
-      level *= (float) ((byte) BH1750_DEFAULT_MTREG / (float) BH1750_MTreg);
-      // Print MTreg factor if debug enabled
+  if (BH1750_MTreg != BH1750_DEFAULT_MTREG) {
+    level *= (float) ((byte) BH1750_DEFAULT_MTREG / (float) BH1750_MTreg);
+    // Print MTreg factor if debug enabled
 #ifdef BH1750_DEBUG
-      LOG("[BH1750] MTreg factor: %d",
-          pretty((float)((byte)BH1750_DEFAULT_MTREG / (float)BH1750_MTreg)));
+    LOG("[BH1750] MTreg factor: %d",
+        pretty((float)((byte)BH1750_DEFAULT_MTREG / (float)BH1750_MTreg)));
 #endif
-    }
-    if (BH1750_MODE == BH1750::ONE_TIME_HIGH_RES_MODE_2 ||
-        BH1750_MODE == BH1750::CONTINUOUS_HIGH_RES_MODE_2) {
-      level /= 2;
-    }
-    // Convert raw value to lux
-    level /= BH1750_CONV_FACTOR;
+  }
+  if (BH1750_MODE == BH1750::ONE_TIME_HIGH_RES_MODE_2 ||
+      BH1750_MODE == BH1750::CONTINUOUS_HIGH_RES_MODE_2) {
+    level /= 2;
+  }
+  // Convert raw value to lux
+  level /= BH1750_CONV_FACTOR;
 
 // Print converted value if debug enabled
 #ifdef BH1750_DEBUG
-    LOG("[BH1750] Converted float value: %d", pretty(level));
+  LOG("[BH1750] Converted float value: %d", pretty(level));
 #endif
-  }
 
   return level;
 }
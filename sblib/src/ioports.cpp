@@ -15,18 +15,3 @@ const int portMask[12] =
     1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048
 };
 
-
-short getPinFunctionNumber(int pin, short func)
-{
-    pin >>= PF0_SHIFT;
-
-    for (int funcNumber = 0; funcNumber < 4; ++funcNumber)
-    {
-        if ((pin & PFF_MASK) == func)
-            return funcNumber;
-
-        pin >>= PFF_SHIFT_OFFSET;
-    }
-
-    return -1;
-}
@@ -15,6 +15,122 @@
 LcdGraphical::LcdGraphical(const Font& fnt, int width, int height)
 :fnt(&fnt)
 ,width(width)
-,height(height)
+,height(height < LCD_GRAPHICAL_MAX_PAGES ? height : LCD_GRAPHICAL_MAX_PAGES)
+,frame(0)
+,cursorX(0)
+,cursorY(0)
 {
 }
+
+void LcdGraphical::frameBuffer(byte* buffer)
+{
+    frame = buffer;
+    if (frame)
+    {
+        clearFrameBuffer();
+        cursorX = 0;
+        cursorY = 0;
+    }
+}
+
+void LcdGraphical::clearFrameBuffer()
+{
+    for (int i = width * height - 1; i >= 0; --i)
+        frame[i] = 0;
+
+    for (int page = 0; page < height; ++page)
+    {
+        dirtyStart[page] = 0;
+        dirtyEnd[page] = width;
+    }
+}
+
+void LcdGraphical::markDirty(int x, int page, int count)
+{
+    if (dirtyStart[page] >= dirtyEnd[page])
+    {
+        dirtyStart[page] = x;
+        dirtyEnd[page] = x + count;
+        return;
+    }
+
+    if (x < dirtyStart[page])
+        dirtyStart[page] = x;
+    if (x + count > dirtyEnd[page])
+        dirtyEnd[page] = x + count;
+}
+
+void LcdGraphical::flush()
+{
+    if (!frame)
+        return;
+
+    for (int page = 0; page < height; ++page)
+    {
+        int start = dirtyStart[page];
+        int end = dirtyEnd[page];
+        if (start >= end)
+            continue;
+
+        dirtyStart[page] = dirtyEnd[page] = 0;
+        writeColumns(start, page, frame + page * width + start, end - start);
+    }
+}
+
+void LcdGraphical::pixel(int x, int y, bool on)
+{
+    int page = y >> 3;
+    if (!frame || x < 0 || x >= width || y < 0 || page >= height)
+        return;
+
+    byte* col = frame + page * width + x;
+    byte bit = 1 << (y & 7);
+    if (((*col & bit) != 0) == on)
+        return;
+
+    *col ^= bit;
+    markDirty(x, page, 1);
+}
+
+int LcdGraphical::drawChar(byte ch)
+{
+    int idx = ch - fnt->firstChar;
+    if (idx < 0 || idx >= fnt->numChars)
+        return 0;
+
+    if (cursorY < 0 || cursorY >= height)
+        return 1;
+
+    const byte* glyph = (const byte*) fnt->data + idx * fnt->charWidth;
+    int x = cursorX;
+    int count = fnt->charWidth;
+    cursorX += count;
+
+    if (x < 0)
+    {
+        glyph -= x;
+        count += x;
+        x = 0;
+    }
+    if (x + count > width)
+        count = width - x;
+    if (count <= 0)
+        return 1;
+
+    byte* col = frame + cursorY * width + x;
+    int first = -1, last = -1;
+    for (int i = 0; i < count; ++i)
+    {
+        if (col[i] != glyph[i])
+        {
+            col[i] = glyph[i];
+            if (first < 0)
+                first = i;
+            last = i;
+        }
+    }
+
+    if (first >= 0)
+        markDirty(x + first, cursorY, last - first + 1);
+    return 1;
+}
@@ -94,6 +94,7 @@ LcdGraphicalEADOGS::LcdGraphicalEADOGS(int spiPort, int pinData, int pinClock, i
 ,spi(spiPort)
 ,pinCD(pinCD)
 ,pinCS(pinCS)
+,transferring(false)
 {
     pinMode(pinData,  OUTPUT | SPI_MOSI);
     pinMode(pinClock, OUTPUT | SPI_CLOCK);
@@ -138,25 +139,66 @@ void LcdGraphicalEADOGS::begin()
 
 void LcdGraphicalEADOGS::end()
 {
+    waitTransfer();
     spi.end();
 }
 
+void LcdGraphicalEADOGS::waitTransfer()
+{
+    if (!transferring)
+        return;
+
+    while (!spi.finished)
+        ;
+    // Wait until the last byte is received, which means that it was sent too
+    spi.finalizeBlockTransfer();
+    transferring = false;
+}
+
 void LcdGraphicalEADOGS::inverse(bool enable)
 {
+    waitTransfer();
     digitalWrite(pinCD, 0);
     spi.transfer(enable ? CMD_DISP_INVERSE : CMD_DISP_NORMAL);
 }
 
-void LcdGraphicalEADOGS::pos(int x, int y)
+void LcdGraphicalEADOGS::address(int x, int y)
 {
+    waitTransfer();
     digitalWrite(pinCD, 0);
     spi.transfer(CMD_COL_ADDR_LSB | (x & 15));
     spi.transfer(CMD_COL_ADDR_MSB | ((x >> 4) & 15));
     spi.transfer(CMD_PAGE_ADDR | (y & 7));
 }
 
+void LcdGraphicalEADOGS::pos(int x, int y)
+{
+    cursorX = x;
+    cursorY = y;
+
+    if (!frame)
+        address(x, y);
+}
+
+void LcdGraphicalEADOGS::writeColumns(int x, int page, const byte* data, int count)
+{
+    address(x, page);
+
+    for (int i = 0; i < count; ++i)
+        transferBuffer[i] = data[i];
+
+    digitalWrite(pinCD, 1);
+    spi.transferBlock(transferBuffer, count, 0, true);
+    transferring = true;
+}
+
 int LcdGraphicalEADOGS::write(byte ch)
 {
+    if (frame)
+        return drawChar(ch);
+
+    waitTransfer();
+
     int idx = ch - fnt->firstChar;
     if (idx < 0 || idx >= fnt->numChars)
         return 0;
@@ -174,6 +216,13 @@ void LcdGraphicalEADOGS::clear()
 {
     int x, y;
 
+    if (frame)
+    {
+        clearFrameBuffer();
+        pos(0, 0);
+        return;
+    }
+
     for (y = 0; y < DISPLAY_HEIGHT; ++y)
     {
         pos(0, y);
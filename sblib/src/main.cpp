@@ -33,6 +33,7 @@ static inline void lib_setup()
 /**
  * @brief The main of the Selfbus library.
  *        Calls setup(), loop() and optional loop_noapp() from the application.
+ *        With SLEEP_WHEN_IDLE it sleeps in between until an interrupt or the next deadline of the BCU.
  *
  * @return will never return
  */
@@ -48,5 +49,9 @@ int main()
             loop();
         else
             loop_noapp();
+
+#ifdef SLEEP_WHEN_IDLE
+        sleepUntilInterrupt(bcu->idleTime());
+#endif
     }
 }
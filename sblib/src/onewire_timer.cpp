@@ -0,0 +1,336 @@
+/*
+ *  onewire_timer.cpp - Timer driven, non-blocking 1-Wire operations
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/core.h>
+#include <sblib/digital_pin.h>
+#include <sblib/timer.h>
+
+#include <sblib/onewire.h>
+
+// Timing of the steps in microseconds, the same as the blocking functions use
+#define OW_RESET_LOW_US          480   // Reset pulse
+#define OW_PRESENCE_WAIT_US      70    // Release until the presence pulse is sampled
+#define OW_RESET_END_US          410   // Rest of the reset cycle
+#define OW_WRITE1_LOW_US         10    // Low time of a 1 bit, busy waited
+#define OW_WRITE1_END_US         55    // Rest of a 1 bit slot
+#define OW_WRITE0_LOW_US         65    // Low time of a 0 bit
+#define OW_WRITE0_END_US         5     // Recovery after a 0 bit
+#define OW_READ_LOW_US           3     // Low time of a read slot, busy waited
+#define OW_READ_SAMPLE_US        10    // Release until the bit is sampled, busy waited
+#define OW_READ_END_US           53    // Rest of a read slot
+#define OW_START_US              2     // Delay until a newly queued operation starts
+
+/*****************************************************************************
+** Function name:  OneWireTimerInit
+**
+** Descriptions:   Use the timer for the queued operations. The timer is
+**                 used exclusively and ticks with 1us. Its interrupt handler
+**                 must be created with ONEWIRE_TIMER_INTERRUPT_HANDLER.
+**
+** parameters:     timer, e.g. timer32_0
+**
+** Returned value: none
+**
+*****************************************************************************/
+void OneWire::OneWireTimerInit(Timer& timer)
+{
+  this->_timer = &timer;
+  this->_queueHead = this->_queueTail = 0;
+  this->_bActive = false;
+  this->_bFailed = false;
+  this->_phase = 0;
+  this->_bitMask = 1;
+  this->_byteIdx = 0;
+
+  timer.begin();
+  timer.prescaler(SystemCoreClock / 1000000 - 1);
+  timer.matchMode(MAT0, INTERRUPT | RESET | STOP); // one shot
+  timer.resetFlags();
+  // Lower priority than the bus timer. The busy waits of the read and write-1 slots
+  // must not delay the bus timing.
+  timer.setIRQPriority(1);
+  timer.interrupts();
+}
+
+/*****************************************************************************
+** Function name:  OneWireTimerInterruptHandler
+**
+** Descriptions:   Process the next step of the queued operations and start the
+**                 timer for the step after it.
+**
+** parameters:     none
+**
+** Returned value: none
+**
+*****************************************************************************/
+void OneWire::OneWireTimerInterruptHandler()
+{
+  this->_timer->resetFlag(MAT0);
+
+  unsigned int usec = 0;
+  while (!usec && this->_queueTail != this->_queueHead)
+  {
+    usec = this->OneWireStep();
+  }
+
+  if (usec) this->OneWireSchedule(usec);
+  else this->_bActive = false;
+}
+
+/*
+ * Process one step of the current operation. Returns the time until the next
+ * step, or 0 to continue with the next operation at once.
+ */
+unsigned int OneWire::OneWireStep()
+{
+  OneWireOp& op = this->_queue[this->_queueTail];
+
+  if (this->_bFailed && op.type != OP_CALLBACK)
+  {
+    this->OneWireNextOp();
+    return 0;
+  }
+
+  switch (op.type)
+  {
+  case OP_RESET:
+    if (this->_phase == 0)
+    {
+      this->OneWireRelease();
+      if (!digitalRead(this->_pin)) // bus shorted
+      {
+        this->_bFailed = true;
+        this->OneWireNextOp();
+        return 0;
+      }
+      pinMode(this->_pin, OUTPUT);      // drive output low
+      digitalWrite(this->_pin, 0);
+      this->_phase = 1;
+      return OW_RESET_LOW_US;
+    }
+    if (this->_phase == 1)
+    {
+      this->OneWireRelease();           // allow it to float
+      this->_phase = 2;
+      return OW_PRESENCE_WAIT_US;
+    }
+    if (digitalRead(this->_pin)) this->_bFailed = true; // no presence pulse
+    this->OneWireNextOp();
+    return OW_RESET_END_US;
+
+  case OP_WRITE:
+    {
+      uint8_t bit = op.txData[this->_byteIdx] & this->_bitMask;
+      unsigned int usec;
+      if (this->_phase == 0)
+      {
+        pinMode(this->_pin, OUTPUT);    // drive output low
+        digitalWrite(this->_pin, 0);
+        if (!bit)
+        {
+          this->_phase = 1;
+          return OW_WRITE0_LOW_US;
+        }
+        delayMicroseconds(OW_WRITE1_LOW_US);
+        digitalWrite(this->_pin, 1);    // drive output high
+        usec = OW_WRITE1_END_US;
+      }
+      else
+      {
+        digitalWrite(this->_pin, 1);    // drive output high
+        this->_phase = 0;
+        usec = OW_WRITE0_END_US;
+      }
+
+      this->_bitMask <<= 1;
+      if (!this->_bitMask)
+      {
+        this->_bitMask = 1;
+        if (++this->_byteIdx >= op.count)
+        {
+          if (!this->m_bParasitePowerMode)
+          {
+            pinMode(this->_pin, INPUT);
+#if !(ONEWIRE_INTERNAL_PULLUP)
+            digitalWrite(this->_pin, 0);
+#endif
+          }
+          this->OneWireNextOp();
+        }
+      }
+      return usec;
+    }
+
+  case OP_READ:
+    pinMode(this->_pin, OUTPUT);
+    digitalWrite(this->_pin, 0);
+    delayMicroseconds(OW_READ_LOW_US);
+    this->OneWireRelease();             // let pin float, pull up will raise
+    delayMicroseconds(OW_READ_SAMPLE_US);
+    if (this->_bitMask == 1) op.rxData[this->_byteIdx] = 0;
+    if (digitalRead(this->_pin)) op.rxData[this->_byteIdx] |= this->_bitMask;
+
+    this->_bitMask <<= 1;
+    if (!this->_bitMask)
+    {
+      this->_bitMask = 1;
+      if (++this->_byteIdx >= op.count) this->OneWireNextOp();
+    }
+    return OW_READ_END_US;
+
+  case OP_DEPOWER:
+    pinMode(this->_pin, INPUT);
+    digitalWrite(this->_pin, 0);        // disable pull-up too
+    this->OneWireNextOp();
+    return 0;
+
+  default: // OP_CALLBACK
+    {
+      bool bSuccess = !this->_bFailed;
+      this->_bFailed = false;
+      OneWireCallback callback = op.callback;
+      void *context = op.context;
+      this->OneWireNextOp();
+      if (callback) callback(context, bSuccess);
+      return 0;
+    }
+  }
+}
+
+/*
+ * Finish the current operation.
+ */
+void OneWire::OneWireNextOp()
+{
+  this->_phase = 0;
+  this->_bitMask = 1;
+  this->_byteIdx = 0;
+  this->_queueTail = (this->_queueTail + 1) % ONEWIRE_QUEUE_SIZE;
+}
+
+/*
+ * Start the timer to call the interrupt handler after usec microseconds.
+ */
+void OneWire::OneWireSchedule(unsigned int usec)
+{
+  this->_timer->match(MAT0, usec);
+  this->_timer->restart();
+}
+
+/*
+ * Let the bus float.
+ */
+void OneWire::OneWireRelease()
+{
+  pinMode(this->_pin, INPUT | PULL_UP);
+#if ONEWIRE_INTERNAL_PULLUP
+  digitalWrite(this->_pin, 1);          // enable pull-up resistor
+#endif
+}
+
+/*
+ * Get the next free queue entry, or nullptr if the queue is full.
+ */
+OneWireOp* OneWire::OneWireQueueEntry(uint8_t type, uint8_t count)
+{
+  uint8_t next = (this->_queueHead + 1) % ONEWIRE_QUEUE_SIZE;
+  if (next == this->_queueTail || !this->_timer) return nullptr;
+
+  OneWireOp *op = &this->_queue[this->_queueHead];
+  op->type = type;
+  op->count = count;
+  op->txData = nullptr;
+  op->context = nullptr;
+  return op;
+}
+
+/*
+ * Append the entry filled after OneWireQueueEntry() to the queue and start the
+ * timer if it is not running.
+ */
+bool OneWire::OneWireQueueCommit()
+{
+  this->_queueHead = (this->_queueHead + 1) % ONEWIRE_QUEUE_SIZE;
+
+  if (!this->_bActive)
+  {
+    this->_bActive = true;
+    this->OneWireSchedule(OW_START_US);
+  }
+  return true;
+}
+
+uint8_t OneWire::OneWireQueueSpace() const
+{
+  return (this->_queueTail + ONEWIRE_QUEUE_SIZE - this->_queueHead - 1) % ONEWIRE_QUEUE_SIZE;
+}
+
+bool OneWire::OneWireQueueReset()
+{
+  if (!this->OneWireQueueEntry(OP_RESET, 0)) return false;
+  return this->OneWireQueueCommit();
+}
+
+bool OneWire::OneWireQueueWrite(uint8_t v)
+{
+  OneWireOp *op = this->OneWireQueueEntry(OP_WRITE, 1);
+  if (!op) return false;
+  op->value = v;
+  op->txData = &op->value;
+  return this->OneWireQueueCommit();
+}
+
+bool OneWire::OneWireQueueWriteBytes(const uint8_t *buf, uint8_t count)
+{
+  if (!count) return true;
+  OneWireOp *op = this->OneWireQueueEntry(OP_WRITE, count);
+  if (!op) return false;
+  op->txData = buf;
+  return this->OneWireQueueCommit();
+}
+
+bool OneWire::OneWireQueueRead(uint8_t *dest)
+{
+  return this->OneWireQueueReadBytes(dest, 1);
+}
+
+bool OneWire::OneWireQueueReadBytes(uint8_t *buf, uint8_t count)
+{
+  if (!count) return true;
+  OneWireOp *op = this->OneWireQueueEntry(OP_READ, count);
+  if (!op) return false;
+  op->rxData = buf;
+  return this->OneWireQueueCommit();
+}
+
+bool OneWire::OneWireQueueSelect(const uint8_t rom[8])
+{
+  if (this->OneWireQueueSpace() < 2) return false;
+  this->OneWireQueueWrite(0x55);        // Choose ROM
+  return this->OneWireQueueWriteBytes(rom, 8);
+}
+
+bool OneWire::OneWireQueueSkip()
+{
+  return this->OneWireQueueWrite(0xCC); // Skip ROM
+}
+
+bool OneWire::OneWireQueueDePower()
+{
+  if (!this->OneWireQueueEntry(OP_DEPOWER, 0)) return false;
+  return this->OneWireQueueCommit();
+}
+
+bool OneWire::OneWireQueueCallback(OneWireCallback callback, void *context)
+{
+  OneWireOp *op = this->OneWireQueueEntry(OP_CALLBACK, 0);
+  if (!op) return false;
+  op->callback = callback;
+  op->context = context;
+  return this->OneWireQueueCommit();
+}
@@ -0,0 +1,177 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_PROFILER Run-time profiler
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Lightweight cycle accurate profiler for the main loop and interrupt handlers
+ *
+ * @{
+ *
+ * @file   profiler.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <sblib/profiler.h>
+#include <sblib/platform.h>
+#include <sblib/timer.h>
+#include <sblib/print.h>
+#include <string.h>
+
+static ProfileStats profileStats[PROFILE_PROBE_COUNT];
+
+static const char* const profileProbeNames[PROFILE_PROBE_COUNT] =
+{
+    "BcuLoop",
+    "processTelegram",
+    "sendNextGroupTel",
+    "flushUserMemory",
+    "BusTimerISR",
+    "user0",
+    "user1",
+    "user2",
+    "user3"
+};
+
+uint32_t profilerCycles()
+{
+    unsigned int ms;
+    unsigned int val;
+    const unsigned int load = SysTick->LOAD;
+
+    // Re-read in case the SysTick_Handler incremented the system time in between
+    do
+    {
+        ms = millis();
+        val = SysTick->VAL;
+    } while (ms != millis());
+
+    // The counter reloaded, but the SysTick_Handler did not run yet (e.g. we are called
+    // from an interrupt with a higher priority). A high counter value tells that the
+    // reload happened before reading it.
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && (val > (load >> 1)))
+    {
+        ms++;
+    }
+
+    return (ms * (load + 1)) + (load - val);
+}
+
+void profilerRecord(ProfileProbe probe, uint32_t cycles)
+{
+    ProfileStats& stats = profileStats[probe];
+
+    if (!stats.count || cycles < stats.minCycles)
+    {
+        stats.minCycles = cycles;
+    }
+    if (cycles > stats.maxCycles)
+    {
+        stats.maxCycles = cycles;
+    }
+    stats.count++;
+    stats.sumCycles += cycles;
+
+    // Cortex-M0 has no CLZ instruction, so shift to find the bucket
+    unsigned int bucket = 0;
+    cycles >>= PROFILE_HISTOGRAM_SHIFT + 1;
+    while (cycles && bucket < PROFILE_HISTOGRAM_BUCKETS - 1)
+    {
+        cycles >>= 1;
+        bucket++;
+    }
+    if (stats.histogram[bucket] != 0xffff)
+    {
+        stats.histogram[bucket]++;
+    }
+}
+
+void profilerReset()
+{
+    memset(profileStats, 0, sizeof(profileStats));
+}
+
+const ProfileStats& profilerStats(ProfileProbe probe)
+{
+    return profileStats[probe];
+}
+
+static uint32_t averageCycles(const ProfileStats& stats)
+{
+    if (!stats.count)
+    {
+        return 0;
+    }
+    return (uint32_t)(stats.sumCycles / stats.count);
+}
+
+void profilerDump(Print& out)
+{
+    const int cyclesPerMicrosecond = clockCyclesPerMicrosecond();
+
+    out.println("Profile (us)     count      min      avg      max  histogram");
+    for (int i = 0; i < PROFILE_PROBE_COUNT; i++)
+    {
+        const ProfileStats& stats = profileStats[i];
+        if (!stats.count)
+        {
+            continue;
+        }
+
+        out.print(profileProbeNames[i]);
+        for (int pad = strlen(profileProbeNames[i]); pad < 16; pad++)
+        {
+            out.print(' ');
+        }
+        out.print((int)stats.count, DEC, 6);
+        out.print(" ");
+        out.print((int)(stats.minCycles / cyclesPerMicrosecond), DEC, 8);
+        out.print(" ");
+        out.print((int)(averageCycles(stats) / cyclesPerMicrosecond), DEC, 8);
+        out.print(" ");
+        out.print((int)(stats.maxCycles / cyclesPerMicrosecond), DEC, 8);
+        out.print(" ");
+        for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; bucket++)
+        {
+            out.print(" ");
+            out.print((int)stats.histogram[bucket]);
+        }
+        out.println();
+    }
+}
+
+static byte* putLong(byte* buffer, uint32_t value)
+{
+    buffer[0] = value >> 24;
+    buffer[1] = value >> 16;
+    buffer[2] = value >> 8;
+    buffer[3] = value;
+    return buffer + 4;
+}
+
+int profilerRead(ProfileProbe probe, byte* buffer, int maxLen)
+{
+    if ((probe >= PROFILE_PROBE_COUNT) || (maxLen < PROFILE_SERIALIZED_SIZE))
+    {
+        return 0;
+    }
+
+    const ProfileStats& stats = profileStats[probe];
+    byte* pos = buffer;
+    pos = putLong(pos, stats.count);
+    pos = putLong(pos, stats.minCycles);
+    pos = putLong(pos, stats.maxCycles);
+    pos = putLong(pos, averageCycles(stats));
+    for (int bucket = 0; bucket < PROFILE_HISTOGRAM_BUCKETS; bucket++)
+    {
+        *pos++ = stats.histogram[bucket] >> 8;
+        *pos++ = stats.histogram[bucket];
+    }
+    return pos - buffer;
+}
+
+/** @}*/
@@ -11,6 +11,7 @@
 #include <math.h>
 #include <sblib/core.h>
 #include <sblib/digital_pin.h>
+#include <sblib/timer.h>
 
 #include <sblib/sensors/dht.h>
 
@@ -125,10 +126,27 @@ bool DHT::readData(bool bForceRead)
   // Check we read 40 bits and that the checksum matches.
   if(this->_lastError != ERROR_NONE) return bRet;
 
+  bRet= this->decodeData();
+  return bRet;
+}
+
+/*****************************************************************************
+** Function name:  decodeData
+**
+** Descriptions:   Check the checksum of DHT_data and convert it to
+**                 _lastTemperature and _lastHumidity
+**
+** parameters:     none
+**
+** Returned value: true on success, false on checksum error.
+**
+*****************************************************************************/
+bool DHT::decodeData()
+{
   if(this->DHT_data[4] != ((unsigned)(this->DHT_data[0] + this->DHT_data[1] + this->DHT_data[2] + this->DHT_data[3]) & 0xFF))
   {
     this->_lastError = ERROR_CHECKSUM;
-    return bRet;
+    return false;
   }
   if (this->_DHTtype == DHT22) {
     if (this->DHT_data[2] & 0x80) {
@@ -148,8 +166,7 @@ bool DHT::readData(bool bForceRead)
   this->_lastTemperature = this->_lastTemperature/100;
   this->_lastHumidity = this->_lastHumidity/100;
 
-  bRet= true;
-  return bRet;
+  return true;
 }
 
 /*****************************************************************************
@@ -230,3 +247,179 @@ float DHT::CalcdewPoint(float celsius, float humidity)
   return (241.88 * T) / (17.558-T);
 }
 */
+
+// Capture based reading
+#define DHT22_START_PULSE_US  1100     // Start pulse of a DHT22
+#define DHT11_START_PULSE_US  20000    // Start pulse of a DHT11
+#define DHT_TIMEOUT_US        10000    // Whole answer of the sensor, it takes about 5ms
+#define DHT_BIT_THRESHOLD_US  100      // Falling edge to falling edge: ~78us for a 0 bit, ~120us for a 1 bit
+#define DHT_EDGES             42       // Response, 40 bits and the end of the last bit
+
+enum eReadState {
+  READ_IDLE,
+  READ_START_PULSE,
+  READ_RECEIVING,
+  READ_DONE
+};
+
+/*****************************************************************************
+** Function name:  DHTTimerInit
+**
+** Descriptions:   Use the timer for the non-blocking read. Call it after
+**                 DHTInit(). The timer only runs while reading, at most
+**                 30ms, so a 16 bit timer does not overflow.
+**
+** parameters:     timer, e.g. timer32_0 and its capture channel of the pin,
+**                 e.g. CAP0
+**
+** Returned value: none
+**
+*****************************************************************************/
+void DHT::DHTTimerInit(Timer& timer, int captureChannel)
+{
+  this->_timer = &timer;
+  this->_captureChannel = captureChannel;
+  this->_readState = READ_IDLE;
+
+  timer.begin();
+  timer.prescaler(SystemCoreClock / 1000000 - 1);
+  timer.captureMode(captureChannel, DISABLE);
+  timer.matchMode(MAT0, DISABLE);
+  timer.resetFlags();
+  // Lower priority than the bus timer. The edges are time stamped by the capture
+  // hardware, so a delayed interrupt does not change the measured pulse lengths.
+  timer.setIRQPriority(1);
+  timer.interrupts();
+}
+
+/*****************************************************************************
+** Function name:  startReadData
+**
+** Descriptions:   Start a non-blocking read by driving the start pulse. The
+**                 timer interrupt ends it and receives the answer.
+**
+** parameters:     bForceRead, to ignore the internal DHT TIMER
+**
+** Returned value: true if the read was started.
+**                 false if not. Check _lastError for reason.
+**
+*****************************************************************************/
+bool DHT::startReadData(bool bForceRead)
+{
+  if (!this->_timer || this->_readState != READ_IDLE) {
+    this->_lastError = BUS_BUSY;
+    return false;
+  }
+
+  int currenttime = millis();
+  if (!bForceRead && ((currenttime - this->_lastReadTime) < 2000)) {
+    this->_lastError= ERROR_TIMER_NOT_REACHED;
+    return false;
+  }
+
+  this->_lastReadTime = currenttime;
+  this->_lastError = BUS_BUSY;
+  this->DHT_data[0]=this->DHT_data[1]=this->DHT_data[2]=this->DHT_data[3]=this->DHT_data[4]=0;
+  this->_edgeCount = 0;
+  this->_readState = READ_START_PULSE;
+
+  // Set data line low, the match interrupt ends the start pulse
+  pinMode(_pin, OUTPUT);
+  digitalWrite(_pin, 0);
+  unsigned int startPulse = (this->_DHTtype == DHT22) ? DHT22_START_PULSE_US : DHT11_START_PULSE_US;
+  this->_timer->match(MAT0, startPulse);
+  this->_timer->matchMode(MAT0, INTERRUPT);
+  this->_timer->restart();
+  return true;
+}
+
+/*****************************************************************************
+** Function name:  DHTTimerInterruptHandler
+**
+** Descriptions:   End the start pulse, decode the captured falling edges and
+**                 handle the timeout.
+**
+** parameters:     none
+**
+** Returned value: none
+**
+*****************************************************************************/
+void DHT::DHTTimerInterruptHandler()
+{
+  Timer& timer = *this->_timer;
+  TimerCapture cap = (TimerCapture) this->_captureChannel;
+
+  if (timer.flag(cap)) {
+    timer.resetFlag(cap);
+    uint16_t edge = timer.capture(cap);
+    uint8_t n = this->_edgeCount++;
+
+    // edge 0 starts the response, edge 1 the first bit, every further edge ends a bit
+    if (n >= 2) {
+      uint8_t i = n - 2;
+      this->DHT_data[i / 8] <<= 1;
+      if ((uint16_t)(edge - this->_lastEdge) > DHT_BIT_THRESHOLD_US) {
+        this->DHT_data[i / 8] |= 1;
+      }
+    }
+    this->_lastEdge = edge;
+
+    if (this->_edgeCount >= DHT_EDGES) {
+      timer.captureMode(this->_captureChannel, DISABLE);
+      timer.matchMode(MAT0, DISABLE);
+      timer.stop();
+      this->_readState = READ_DONE;
+    }
+  }
+
+  if (timer.flag(MAT0)) {
+    timer.resetFlag(MAT0);
+    if (this->_readState == READ_START_PULSE) {
+      // End the start signal and receive the answer
+      digitalWrite(_pin, 1);
+      pinMode(_pin, INPUT_CAPTURE | PULL_UP);
+      timer.captureMode(this->_captureChannel, FALLING_EDGE | INTERRUPT);
+      timer.match(MAT0, timer.value() + DHT_TIMEOUT_US);
+      this->_readState = READ_RECEIVING;
+    } else if (this->_readState == READ_RECEIVING) {
+      timer.captureMode(this->_captureChannel, DISABLE);
+      timer.matchMode(MAT0, DISABLE);
+      timer.stop();
+      this->_readState = READ_DONE;
+    }
+  }
+}
+
+/*****************************************************************************
+** Function name:  finishReadData
+**
+** Descriptions:   Check for the end of a non-blocking read and convert the
+**                 received data.
+**
+** parameters:     none
+**
+** Returned value: true once after a successful read. Check: _lastHumidity
+**                 and _lastTemperature.
+**                 false if no read finished or on error. Check _lastError
+**                 for reason, it is BUS_BUSY while reading.
+**
+*****************************************************************************/
+bool DHT::finishReadData()
+{
+  if (this->_readState != READ_DONE) return false;
+
+  pinMode(_pin, INPUT | PULL_UP);
+  this->_readState = READ_IDLE;
+
+  if (this->_edgeCount == 0) {
+    this->_lastError = ERROR_NOT_PRESENT;
+    return false;
+  }
+  if (this->_edgeCount < DHT_EDGES) {
+    this->_lastError = ERROR_DATA_TIMEOUT;
+    return false;
+  }
+
+  this->_lastError = ERROR_NONE;
+  return this->decodeData();
+}
@@ -84,6 +84,7 @@ uint8_t DS18x20::Search(uint8_t uMaxDeviceSearch)
       {
         sDevTmp.res_type= (sDevTmp.type == DS18S20)? 1: 0;
         sDevTmp.conversionStarted = false;
+        sDevTmp.asyncState = DS_ASYNC_IDLE;
         this->m_dsDev[j]= sDevTmp;
         this->m_foundDevices++;
         bRet= 0; // Found one or more devices!
@@ -141,6 +142,16 @@ bool DS18x20::readResult(int deviceIdx)
     sDev->data[i] = this->_OW_DS18x.OneWireRead();
   }
 
+  this->convertScratchpad(sDev);
+  sDev->conversionStarted = false;
+  return true;
+}
+
+/*
+ * Convert the scratchpad in sDev->data to the temperature.
+ */
+void DS18x20::convertScratchpad(sDS18x20* sDev)
+{
   // Convert the data to actual temperature because the result is a 16 bit
   // signed integer, it should be stored to an "int16_t" type, which is always
   // 16 bits even when compiled on a 32 bit processor.
@@ -166,8 +177,6 @@ bool DS18x20::readResult(int deviceIdx)
   if( sDev->lastReadOK ) {
       sDev->last_temperature= sDev->current_temperature;
   }
-  sDev->conversionStarted = false;
-  return true;
 }
 
 bool DS18x20::lastReadOk(int deviceIdx)
@@ -268,3 +277,151 @@ float DS18x20::ConvertTemperature(float fTemperature, eScale Scale)
   else if (Scale == KELVIN) return (float)(fTemperature + 273.15f);
   else return fTemperature;
 }
+
+/*****************************************************************************
+** Function name:  DS18x20TimerInit
+**
+** Descriptions:   Use the timer for the non-blocking functions.
+**
+** parameters:     timer, e.g. timer32_0
+**
+** Returned value: none
+**
+*****************************************************************************/
+void DS18x20::DS18x20TimerInit(Timer& timer)
+{
+  this->_OW_DS18x.OneWireTimerInit(timer);
+}
+
+void DS18x20::DS18x20TimerInterruptHandler()
+{
+  this->_OW_DS18x.OneWireTimerInterruptHandler();
+}
+
+bool DS18x20::asyncBusy()
+{
+  return this->_OW_DS18x.OneWireBusy();
+}
+
+/*
+ * Called from the timer interrupt when the conversion command was sent.
+ */
+void DS18x20::conversionStartedCallback(void* context, bool bSuccess)
+{
+  if (bSuccess) return;
+
+  DS18x20* ds = (DS18x20*) context;
+  for (uint8_t j = 0; j < ds->m_foundDevices; j++)
+  {
+    ds->m_dsDev[j].conversionStarted = false;
+  }
+}
+
+/*
+ * Called from the timer interrupt when the scratchpad of a device was read.
+ */
+void DS18x20::readDoneCallback(void* context, bool bSuccess)
+{
+  sDS18x20* sDev = (sDS18x20*) context;
+  sDev->asyncState = bSuccess ? DS_ASYNC_DONE : DS_ASYNC_FAILED;
+}
+
+/*****************************************************************************
+** Function name:  startConversionAllAsync
+**
+** Descriptions:   Queues the temperature conversion of all devices with a
+**                 single Skip ROM command.
+**
+** Returned value: true, if the conversion was queued.
+**
+*****************************************************************************/
+bool DS18x20::startConversionAllAsync()
+{
+  if (!this->m_foundDevices || this->_OW_DS18x.OneWireQueueSpace() < 4) return false;
+
+  // set before queueing, a failing reset clears it from the interrupt
+  unsigned int readyAt = millis() + leadTime;
+  for (uint8_t j = 0; j < this->m_foundDevices; j++)
+  {
+    this->m_dsDev[j].conversionStarted = true;
+    this->m_dsDev[j].readyAt = readyAt;
+  }
+
+  this->_OW_DS18x.OneWireQueueReset();
+  this->_OW_DS18x.OneWireQueueSkip();
+  this->_OW_DS18x.OneWireQueueWrite(0x44); // start conversion, with parasite power on at the end
+  this->_OW_DS18x.OneWireQueueCallback(conversionStartedCallback, this);
+  return true;
+}
+
+/*****************************************************************************
+** Function name:  readResultAllAsync
+**
+** Descriptions:   Queues the scratchpad read of every device whose conversion
+**                 is ready, as far as the queue has space.
+**
+** Returned value: true, if one or more reads were queued.
+**
+*****************************************************************************/
+bool DS18x20::readResultAllAsync()
+{
+  bool bRet = false;
+  uint8_t uOps = this->_OW_DS18x.IsParasiteMode() ? 7 : 6;
+
+  for (uint8_t j = 0; j < this->m_foundDevices; j++)
+  {
+    sDS18x20* sDev = &this->m_dsDev[j];
+    if (!sDev->conversionStarted || (int)(millis() - sDev->readyAt) < 0 || sDev->asyncState != DS_ASYNC_IDLE)
+      continue;
+    if (this->_OW_DS18x.OneWireQueueSpace() < uOps)
+      break;
+
+    sDev->conversionStarted = false;
+    sDev->asyncState = DS_ASYNC_QUEUED;
+    this->_OW_DS18x.OneWireQueueReset();
+    this->_OW_DS18x.OneWireQueueSelect(sDev->addr);
+    this->_OW_DS18x.OneWireQueueWrite(0xBE); // Read Scratchpad
+    if (this->_OW_DS18x.IsParasiteMode()) this->_OW_DS18x.OneWireQueueDePower();
+    this->_OW_DS18x.OneWireQueueReadBytes(sDev->data, 9);
+    this->_OW_DS18x.OneWireQueueCallback(readDoneCallback, sDev);
+    bRet = true;
+  }
+  return bRet;
+}
+
+/*****************************************************************************
+** Function name:  processResults
+**
+** Descriptions:   Converts the finished scratchpad reads to temperatures.
+**
+** Returned value: true, if one or more devices were read successfully.
+**
+*****************************************************************************/
+bool DS18x20::processResults()
+{
+  bool bRet = false;
+
+  for (uint8_t j = 0; j < this->m_foundDevices; j++)
+  {
+    sDS18x20* sDev = &this->m_dsDev[j];
+    if (sDev->asyncState == DS_ASYNC_DONE)
+    {
+#if ONEWIRE_CRC
+      sDev->crcOK = (OneWire::OneWireCRC8(sDev->data, 8) == sDev->data[8]);
+      if (!sDev->crcOK)
+      {
+        sDev->lastReadOK = false;
+        sDev->asyncState = DS_ASYNC_IDLE;
+        continue;
+      }
+#endif
+      this->convertScratchpad(sDev);
+      bRet = bRet || sDev->lastReadOK;
+    }
+    if (sDev->asyncState != DS_ASYNC_QUEUED)
+    {
+      sDev->asyncState = DS_ASYNC_IDLE;
+    }
+  }
+  return bRet;
+}
@@ -216,18 +216,9 @@ void Serial::interruptHandler()
         }
     }
 
+    // if the readBuffer is full, the byte is dropped to empty the UART
     while (LPC_UART->LSR & LSR_RDR)
     {
-        if (!readBufferFull())
-        {
-            readBuffer[readTail] = LPC_UART->RBR;
-
-            ++readTail;
-            readTail &= BufferedStream::BUFFER_SIZE_MASK;
-        }
-        else
-        {
-            LPC_UART->RBR; // if the readBuffer ist full, empty UART
-        }
+        received(LPC_UART->RBR);
     }
 }
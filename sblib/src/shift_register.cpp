@@ -0,0 +1,130 @@
+/*
+ *  shift_register.cpp - Chain of shift registers on a SPI port
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/shift_register.h>
+
+#include <sblib/digital_pin.h>
+
+
+ShiftRegisterChain::ShiftRegisterChain(int spiPort, int pinData, int pinClock, int pinLatch, int length)
+:spi(spiPort, SPI_CPOL_LOW | SPI_CPHASE_RAISE)
+,pinLatch(pinLatch)
+,length(length < SHIFT_REGISTER_MAX_LENGTH ? length : SHIFT_REGISTER_MAX_LENGTH)
+,dirty(true)
+,transferring(false)
+{
+    for (int i = 0; i < SHIFT_REGISTER_MAX_LENGTH; ++i)
+        image[i] = 0;
+
+    pinMode(pinData,  OUTPUT | SPI_MOSI);
+    pinMode(pinClock, OUTPUT | SPI_CLOCK);
+    pinMode(pinLatch, OUTPUT);
+    digitalWrite(pinLatch, 0);
+}
+
+void ShiftRegisterChain::begin(int clockDiv)
+{
+    spi.setClockDivider(clockDiv);
+    spi.setDataSize(length & 1 ? SPI_DATA_8BIT : SPI_DATA_16BIT);
+    spi.begin();
+
+    for (int i = 0; i < length; ++i)
+        image[i] = 0;
+    dirty = true;
+    update();
+}
+
+void ShiftRegisterChain::end()
+{
+    wait();
+    spi.end();
+}
+
+void ShiftRegisterChain::set(int output, bool value)
+{
+    byte& reg = image[output >> 3];
+    byte mask = 1 << (output & 7);
+
+    if (((reg & mask) != 0) == value)
+        return;
+
+    reg ^= mask;
+    dirty = true;
+}
+
+void ShiftRegisterChain::setRegister(int reg, byte value)
+{
+    if (image[reg] == value)
+        return;
+
+    image[reg] = value;
+    dirty = true;
+}
+
+bool ShiftRegisterChain::update(bool async)
+{
+    bool latched = false;
+    if (transferring)
+    {
+        if (!spi.finished)
+            return false;
+
+        wait();
+        latched = true;
+    }
+
+    if (!dirty)
+        return latched;
+    dirty = false;
+
+    int count = prepareFrames();
+    spi.transferBlock(frames, count, 0, async);
+    if (async)
+        transferring = true;
+    else latch();
+
+    return true;
+}
+
+int ShiftRegisterChain::prepareFrames()
+{
+    // The first frame is shifted through to the last register of the chain
+    int count;
+    if (length & 1)
+    {
+        for (count = 0; count < length; ++count)
+            frames[count] = image[length - 1 - count];
+    }
+    else
+    {
+        for (count = 0; count < (length >> 1); ++count)
+            frames[count] = (image[length - 1 - 2 * count] << 8) | image[length - 2 - 2 * count];
+    }
+    return count;
+}
+
+void ShiftRegisterChain::wait()
+{
+    if (!transferring)
+        return;
+
+    while (!spi.finished)
+        ;
+
+    // Wait until the last frame is received, which means that it was sent too
+    spi.finalizeBlockTransfer();
+    transferring = false;
+    latch();
+}
+
+void ShiftRegisterChain::latch()
+{
+    digitalWrite(pinLatch, 1);
+    __NOP();
+    digitalWrite(pinLatch, 0);
+}
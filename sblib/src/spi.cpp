@@ -192,7 +192,7 @@ void SPI::continueBlockTransfer(void)
             tmpVal = port.DR;
             if (recData) *recData++ = tmpVal;
         }
-        LPC_SSP0->DR = *sndData++;
+        port.DR = *sndData++;
         errors |= port.RIS;
        }
     while (recCount && (port.SR & SSP_SR_RNE))
@@ -94,8 +94,97 @@ void delayMicroseconds(unsigned int usec)
         lastSystemTickValue = sysTickValue;
     }
 }
+#else
+void delayMicroseconds(unsigned int usec)
+{
+    // no busy waiting in the host emulation
+}
 #endif
 
+// The minimum number of SysTick counts until the next tick when it is reprogrammed,
+// so the counter does not expire before the reload value is restored
+#define SYSTICK_MIN_RELOAD 16
+
+void sleepUntilInterrupt(unsigned int msec)
+{
+    const unsigned int ticksPerMs = SysTick->LOAD + 1;
+    const unsigned int maxMsec = (SysTick_LOAD_RELOAD_Msk + 1) / ticksPerMs;
+    if (msec > maxMsec)
+    {
+        msec = maxMsec;
+    }
+
+    if (msec < 2)
+    {
+        // the next millisecond tick wakes up anyway
+        if (msec)
+        {
+            waitForInterrupt();
+        }
+        return;
+    }
+
+    // The interrupts stay disabled while sleeping. An interrupt still wakes up the
+    // processor, but its handler runs only after the SysTick is restored below.
+    noInterrupts();
+
+    // The counts until the end of the current millisecond
+    const unsigned int remaining = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        // the SysTick_Handler shall count the tick first
+        interrupts();
+        return;
+    }
+
+    // Expire at the end of the msec'th millisecond, writing VAL reloads the counter
+    const unsigned int period = remaining + (msec - 1) * ticksPerMs;
+    SysTick->LOAD = period - 1;
+    SysTick->VAL = 0;
+
+    waitForInterrupt();
+
+    // The counts since the counter was reloaded
+    unsigned int ticks;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        ticks = period;
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk; // counted below
+    }
+    else
+    {
+        ticks = period - SysTick->VAL;
+    }
+
+    // The milliseconds that have passed and the counts until the next millisecond tick
+    unsigned int ms = 0;
+    unsigned int next;
+    if (ticks < remaining)
+    {
+        next = remaining - ticks;
+    }
+    else
+    {
+        ticks -= remaining;
+        ms = 1 + ticks / ticksPerMs;
+        next = ticksPerMs - ticks % ticksPerMs;
+    }
+
+    if (next < SYSTICK_MIN_RELOAD)
+    {
+        ++ms;
+        next += ticksPerMs;
+    }
+    systemTime += ms;
+
+    // Continue with the millisecond ticks, in phase with the system time
+    SysTick->LOAD = next - 1;
+    SysTick->VAL = 0;
+    SysTick->LOAD = ticksPerMs - 1;
+
+    interrupts();
+}
+
 #ifdef IAP_EMULATION
 void setMillis(unsigned int newSystemTime)
 {
@@ -108,6 +197,28 @@ unsigned int millis()
     return systemTime;
 }
 
+unsigned int micros()
+{
+    unsigned int ms;
+    unsigned int val;
+    const unsigned int load = SysTick->LOAD;
+
+    // Re-read in case the SysTick_Handler incremented the system time in between
+    do
+    {
+        ms = systemTime;
+        val = SysTick->VAL;
+    } while (ms != systemTime);
+
+    // The counter reloaded, but the SysTick_Handler did not run yet
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && (val > (load >> 1)))
+    {
+        ms++;
+    }
+
+    return ms * 1000 + (load - val) * 1000 / (load + 1);
+}
+
 unsigned int elapsed(unsigned int ref)
 {
     return millis() - ref;
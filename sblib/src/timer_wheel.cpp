@@ -0,0 +1,240 @@
+/*
+ *  timer_wheel.cpp - Software timers that are managed by a hierarchical timer wheel
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License version 3 as
+ *  published by the Free Software Foundation.
+ */
+
+#include <sblib/timer_wheel.h>
+
+#include <sblib/timer.h>
+
+// Mask for the slot index of a level
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+// The time that the timer wheel covers
+#define WHEEL_RANGE (1U << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS))
+
+
+TimerWheel timerWheel;
+
+void SoftTimer::start(unsigned int ms)
+{
+    if (!ms)
+    {
+        stop();
+        return;
+    }
+
+    if (link)
+        timerWheel.remove(this);
+    fired = false;
+
+    unsigned int now = millis();
+    if (!timerWheel.count)
+        timerWheel.current = now; // nothing to process in between
+    expires = now + ms;
+    timerWheel.add(this);
+}
+
+void SoftTimer::stop()
+{
+    if (link)
+        timerWheel.remove(this);
+    fired = false;
+}
+
+bool SoftTimer::expired()
+{
+    if (!fired)
+        return false;
+
+    fired = false;
+    return true;
+}
+
+TimerWheel::TimerWheel()
+    : current(0)
+    , count(0)
+{
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+        for (int idx = 0; idx < TIMER_WHEEL_SLOTS; ++idx)
+            slots[level][idx] = 0;
+    }
+}
+
+/*
+ * Add a timer to the slot that is processed when the timer expires, or to
+ * the slot of a higher level that is cascaded down before the timer expires.
+ */
+void TimerWheel::add(SoftTimer* timer)
+{
+    unsigned int delta = timer->expires - current;
+    unsigned int when = timer->expires;
+    int level = 0;
+
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1U << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+        ++level;
+
+    if (delta >= WHEEL_RANGE)
+        when = current + WHEEL_RANGE - 1; // added again when the slot is cascaded
+
+    SoftTimer** head = &slots[level][(when >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK];
+    timer->next = *head;
+    if (timer->next)
+        timer->next->link = &timer->next;
+    *head = timer;
+    timer->link = head;
+    ++count;
+}
+
+void TimerWheel::remove(SoftTimer* timer)
+{
+    *timer->link = timer->next;
+    if (timer->next)
+        timer->next->link = timer->link;
+    timer->next = 0;
+    timer->link = 0;
+    --count;
+}
+
+/*
+ * Move the timers of the current slot of a level to the lower levels.
+ */
+void TimerWheel::cascade(int level)
+{
+    SoftTimer** head = &slots[level][(current >> (level * TIMER_WHEEL_SLOT_BITS)) & SLOT_MASK];
+    SoftTimer* timer;
+
+    while ((timer = *head) != 0)
+    {
+        remove(timer);
+        add(timer);
+    }
+}
+
+/*
+ * Call the callbacks of the timers that expire at the current time.
+ */
+void TimerWheel::expire()
+{
+    SoftTimer** head = &slots[0][current & SLOT_MASK];
+    SoftTimer* timer;
+
+    while ((timer = *head) != 0)
+    {
+        remove(timer);
+
+        if (timer->callback)
+            timer->callback->timerExpired(timer);
+        else timer->fired = true;
+    }
+}
+
+/*
+ * Get the number of milliseconds from the current time to the next time
+ * when a slot of the wheel must be processed.
+ */
+unsigned int TimerWheel::ticksToNextEvent() const
+{
+    unsigned int result = TIMER_WHEEL_IDLE_FOREVER;
+
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+        int shift = level * TIMER_WHEEL_SLOT_BITS;
+        unsigned int base = current >> shift;
+
+        for (unsigned int i = 1; i <= TIMER_WHEEL_SLOTS; ++i)
+        {
+            if (slots[level][(base + i) & SLOT_MASK])
+            {
+                unsigned int ticks = ((base + i) << shift) - current;
+                if (ticks < result)
+                    result = ticks;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+/*
+ * The system time went back, which only happens in the unit tests.
+ * Add all timers again with their remaining time.
+ */
+void TimerWheel::rebase()
+{
+    SoftTimer* list = 0;
+
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+    {
+        for (int idx = 0; idx < TIMER_WHEEL_SLOTS; ++idx)
+        {
+            SoftTimer* timer;
+            while ((timer = slots[level][idx]) != 0)
+            {
+                remove(timer);
+                timer->expires -= current;
+                timer->next = list;
+                list = timer;
+            }
+        }
+    }
+
+    current = millis();
+    while (list)
+    {
+        SoftTimer* timer = list;
+        list = list->next;
+
+        if ((int) timer->expires < 1)
+            timer->expires = 1;
+        timer->expires += current;
+        add(timer);
+    }
+}
+
+void TimerWheel::dispatch()
+{
+    unsigned int now = millis();
+    if ((int) (now - current) < 0)
+        rebase();
+
+    while ((int) (now - current) > 0)
+    {
+        if (!count)
+        {
+            current = now;
+            break;
+        }
+
+        // Skip the time where no slot has timers
+        unsigned int ticks = ticksToNextEvent();
+        if (ticks > now - current)
+        {
+            current = now;
+            break;
+        }
+        current += ticks;
+
+        for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; --level)
+        {
+            if (!(current & ((1U << (level * TIMER_WHEEL_SLOT_BITS)) - 1)))
+                cascade(level);
+        }
+        expire();
+    }
+}
+
+unsigned int TimerWheel::idleTime() const
+{
+    if (!count)
+        return TIMER_WHEEL_IDLE_FOREVER;
+
+    int ticks = current + ticksToNextEvent() - millis();
+    if (ticks < 0)
+        return 0;
+    return ticks;
+}
@@ -0,0 +1,60 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BENCHMARK Host micro-benchmarks
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Host micro-benchmarks of the sblib hot paths
+ * @details Every benchmark is run for a set of table sizes. The runner prints one
+ *          CSV line per benchmark and size:
+ *
+ *              benchmark,size,iterations,ns_per_op
+ *
+ *          so results of two builds can be compared by a script.
+ *
+ * @{
+ *
+ * @file   benchmark.h
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+/**
+ * Prepare a benchmark for the given table size.
+ *
+ * @param size - the table size, number of entries
+ */
+typedef void (BenchmarkSetup) (int size);
+
+/**
+ * Run one operation of a benchmark.
+ *
+ * @param size - the table size, same as passed to the @ref BenchmarkSetup
+ */
+typedef void (BenchmarkRun) (int size);
+
+struct Benchmark
+{
+    const char     * name;    //!< Name of the benchmark, printed in the first CSV column
+    int              maxSize; //!< Largest table size the benchmarked code supports
+    BenchmarkSetup * setup;   //!< Called once per table size before timing, may be nullptr
+    BenchmarkRun   * run;     //!< The timed operation
+};
+
+/** Results are written to this to keep the compiler from removing the benchmarked code */
+extern volatile unsigned int benchmarkSink;
+
+extern const Benchmark knxBenchmarks[];
+extern const int knxBenchmarkCount;
+
+extern const Benchmark utilsBenchmarks[];
+extern const int utilsBenchmarkCount;
+
+#endif /* BENCHMARK_H_ */
+/** @}*/
@@ -0,0 +1,223 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BENCHMARK Host micro-benchmarks
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Benchmarks of the KNX address table and communication object handling
+ * @details A SYSTEM B BCU is used, as it is the only mask supporting more than 255
+ *          group addresses. The address, association, com-object config and flags
+ *          tables are placed in host memory, so they can be sized independent of
+ *          the user EEPROM. The com-object config table has a one byte count,
+ *          so at most 255 com-objects are used.
+ *
+ *          All lookups are done for the last table entry, which is the worst case.
+ *
+ *          The benchmarks named "... static" run the same operation on a BcuStatic,
+ *          whose table accessors are resolved at compile time, see bcu_static.h.
+ *
+ * @{
+ *
+ * @file   benchmark_knx.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include "benchmark.h"
+#include <sblib/eib/systemb.h>
+#include <sblib/eib/apci.h>
+#include <sblib/eib/typesSYSTEMB.h>
+#include <sblib/eib/bcu_static.h>
+#include "iap_emu.h"
+#include <string.h>
+
+#define MAX_TABLE_SIZE    1000 //!< Largest number of group addresses and associations
+#define MAX_COM_OBJECTS   255  //!< Largest number of com-objects, the config table has a one byte count
+#define FIRST_GROUP_ADDR  0x0800
+
+/** The tables, shared by the BCU with virtual and the one with compile time table access */
+static struct
+{
+    byte addrTab[2 + 2 * MAX_TABLE_SIZE];                           //!< 2 bytes count, 2 bytes per group address
+    byte assocTab[2 + 4 * MAX_TABLE_SIZE];                          //!< 2 bytes count, 4 bytes per association
+    byte configTab[3 + sizeof(ComConfigSYSTEMB) * MAX_COM_OBJECTS]; //!< count, flags table pointer and the configs
+    byte flagsTab[(MAX_COM_OBJECTS + 2) / 2];                       //!< 4 bits per com-object
+} tables;
+
+class BenchmarkAddrTables : public AddrTablesSYSTEMB
+{
+public:
+    BenchmarkAddrTables(SYSTEMB* bcuInstance) : AddrTablesSYSTEMB(bcuInstance) {}
+
+    byte* addrTable() override { return tables.addrTab; }
+    byte* assocTable() override { return tables.assocTab; }
+};
+
+class BenchmarkComObjects : public ComObjectsSYSTEMB
+{
+public:
+    BenchmarkComObjects(BcuDefault* bcuInstance) : ComObjectsSYSTEMB(bcuInstance) {}
+
+    byte* objectConfigTable() override { return tables.configTab; }
+    byte* objectFlagsTable() override { return tables.flagsTab; }
+};
+
+class StaticBenchmarkAddrTables final : public AddrTablesStatic<StaticBenchmarkAddrTables, AddrTablesSYSTEMB>
+{
+public:
+    using AddrTablesStatic::AddrTablesStatic;
+
+    byte* addrTable() override { return tables.addrTab; }
+    byte* assocTable() override { return tables.assocTab; }
+};
+
+class StaticBenchmarkComObjects final : public ComObjectsStatic<StaticBenchmarkComObjects, ComObjectsSYSTEMB, StaticBenchmarkAddrTables>
+{
+public:
+    using ComObjectsStatic::ComObjectsStatic;
+
+    byte* objectConfigTable() override { return tables.configTab; }
+    byte* objectFlagsTable() override { return tables.flagsTab; }
+};
+
+class BenchmarkBcu : public SYSTEMB
+{
+public:
+    BenchmarkBcu() :
+        SYSTEMB(new UserRamSYSTEMB(), new UserEepromSYSTEMB(), new BenchmarkComObjects(this),
+                new BenchmarkAddrTables(this), new PropertiesSYSTEMB(this))
+    {}
+};
+
+typedef BcuStatic<SYSTEMB, StaticBenchmarkAddrTables, StaticBenchmarkComObjects, PropertiesSYSTEMB> StaticBenchmarkBcu;
+
+static BenchmarkBcu* bcu = nullptr;
+static StaticBenchmarkBcu* staticBcu = nullptr;
+static int comObjectCount;
+static byte telegram[23];
+static byte memoryBuffer[MAX_TABLE_SIZE];
+
+static void setupTables(int size)
+{
+    if (!bcu)
+    {
+        IAP_Init_Flash(0xFF);
+        bcu = new BenchmarkBcu();
+        // The second BCU needs its own user RAM and EEPROM data
+        staticBcu = new StaticBenchmarkBcu(new UserRamSYSTEMB(memoryData<UserRamSYSTEMB, StaticBenchmarkBcu>()),
+                                           new UserEepromSYSTEMB(memoryData<UserEepromSYSTEMB, StaticBenchmarkBcu>()));
+    }
+
+    comObjectCount = size < MAX_COM_OBJECTS ? size : MAX_COM_OBJECTS;
+
+    byte* tab = tables.addrTab;
+    *tab++ = size >> 8;
+    *tab++ = size;
+    for (int i = 0; i < size; i++)
+    {
+        *tab++ = (FIRST_GROUP_ADDR + i) >> 8;
+        *tab++ = (FIRST_GROUP_ADDR + i);
+    }
+
+    tab = tables.assocTab;
+    *tab++ = size >> 8;
+    *tab++ = size;
+    for (int i = 0; i < size; i++)
+    {
+        int objno = (i % comObjectCount) + 1;
+        *tab++ = (i + 1) >> 8;
+        *tab++ = (i + 1);
+        *tab++ = objno >> 8;
+        *tab++ = objno;
+    }
+
+    // No com-object is write enabled and no flags are set, so every call
+    // scans the tables without side effects.
+    memset(tables.configTab, 0, sizeof(tables.configTab));
+    tables.configTab[0] = comObjectCount;
+    for (int objno = 1; objno <= comObjectCount; objno++)
+    {
+        ComConfig& config = ((ComConfigSYSTEMB*) (tables.configTab + 2 + (objno - 1) * sizeof(ComConfigSYSTEMB)))->baseConfig;
+        config.config = COMCONF_TRANS_COMM | COMCONF_PRIO_LOW;
+        config.type = BIT_1;
+    }
+    memset(tables.flagsTab, 0, sizeof(tables.flagsTab));
+}
+
+static void benchIndexOfAddr(int size)
+{
+    benchmarkSink = bcu->addrTables->indexOfAddr(FIRST_GROUP_ADDR + size - 1);
+}
+
+static void benchProcessGroupTelegram(int size)
+{
+    bcu->comObjects->processGroupTelegram(FIRST_GROUP_ADDR + size - 1, APCI_GROUP_VALUE_WRITE_PDU, telegram);
+}
+
+static void benchSendNextGroupTelegram(int size)
+{
+    benchmarkSink = bcu->comObjects->sendNextGroupTelegram();
+}
+
+static void benchNextUpdatedObject(int size)
+{
+    benchmarkSink = bcu->comObjects->nextUpdatedObject();
+}
+
+static void benchObjectValuePtr(int size)
+{
+    benchmarkSink = *bcu->comObjects->objectValuePtr(comObjectCount);
+}
+
+static void benchIndexOfAddrStatic(int size)
+{
+    benchmarkSink = staticBcu->staticAddrTables()->indexOfAddr(FIRST_GROUP_ADDR + size - 1);
+}
+
+static void benchProcessGroupTelegramStatic(int size)
+{
+    staticBcu->comObjects->processGroupTelegram(FIRST_GROUP_ADDR + size - 1, APCI_GROUP_VALUE_WRITE_PDU, telegram);
+}
+
+static void benchSendNextGroupTelegramStatic(int size)
+{
+    benchmarkSink = staticBcu->comObjects->sendNextGroupTelegram();
+}
+
+static void benchNextUpdatedObjectStatic(int size)
+{
+    benchmarkSink = staticBcu->comObjects->nextUpdatedObject();
+}
+
+static void benchObjectValuePtrStatic(int size)
+{
+    benchmarkSink = *staticBcu->staticComObjects()->objectValuePtr(comObjectCount);
+}
+
+static void benchMemoryRead(int size)
+{
+    bcu->processApciMemoryOperation(bcu->userEeprom->startAddr(), memoryBuffer, size, true);
+    benchmarkSink = memoryBuffer[0];
+}
+
+const Benchmark knxBenchmarks[] =
+{
+    {"indexOfAddr",                  MAX_TABLE_SIZE, setupTables, benchIndexOfAddr},
+    {"processGroupTelegram",         MAX_TABLE_SIZE, setupTables, benchProcessGroupTelegram},
+    {"sendNextGroupTelegram",        MAX_TABLE_SIZE, setupTables, benchSendNextGroupTelegram},
+    {"nextUpdatedObject",            MAX_TABLE_SIZE, setupTables, benchNextUpdatedObject},
+    {"objectValuePtr",               MAX_TABLE_SIZE, setupTables, benchObjectValuePtr},
+    {"processApciMemoryOperation",   MAX_TABLE_SIZE, setupTables, benchMemoryRead},
+    {"indexOfAddr static",           MAX_TABLE_SIZE, setupTables, benchIndexOfAddrStatic},
+    {"processGroupTelegram static",  MAX_TABLE_SIZE, setupTables, benchProcessGroupTelegramStatic},
+    {"sendNextGroupTelegram static", MAX_TABLE_SIZE, setupTables, benchSendNextGroupTelegramStatic},
+    {"nextUpdatedObject static",     MAX_TABLE_SIZE, setupTables, benchNextUpdatedObjectStatic},
+    {"objectValuePtr static",        MAX_TABLE_SIZE, setupTables, benchObjectValuePtrStatic},
+};
+
+const int knxBenchmarkCount = sizeof(knxBenchmarks) / sizeof(knxBenchmarks[0]);
+
+/** @}*/
@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BENCHMARK Host micro-benchmarks
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Benchmark runner
+ * @details Usage: lib-test-cases-benchmark [-t milliseconds] [filter]
+ *
+ *          -t     minimum time of one measurement, default 50ms
+ *          filter only run benchmarks whose name contains this string
+ *
+ * @{
+ *
+ * @file   benchmark_main.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include "benchmark.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+volatile unsigned int benchmarkSink;
+
+static const int tableSizes[] = {10, 30, 100, 300, 1000};
+static const int repetitions = 3; //!< The fastest of these measurements is reported
+
+typedef std::chrono::steady_clock Clock;
+
+static double measure(const Benchmark& bench, int size, unsigned int iterations)
+{
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        bench.run(size);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static void runBenchmark(const Benchmark& bench, int size, double minTimeNs)
+{
+    if (bench.setup)
+    {
+        bench.setup(size);
+    }
+
+    // find an iteration count which takes at least minTimeNs
+    unsigned int iterations = 1;
+    double elapsed = measure(bench, size, iterations);
+    while ((elapsed < minTimeNs) && (iterations < (1u << 30)))
+    {
+        iterations *= 2;
+        elapsed = measure(bench, size, iterations);
+    }
+
+    double best = elapsed;
+    for (int i = 1; i < repetitions; i++)
+    {
+        elapsed = measure(bench, size, iterations);
+        if (elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    printf("%s,%d,%u,%.1f\n", bench.name, size, iterations, best / iterations);
+    fflush(stdout);
+}
+
+static void runBenchmarks(const Benchmark* benchmarks, int count, const char* filter, double minTimeNs)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (filter && !strstr(benchmarks[i].name, filter))
+        {
+            continue;
+        }
+
+        for (unsigned int s = 0; s < sizeof(tableSizes) / sizeof(tableSizes[0]); s++)
+        {
+            if (tableSizes[s] > benchmarks[i].maxSize)
+            {
+                break;
+            }
+            runBenchmark(benchmarks[i], tableSizes[s], minTimeNs);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = nullptr;
+    double minTimeNs = 50e6;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            minTimeNs = atof(argv[++i]) * 1e6;
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    printf("benchmark,size,iterations,ns_per_op\n");
+    runBenchmarks(knxBenchmarks, knxBenchmarkCount, filter, minTimeNs);
+    runBenchmarks(utilsBenchmarks, utilsBenchmarkCount, filter, minTimeNs);
+    return 0;
+}
+
+/** @}*/
@@ -0,0 +1,97 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BENCHMARK Host micro-benchmarks
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Benchmarks of checksum, datapoint conversion and print formatting
+ * @details The size is the number of bytes for the crc32 and the number of
+ *          values converted or printed for the other benchmarks.
+ *
+ * @{
+ *
+ * @file   benchmark_utils.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include "benchmark.h"
+#include <sblib/eib/datapoint_types.h>
+#include <sblib/print.h>
+#include <crc.h>
+
+#define MAX_BUFFER_SIZE 1000
+
+/**
+ * A Print which only counts the written bytes.
+ */
+class NullPrint : public Print
+{
+public:
+    int write(byte ch) override
+    {
+        bytesWritten++;
+        return 1;
+    }
+
+    unsigned int bytesWritten = 0;
+};
+
+static unsigned char crcBuffer[MAX_BUFFER_SIZE];
+static NullPrint nullPrint;
+
+static void setupCrc32(int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        crcBuffer[i] = i * 7;
+    }
+}
+
+static void benchCrc32(int size)
+{
+    benchmarkSink = crc32(0xFFFFFFFF, crcBuffer, size);
+}
+
+static void benchFloatToDpt9(int size)
+{
+    unsigned int result = 0;
+    for (int i = 0; i < size; i++)
+    {
+        result += floatToDpt9((i - size / 2) * 1237);
+    }
+    benchmarkSink = result;
+}
+
+static void benchPrintDec(int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        nullPrint.print(i * 4099 - 2000000);
+    }
+    benchmarkSink = nullPrint.bytesWritten;
+}
+
+static void benchPrintHex(int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        nullPrint.print(i * 4099, HEX, 8);
+    }
+    benchmarkSink = nullPrint.bytesWritten;
+}
+
+const Benchmark utilsBenchmarks[] =
+{
+    {"crc32",       MAX_BUFFER_SIZE, setupCrc32, benchCrc32},
+    {"floatToDpt9", MAX_BUFFER_SIZE, nullptr,    benchFloatToDpt9},
+    {"printDec",    MAX_BUFFER_SIZE, nullptr,    benchPrintDec},
+    {"printHex",    MAX_BUFFER_SIZE, nullptr,    benchPrintHex},
+};
+
+const int utilsBenchmarkCount = sizeof(utilsBenchmarks) / sizeof(utilsBenchmarks[0]);
+
+/** @}*/
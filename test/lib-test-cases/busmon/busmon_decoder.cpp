@@ -0,0 +1,97 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BUSMON Binary bus monitor decoder
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Decoding of the binary record stream of a BusMonitor
+ *
+ * @{
+ *
+ * @file   busmon_decoder.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include "busmon_decoder.h"
+#include <string.h>
+
+#define KNOWN_FLAGS  (BUS_MONITOR_VALID | BUS_MONITOR_ACK | BUS_MONITOR_LOST)
+#define KNOWN_ERRORS 0x01ff //!< RX_STOPBIT_ERROR .. RX_PREAMBLE_ERROR
+
+BusMonitorDecoder::BusMonitorDecoder()
+    : pos(0)
+    , haveTime(false)
+    , lastTime(0)
+    , timeHigh(0)
+    , skippedBytes(0)
+{
+    memset(&rec, 0, sizeof(rec));
+}
+
+bool BusMonitorDecoder::validHeader() const
+{
+    int length = header[1];
+    int flags = header[2];
+    int errors = header[3] | (header[4] << 8);
+
+    if (length < 1 || length > BUSMON_MAX_FRAME_SIZE)
+        return false;
+    if (flags & ~KNOWN_FLAGS)
+        return false;
+    if (errors & ~KNOWN_ERRORS)
+        return false;
+    return ((flags & BUS_MONITOR_ACK) != 0) == (length == 1);
+}
+
+bool BusMonitorDecoder::decode(uint8_t ch)
+{
+    if (pos < BUS_MONITOR_HEADER_SIZE)
+    {
+        if (pos == 0 && ch != BUS_MONITOR_SYNC)
+        {
+            ++skippedBytes;
+            return false;
+        }
+
+        header[pos++] = ch;
+        if (pos < BUS_MONITOR_HEADER_SIZE)
+            return false;
+
+        if (!validHeader())
+        {
+            // Not a record: skip the sync byte and search again in the rest of the header
+            ++skippedBytes;
+            pos = 0;
+            for (int i = 1; i < BUS_MONITOR_HEADER_SIZE; ++i)
+            {
+                decode(header[i]);
+            }
+            return false;
+        }
+
+        rec.length = header[1];
+        rec.flags = header[2];
+        rec.errors = header[3] | (header[4] << 8);
+
+        uint32_t time = header[5] | (header[6] << 8) | (header[7] << 16) | ((uint32_t) header[8] << 24);
+        if (haveTime && time < lastTime)
+            timeHigh += 1ULL << 32; // micros() overflowed
+        lastTime = time;
+        haveTime = true;
+        rec.timeUs = timeHigh | time;
+        return false;
+    }
+
+    rec.bytes[pos - BUS_MONITOR_HEADER_SIZE] = ch;
+    if (++pos < BUS_MONITOR_HEADER_SIZE + rec.length)
+        return false;
+
+    pos = 0;
+    return true;
+}
+
+/** @}*/
@@ -0,0 +1,82 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BUSMON Binary bus monitor decoder
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Decoding of the binary record stream of a BusMonitor
+ * @details The record format is described in sblib/eib/bus_monitor.h.
+ *          The decoder synchronizes to the first record of the stream, and
+ *          re-synchronizes when it receives bytes which are not a record,
+ *          e.g. when the serial port was opened in the middle of a record.
+ *
+ * @{
+ *
+ * @file   busmon_decoder.h
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#ifndef BUSMON_DECODER_H_
+#define BUSMON_DECODER_H_
+
+#include <stdint.h>
+#include <sblib/eib/bus_monitor.h>
+
+#define BUSMON_MAX_FRAME_SIZE 64 //!< Longest frame accepted from the stream
+
+struct BusMonitorRecord
+{
+    uint64_t timeUs;  //!< Time stamp of the end of the frame in microseconds, extended to 64 bit
+    int flags;        //!< The flags of the record, see BusMonitorFlags
+    int errors;       //!< The RX error flags of the bus, see RX_* in bus_const.h
+    int length;       //!< Number of bytes in @ref bytes, including the checksum
+    uint8_t bytes[BUSMON_MAX_FRAME_SIZE];
+};
+
+class BusMonitorDecoder
+{
+public:
+    BusMonitorDecoder();
+
+    /**
+     * Decode the next byte of the stream.
+     *
+     * @param ch - the byte
+     * @return True if a record is complete, it is available with record() until
+     *         the next call of decode().
+     */
+    bool decode(uint8_t ch);
+
+    /**
+     * @return The last decoded record.
+     */
+    const BusMonitorRecord& record() const { return rec; }
+
+    /**
+     * @return The number of bytes that were skipped to find the start of a record.
+     */
+    unsigned int skipped() const { return skippedBytes; }
+
+private:
+    /**
+     * Check the header of a record.
+     *
+     * @return True if the header is plausible.
+     */
+    bool validHeader() const;
+
+    BusMonitorRecord rec;
+    uint8_t header[BUS_MONITOR_HEADER_SIZE];
+    int pos;                   //!< Number of bytes of the current record received so far
+    bool haveTime;             //!< A time stamp was received before
+    uint32_t lastTime;         //!< The last 32 bit time stamp
+    uint64_t timeHigh;         //!< The upper bits of the extended time stamp
+    unsigned int skippedBytes;
+};
+
+#endif /* BUSMON_DECODER_H_ */
+/** @}*/
@@ -0,0 +1,115 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_BUSMON Binary bus monitor decoder
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Decodes the binary record stream of a BusMonitor on the host
+ * @details Usage: lib-test-cases-busmon [options] [stream]
+ *
+ *          -r    print only the valid data frames, in the capture format of
+ *                lib-test-cases-replay
+ *
+ *          The stream is read from the given file or serial device, or from
+ *          stdin. Configure the serial device before, e.g. with
+ *          stty -F /dev/ttyUSB0 921600 raw
+ *
+ *          Every record is printed in one line: the time stamp in microseconds,
+ *          the frame bytes, and the flags and RX errors of the frame, e.g.
+ *
+ *              1234567890: BC 11 01 09 01 E1 00 81 35 ok
+ *              1234569310: CC ack ok
+ *
+ * @{
+ *
+ * @file   busmon_main.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "busmon_decoder.h"
+
+static void usage()
+{
+    fprintf(stderr, "Usage: lib-test-cases-busmon [-r] [stream]\n");
+    exit(1);
+}
+
+static void printRecord(const BusMonitorRecord& rec, bool replayFormat)
+{
+    if (replayFormat)
+    {
+        if ((rec.flags & (BUS_MONITOR_VALID | BUS_MONITOR_ACK)) != BUS_MONITOR_VALID)
+            return;
+        printf("%llu:", (unsigned long long) (rec.timeUs / 1000));
+    }
+    else printf("%llu:", (unsigned long long) rec.timeUs);
+
+    for (int i = 0; i < rec.length; ++i)
+    {
+        printf(" %02X", rec.bytes[i]);
+    }
+
+    if (!replayFormat)
+    {
+        if (rec.flags & BUS_MONITOR_ACK)
+            printf(" ack");
+        if (rec.flags & BUS_MONITOR_VALID)
+            printf(" ok");
+        else printf(" invalid");
+        if (rec.errors)
+            printf(" rx_error 0x%04x", rec.errors);
+        if (rec.flags & BUS_MONITOR_LOST)
+            printf(" (records lost before)");
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* streamName = nullptr;
+    bool replayFormat = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-r") == 0)             replayFormat = true;
+        else if (argv[i][0] != '-' && !streamName) streamName = argv[i];
+        else usage();
+    }
+
+    FILE* stream = stdin;
+    if (streamName)
+    {
+        stream = fopen(streamName, "rb");
+        if (!stream)
+        {
+            fprintf(stderr, "Can not open %s\n", streamName);
+            return 1;
+        }
+    }
+
+    BusMonitorDecoder decoder;
+    int ch;
+    while ((ch = fgetc(stream)) != EOF)
+    {
+        if (decoder.decode(ch))
+        {
+            printRecord(decoder.record(), replayFormat);
+            fflush(stdout);
+        }
+    }
+
+    if (decoder.skipped())
+    {
+        fprintf(stderr, "%u bytes skipped\n", decoder.skipped());
+    }
+    return 0;
+}
+
+/** @}*/
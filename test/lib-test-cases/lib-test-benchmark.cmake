@@ -0,0 +1,8 @@
+set(SBLIB_LIB_TEST_BENCHMARK_SRC
+        benchmark/benchmark.h
+        benchmark/benchmark_knx.cpp
+        benchmark/benchmark_main.cpp
+        benchmark/benchmark_utils.cpp
+        ${BOOTLOADER_PATH}/inc/crc.h
+        ${BOOTLOADER_PATH}/src/crc.cpp
+)
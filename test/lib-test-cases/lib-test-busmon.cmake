@@ -0,0 +1,5 @@
+set(SBLIB_LIB_TEST_BUSMON_SRC
+        busmon/busmon_decoder.h
+        busmon/busmon_decoder.cpp
+        busmon/busmon_main.cpp
+)
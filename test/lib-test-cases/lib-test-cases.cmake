@@ -1,4 +1,8 @@
 set(SBLIB_LIB_TEST_CASES_SRC
+        busmon/busmon_decoder.h
+        busmon/busmon_decoder.cpp
+        tpuart/tpuart_emulator.h
+        tpuart/tpuart_emulator.cpp
         src/tc_tlayer4_stepfunction.h
         src/tc_tlayer4_telegram.h
         src/test_digital_pin.h
@@ -9,14 +13,32 @@ set(SBLIB_LIB_TEST_CASES_SRC
         src/prot_network_layer.cpp
         src/prot_parameter.cpp
         src/prot_physical_address.cpp
+        src/test_analog_sampler.cpp
+        src/test_bcu_static.cpp
+        src/test_bus_monitor.cpp
+        src/test_bus_receive.cpp
         src/test_datapoint_types.cpp
+        src/test_debounce.cpp
+        src/test_dht.cpp
         src/test_digital_pin.cpp
         src/test_eeprom.cpp
+        src/test_ft12_interface.cpp
+        src/test_gas_index_fix16.cpp
+        src/test_i2c.cpp
         src/test_ioports.cpp
         src/test_ioports_get_pin_function_number.cpp
         src/test_knx_lpdu.cpp
+        src/test_lcd_graphical.cpp
+        src/test_onewire.cpp
+        src/test_pin.cpp
+        src/test_profiler.cpp
         src/test_prot_apci.cpp
         src/test_prot_app_program.cpp
         src/test_prot_tlayer4.cpp
+        src/test_shift_register.cpp
+        src/test_sht4x.cpp
+        src/test_sleep_when_idle.cpp
+        src/test_timer_wheel.cpp
+        src/test_tp_uart.cpp
         src/timeout_test.cpp
 )
\ No newline at end of file
@@ -0,0 +1,5 @@
+set(SBLIB_LIB_TEST_REPLAY_SRC
+        replay/capture.h
+        replay/capture.cpp
+        replay/replay_main.cpp
+)
@@ -0,0 +1,115 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_REPLAY Telegram capture replay
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Reading of timestamped telegram captures
+ *
+ * @{
+ *
+ * @file   capture.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include "capture.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int hexDigit(char ch)
+{
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Parse the hex bytes of a telegram. Parsing stops at the first token which
+ * is not a two digit hex number, e.g. the frame timing info of the dump.
+ */
+static int parseHexBytes(const char* pos, uint8_t* bytes)
+{
+    int count = 0;
+    while (count < CAPTURE_MAX_TELEGRAM_SIZE)
+    {
+        while (*pos == ' ' || *pos == '\t')
+        {
+            pos++;
+        }
+
+        int high = hexDigit(pos[0]);
+        int low = (high >= 0) ? hexDigit(pos[1]) : -1;
+        if ((low < 0) || !(pos[2] == 0 || isspace((unsigned char) pos[2])))
+        {
+            break;
+        }
+
+        bytes[count++] = (high << 4) | low;
+        pos += 2;
+    }
+    return count;
+}
+
+bool parseCaptureLine(const char* line, CapturedTelegram* tel)
+{
+    while (*line == ' ' || *line == '\t')
+    {
+        line++;
+    }
+
+    if (strncmp(line, "RX : (S", 7) == 0)
+    {
+        const char* end = strchr(line, ')');
+        if (!end)
+        {
+            return false;
+        }
+        tel->timeUs = strtoull(line + 7, nullptr, 10);
+        tel->length = parseHexBytes(end + 1, tel->bytes);
+    }
+    else if (isdigit((unsigned char) *line))
+    {
+        char* pos;
+        unsigned long long timeMs = strtoull(line, &pos, 10);
+        if (*pos != ':')
+        {
+            return false;
+        }
+        tel->timeUs = timeMs * 1000;
+        tel->length = parseHexBytes(pos + 1, tel->bytes);
+    }
+    else
+    {
+        return false;
+    }
+
+    return tel->length > 0;
+}
+
+bool readCapturedTelegram(FILE* file, CapturedTelegram* tel, int* lineNumber)
+{
+    char line[1024];
+    while (fgets(line, sizeof(line), file))
+    {
+        (*lineNumber)++;
+        if (line[0] == '#')
+        {
+            continue;
+        }
+
+        if (parseCaptureLine(line, tel))
+        {
+            tel->lineNumber = *lineNumber;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @}*/
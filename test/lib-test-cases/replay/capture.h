@@ -0,0 +1,68 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_REPLAY Telegram capture replay
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Reading of timestamped telegram captures
+ * @details Two line formats are understood, all other lines are skipped:
+ *
+ *          - The RX lines of the DUMP_TELEGRAMS output, e.g. of example-busmonitor2.
+ *            The start time (S) is in microseconds:
+ *
+ *                RX : (S    1234567 E    1238901 dt RX-RX:    20000  ok: 0x0000) BC 11 01 09 01 E1 00 81 35
+ *
+ *          - A time in milliseconds followed by a colon and the telegram bytes:
+ *
+ *                1234: BC 11 01 09 01 E1 00 81 35
+ *
+ *          In both formats the telegram bytes include the checksum.
+ *          Lines starting with # are comments.
+ *
+ * @{
+ *
+ * @file   capture.h
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define CAPTURE_MAX_TELEGRAM_SIZE 64 //!< Longest telegram accepted from a capture
+
+struct CapturedTelegram
+{
+    uint64_t timeUs;  //!< Time stamp of the telegram start in microseconds
+    int lineNumber;   //!< Line of the capture file, for reporting
+    int length;       //!< Number of bytes in @ref bytes, including the checksum
+    uint8_t bytes[CAPTURE_MAX_TELEGRAM_SIZE];
+};
+
+/**
+ * Read the next telegram from a capture file.
+ *
+ * @param file       - the capture file
+ * @param tel        - receives the telegram
+ * @param lineNumber - in: number of lines read so far, out: updated
+ * @return True if a telegram was read, false at end of file.
+ */
+bool readCapturedTelegram(FILE* file, CapturedTelegram* tel, int* lineNumber);
+
+/**
+ * Parse one line of a capture.
+ *
+ * @param line - the line to parse
+ * @param tel  - receives the telegram
+ * @return True if the line contains a telegram, false if it shall be skipped.
+ */
+bool parseCaptureLine(const char* line, CapturedTelegram* tel);
+
+#endif /* CAPTURE_H_ */
+/** @}*/
@@ -0,0 +1,417 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_REPLAY Telegram capture replay
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Replays a telegram capture into a BCU on the host
+ * @details Usage: lib-test-cases-replay [options] capture.txt
+ *
+ *          -b bcu1|bcu2|0701|0705|systemb  BCU to use, default bcu2
+ *          -e file                         raw user EEPROM image, loaded from the
+ *                                          start address of the user EEPROM
+ *          -l microseconds                 simulated duration of one bcu->loop(), default 100
+ *          -d milliseconds                 time to run after the last telegram, default 1000
+ *          -q                              only print the summary
+ *
+ *          The captured telegrams are injected into the Bus at their time stamps,
+ *          as the receive interrupt would do. In between the BCU loop runs with the
+ *          simulated millis(). Telegrams the BCU sends are completed after their
+ *          time on the bus and reported. For every telegram addressed to us the
+ *          host time needed to process it is reported. A telegram that arrives while
+ *          the previous one is still unprocessed is dropped, like on the real device.
+ *
+ *          The replay links the optimized sblib (sblib-optimized, -O2 with the release
+ *          defines), so the processing times are those of optimized code on the host.
+ *          They compare builds, but are not the processing times on the device.
+ *
+ * @{
+ *
+ * @file   replay_main.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define private   public
+#define protected public
+#   include <sblib/eib/bus.h>
+#   include <sblib/eib/bcu1.h>
+#   include <sblib/eib/bcu2.h>
+#   include <sblib/eib/mask0701.h>
+#   include <sblib/eib/mask0705.h>
+#   include <sblib/eib/systemb.h>
+#undef private
+#undef protected
+#include <sblib/eib/bus_const.h>
+#include <sblib/eib/knx_lpdu.h>
+#include <sblib/eib/knx_npdu.h>
+#include <sblib/bits.h>
+#include "iap_emu.h"
+#include "capture.h"
+
+#define BIT_TIME_US     104 //!< Duration of one bit on the KNX TP1 bus
+#define CHAR_BITS       13  //!< Start bit, 8 data bits, parity, stop bit and 2 bits pause
+#define ACK_WAIT_BITS   15  //!< Pause between a telegram and its acknowledge frame
+#define IDLE_BITS       50  //!< Pause after a telegram before the next one may start
+
+typedef std::chrono::steady_clock Clock;
+
+enum RxResult
+{
+    RX_PROCESSED, //!< Addressed to us and processed by the BCU
+    RX_DROPPED,   //!< Addressed to us, but the receive buffer was still busy
+    RX_REPEATED,  //!< Repetition of an already received telegram, acknowledged only
+    RX_IGNORED,   //!< Not addressed to us
+    RX_INVALID,   //!< Wrong checksum or not a valid data frame
+    RX_RESULT_COUNT
+};
+
+static const char* const rxResultNames[RX_RESULT_COUNT] =
+{
+    "processed", "dropped", "repeated", "ignored", "invalid"
+};
+
+struct ReplayStats
+{
+    unsigned int rx[RX_RESULT_COUNT];
+    unsigned int tx;
+    double processingUsSum;
+    double processingUsMax;
+};
+
+static BcuDefault* bcu;
+static Bus* bus;
+static ReplayStats stats;
+static bool verbose = true;
+
+static uint64_t nowUs;          //!< The simulated time
+static uint64_t busFreeUs;      //!< End of the current bus activity
+static uint64_t loopTimeUs = 100;
+
+static bool sending;            //!< A telegram of the BCU is on the bus
+static uint64_t sendEndUs;
+
+static bool processing;         //!< A received telegram waits for processing
+static CapturedTelegram pendingTel;
+static double pendingHostUs;
+
+static uint64_t frameTimeUs(int length)
+{
+    return (uint64_t) length * CHAR_BITS * BIT_TIME_US;
+}
+
+static uint64_t telegramBusTimeUs(int length)
+{
+    return frameTimeUs(length) + (ACK_WAIT_BITS * BIT_TIME_US) + frameTimeUs(1) + (IDLE_BITS * BIT_TIME_US);
+}
+
+static void printBytes(const uint8_t* bytes, int length)
+{
+    for (int i = 0; i < length; i++)
+    {
+        printf(" %02X", bytes[i]);
+    }
+    printf("\n");
+}
+
+static void printTime(const char* direction, uint64_t timeUs)
+{
+    printf("%s %10llu.%03u", direction, (unsigned long long) (timeUs / 1000), (unsigned int) (timeUs % 1000));
+}
+
+static void reportRx(const CapturedTelegram& tel, RxResult result, double hostUs)
+{
+    stats.rx[result]++;
+    if (!verbose)
+    {
+        return;
+    }
+
+    printTime("RX", tel.timeUs);
+    printf(" line %6d %-9s", tel.lineNumber, rxResultNames[result]);
+    if (result == RX_PROCESSED)
+    {
+        printf(" %8.1fus", hostUs);
+    }
+    else
+    {
+        printf("           ");
+    }
+    printBytes(tel.bytes, tel.length);
+}
+
+/**
+ * Simulate the bus side of sending: start a telegram the BCU queued once the bus
+ * is free, and finish it after its time on the bus as if it was acknowledged.
+ */
+static void serviceBus()
+{
+    if (!sending && bus->sendCurTelegram != nullptr)
+    {
+        uint64_t startUs = (nowUs > busFreeUs) ? nowUs : busFreeUs;
+        int length = telegramSize(bus->sendCurTelegram) + 1;
+        sendEndUs = startUs + telegramBusTimeUs(length);
+        busFreeUs = sendEndUs;
+        sending = true;
+    }
+
+    if (sending && nowUs >= sendEndUs)
+    {
+        stats.tx++;
+        if (verbose)
+        {
+            printTime("TX", sendEndUs);
+            printf("                          ");
+            printBytes(bus->sendCurTelegram, telegramSize(bus->sendCurTelegram) + 1);
+        }
+        bus->tx_error = TX_OK;
+        bus->finishSendingTelegram();
+        bus->state = Bus::IDLE;
+        sending = false;
+    }
+}
+
+static void step()
+{
+    nowUs += loopTimeUs;
+    setMillis(nowUs / 1000);
+    serviceBus();
+
+    Clock::time_point start = Clock::now();
+    bcu->loop();
+    double hostUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    if (processing)
+    {
+        pendingHostUs += hostUs;
+        if (!bus->telegramReceived())
+        {
+            processing = false;
+            stats.processingUsSum += pendingHostUs;
+            if (pendingHostUs > stats.processingUsMax)
+            {
+                stats.processingUsMax = pendingHostUs;
+            }
+            reportRx(pendingTel, RX_PROCESSED, pendingHostUs);
+        }
+    }
+}
+
+static void runUntil(uint64_t timeUs)
+{
+    while (nowUs < timeUs)
+    {
+        step();
+    }
+}
+
+/**
+ * Inject a received telegram into the Bus, like the end of telegram handling
+ * of the timer interrupt does.
+ */
+static void inject(const CapturedTelegram& tel)
+{
+    int length = tel.length;
+    if (length > bcu->maxTelegramSize())
+    {
+        reportRx(tel, RX_INVALID, 0);
+        return;
+    }
+
+    uint8_t checksum = 0;
+    for (int i = 0; i < length; i++)
+    {
+        checksum ^= tel.bytes[i];
+    }
+    bool valid = (checksum == 0xff);
+
+    bool wasBusy = bus->telegramReceived();
+    memcpy(bus->rx_telegram, tel.bytes, length);
+    bus->nextByteIndex = length;
+    bus->currentByte = tel.bytes[length - 1];
+    bus->parity = 1;
+    bus->rx_error = RX_OK;
+    bus->handleTelegram(valid);
+
+    busFreeUs = tel.timeUs + telegramBusTimeUs(length);
+    bool acked = (bus->sendAck != 0);
+
+    // the ISR sends the acknowledge frame and goes back to idle
+    bus->sendAck = 0;
+    if (!sending)
+    {
+        bus->state = Bus::IDLE;
+    }
+
+    if (bus->rx_error & RX_BUFFER_BUSY)
+    {
+        reportRx(tel, RX_DROPPED, 0);
+    }
+    else if (!wasBusy && bus->telegramReceived())
+    {
+        processing = true;
+        pendingTel = tel;
+        pendingHostUs = 0;
+    }
+    else if (acked)
+    {
+        reportRx(tel, RX_REPEATED, 0);
+    }
+    else if (!valid || (bus->rx_error & RX_INVALID_TELEGRAM_ERROR))
+    {
+        reportRx(tel, RX_INVALID, 0);
+    }
+    else
+    {
+        reportRx(tel, RX_IGNORED, 0);
+    }
+}
+
+static BcuDefault* createBcu(const char* name)
+{
+    if (strcmp(name, "bcu1") == 0)    return new BCU1();
+    if (strcmp(name, "bcu2") == 0)    return new BCU2();
+    if (strcmp(name, "0701") == 0)    return new MASK0701();
+    if (strcmp(name, "0705") == 0)    return new MASK0705();
+    if (strcmp(name, "systemb") == 0) return new SYSTEMB();
+    return nullptr;
+}
+
+static bool loadEeprom(const char* fileName)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+    {
+        return false;
+    }
+    size_t count = fread(bcu->userEeprom->userEepromData, 1, bcu->userEeprom->size(), file);
+    fclose(file);
+    fprintf(stderr, "Loaded %u bytes of user EEPROM from %s\n", (unsigned int) count, fileName);
+    return true;
+}
+
+static void usage()
+{
+    fprintf(stderr, "Usage: lib-test-cases-replay [-b bcu1|bcu2|0701|0705|systemb] [-e eeprom.bin] "
+                    "[-l loop-us] [-d drain-ms] [-q] capture.txt\n");
+    exit(2);
+}
+
+int main(int argc, char** argv)
+{
+    const char* bcuName = "bcu2";
+    const char* eepromFile = nullptr;
+    const char* captureFile = nullptr;
+    uint64_t drainUs = 1000000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)      bcuName = argv[++i];
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) eepromFile = argv[++i];
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) loopTimeUs = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) drainUs = strtoull(argv[++i], nullptr, 10) * 1000;
+        else if (strcmp(argv[i], "-q") == 0)                 verbose = false;
+        else if (argv[i][0] != '-' && !captureFile)          captureFile = argv[i];
+        else usage();
+    }
+
+    if (!captureFile || !loopTimeUs)
+    {
+        usage();
+    }
+
+    FILE* capture = fopen(captureFile, "r");
+    if (!capture)
+    {
+        fprintf(stderr, "Can not open capture %s\n", captureFile);
+        return 1;
+    }
+
+    IAP_Init_Flash(0xFF);
+    bcu = createBcu(bcuName);
+    if (!bcu)
+    {
+        usage();
+    }
+    bus = bcu->bus;
+
+    if (eepromFile && !loadEeprom(eepromFile))
+    {
+        fprintf(stderr, "Can not open EEPROM image %s\n", eepromFile);
+        return 1;
+    }
+
+    // keep the application identification of the EEPROM image
+    UserEeprom* eeprom = bcu->userEeprom;
+    bcu->begin(makeWord(eeprom->manufacturerH(), eeprom->manufacturerL()),
+               makeWord(eeprom->deviceTypeH(), eeprom->deviceTypeL()),
+               eeprom->version());
+    bus->state = Bus::IDLE;
+    setMillis(0);
+
+    fprintf(stderr, "Replaying %s into %s mask 0x%04x, own address 0x%04x\n", captureFile,
+            bcu->getBcuType(), bcu->getMaskVersion(), bcu->ownAddress());
+
+    CapturedTelegram tel;
+    int lineNumber = 0;
+    bool first = true;
+    uint64_t captureStartUs = 0;
+    uint64_t lastCaptureUs = 0;
+    uint64_t offsetUs = 0;
+
+    while (readCapturedTelegram(capture, &tel, &lineNumber))
+    {
+        if (first)
+        {
+            captureStartUs = tel.timeUs;
+            first = false;
+        }
+        else if (tel.timeUs < lastCaptureUs)
+        {
+            // time stamp wrapped or capture was restarted, continue from the current time
+            offsetUs = nowUs + captureStartUs - tel.timeUs;
+        }
+        lastCaptureUs = tel.timeUs;
+
+        // replay time starts at 1ms, so the BCU had one loop before the first telegram
+        tel.timeUs = tel.timeUs - captureStartUs + offsetUs + 1000;
+        runUntil(tel.timeUs);
+        inject(tel);
+    }
+    fclose(capture);
+
+    runUntil(nowUs + drainUs);
+    if (processing)
+    {
+        // the BCU never got to process the last telegram
+        reportRx(pendingTel, RX_DROPPED, 0);
+    }
+
+    unsigned int received = 0;
+    for (int i = 0; i < RX_RESULT_COUNT; i++)
+    {
+        received += stats.rx[i];
+    }
+
+    printf("\nSummary: %u telegrams received, %u sent\n", received, stats.tx);
+    for (int i = 0; i < RX_RESULT_COUNT; i++)
+    {
+        printf("  %-9s %8u\n", rxResultNames[i], stats.rx[i]);
+    }
+    if (stats.rx[RX_PROCESSED])
+    {
+        printf("  host processing time avg %.1fus max %.1fus\n",
+               stats.processingUsSum / stats.rx[RX_PROCESSED], stats.processingUsMax);
+    }
+    return 0;
+}
+
+/** @}*/
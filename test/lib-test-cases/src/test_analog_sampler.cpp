@@ -0,0 +1,122 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Analog sampler Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the interrupt driven burst mode ADC sampling
+ * @details The interrupt handler is called directly after setting the data
+ *          registers like the AD converter would at the end of a scan.
+ *
+ * @{
+ *
+ * @file   test_analog_sampler.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/analog_sampler.h>
+#include <sblib/platform.h>
+
+#define ADC_DONE    0x80000000
+#define ADC_OVERRUN 0x40000000
+
+/**
+ * Emulate the end of a conversion of a channel.
+ */
+static void convert(int channel, unsigned int value, bool overrun = false)
+{
+    LPC_ADC->DR[channel] = ADC_DONE | (overrun ? ADC_OVERRUN : 0) | (value << 6);
+}
+
+TEST_CASE("Analog sampler","[SBLIB][ADC]")
+{
+    LPC_SYSCON->SYSAHBCLKDIV = 1;
+    REQUIRE_FALSE(analogSampler.running());
+
+    SECTION("Burst mode setup")
+    {
+        analogSampler.begin(ANALOG_CHANNEL(AD1) | ANALOG_CHANNEL(AD5));
+        REQUIRE(analogSampler.running());
+        REQUIRE((LPC_ADC->CR & 0xff) == 0x22);
+        REQUIRE(((LPC_ADC->CR >> 8) & 0xff) == SystemCoreClock / ANALOG_SAMPLER_CLOCK - 1);
+        REQUIRE((LPC_ADC->CR & (1 << 16)));
+        REQUIRE((LPC_ADC->CR & (7 << 24)) == 0);
+        REQUIRE(LPC_ADC->INTEN == (1 << AD5));
+        REQUIRE(analogSampler.value(AD1) == -1);
+        REQUIRE(analogSampler.average(AD1) == -1);
+
+        // a scan without finished conversions changes nothing
+        LPC_ADC->DR[AD1] = 0;
+        LPC_ADC->DR[AD5] = 0;
+        analogSampler.interruptHandler();
+        REQUIRE(analogSampler.count(AD1) == 0);
+
+        convert(AD1, 100);
+        convert(AD5, 1023);
+        convert(AD2, 500);  // not sampled
+        analogSampler.interruptHandler();
+        REQUIRE(analogSampler.value(AD1) == 100);
+        REQUIRE(analogSampler.value(AD5) == 1023);
+        REQUIRE(analogSampler.count(AD1) == 1);
+        REQUIRE(analogSampler.count(AD2) == 0);
+        REQUIRE(analogSampler.value(AD2) == -1);
+        REQUIRE(analogSampler.overruns() == 0);
+
+        convert(AD1, 200, true);
+        convert(AD5, 0);
+        analogSampler.interruptHandler();
+        REQUIRE(analogSampler.value(AD1) == 200);
+        REQUIRE(analogSampler.average(AD1) == 150);
+        REQUIRE(analogSampler.average(AD5) == 512);
+        REQUIRE(analogSampler.overruns() == 1);
+    }
+
+    SECTION("Oversampling")
+    {
+        analogSampler.begin(ANALOG_CHANNEL(AD0), 4);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            convert(AD0, 100 + i);
+            analogSampler.interruptHandler();
+        }
+        REQUIRE(analogSampler.count(AD0) == 0);
+        REQUIRE(analogSampler.value(AD0) == -1);
+
+        convert(AD0, 104);
+        analogSampler.interruptHandler();
+        REQUIRE(analogSampler.count(AD0) == 1);
+        REQUIRE(analogSampler.value(AD0) == 102); // (100 + 101 + 102 + 104) / 4 rounded
+    }
+
+    SECTION("Moving average")
+    {
+        analogSampler.begin(ANALOG_CHANNEL(AD7));
+        for (unsigned int i = 0; i < ANALOG_SAMPLER_BUFFER_SIZE; ++i)
+        {
+            convert(AD7, 10);
+            analogSampler.interruptHandler();
+        }
+        REQUIRE(analogSampler.average(AD7) == 10);
+
+        // the oldest values drop out of the average
+        for (unsigned int i = 0; i < ANALOG_SAMPLER_BUFFER_SIZE; ++i)
+        {
+            convert(AD7, 90);
+            analogSampler.interruptHandler();
+            REQUIRE(analogSampler.average(AD7) == (int)(10 * (ANALOG_SAMPLER_BUFFER_SIZE - i - 1) + 90 * (i + 1) + ANALOG_SAMPLER_BUFFER_SIZE / 2) / ANALOG_SAMPLER_BUFFER_SIZE);
+        }
+        REQUIRE(analogSampler.value(AD7) == 90);
+        REQUIRE(analogSampler.count(AD7) == 2 * ANALOG_SAMPLER_BUFFER_SIZE);
+    }
+
+    analogSampler.end();
+    REQUIRE_FALSE(analogSampler.running());
+    REQUIRE(LPC_ADC->CR == 0);
+}
+
+/** @}*/
@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST BCU with compile time table access Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests of the BCU with compile time table access
+ * @details A BcuStatic and a BCU of the same mask get the same tables. Both
+ *          must find the same group addresses and com-object values, and
+ *          process received group telegrams the same way.
+ *
+ * @{
+ *
+ * @file   test_bcu_static.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <protocol.h>
+#include <sblib/eib/bcu_static.h>
+
+#define ADDR_TABLE   0x0116
+#define COMMS_TABLE  0x0130
+#define ASSOC_TABLE  0x0140
+#define FLAGS_TABLE  0x0150
+
+typedef StaticAddrTables<AddrTablesBCU2> StaticAddrTablesBCU2;
+typedef BcuStatic<BCU2, StaticAddrTablesBCU2, StaticComObjects<ComObjectsBCU2, StaticAddrTablesBCU2>, PropertiesBCU2> StaticBCU2;
+
+/**
+ * Write an address table with 3 group addresses, an association table and a
+ * com-object table with a write enabled 1 bit and 2 byte com-object to the user memory.
+ */
+static void setupTables(BcuDefault* bcu, UserEepromBCU2* userEeprom)
+{
+    userEeprom->addrTabAddr() = ADDR_TABLE;
+    userEeprom->commsTabAddr() = COMMS_TABLE;
+    userEeprom->assocTabAddr() = ASSOC_TABLE;
+
+    const byte addrTable[] = { 3, 0x11, 0x01, 0x08, 0x01, 0x08, 0x02, 0x08, 0x03 };
+    memcpy(bcu->userMemoryPtr(ADDR_TABLE), addrTable, sizeof(addrTable));
+
+    const byte commsTable[] = { 2, HIGH_BYTE(FLAGS_TABLE), lowByte(FLAGS_TABLE),
+                                0x00, 0x50, COMCONF_WRITE_COMM, BIT_1,
+                                0x00, 0x52, COMCONF_WRITE_COMM, BYTE_2 };
+    memcpy(bcu->userMemoryPtr(COMMS_TABLE), commsTable, sizeof(commsTable));
+
+    // 0x0801 is associated with com-object 0, 0x0803 with com-object 1
+    const byte assocTable[] = { 2, 1, 0, 3, 1 };
+    memcpy(bcu->userMemoryPtr(ASSOC_TABLE), assocTable, sizeof(assocTable));
+
+    *bcu->userMemoryPtr(FLAGS_TABLE) = 0;
+}
+
+template <class AddrTablesType, class ComObjectsType>
+static void checkTables(BcuDefault* bcu, AddrTablesType* addrTables, ComObjectsType* comObjects)
+{
+    REQUIRE(addrTables->indexOfAddr(0x0801) == 1);
+    REQUIRE(addrTables->indexOfAddr(0x0803) == 3);
+    REQUIRE(addrTables->indexOfAddr(0x0804) == -1);
+
+    REQUIRE(comObjects->objectConfig(1).type == BYTE_2);
+    REQUIRE(comObjects->objectSize(0) == 1);
+    REQUIRE(comObjects->objectSize(1) == 2);
+    REQUIRE(comObjects->objectValuePtr(0) == bcu->userMemoryPtr(0x50));
+    REQUIRE(comObjects->objectValuePtr(1) == bcu->userMemoryPtr(0x52));
+}
+
+/**
+ * Receive group value write telegrams for both com-objects and check that
+ * the values and the update flags are set.
+ */
+static void checkGroupTelegrams(BcuDefault* bcu)
+{
+    REQUIRE(bcu->indexOfGroupAddress(0x0803) == 3);
+    REQUIRE(bcu->indexOfGroupAddress(0x0804) == -1);
+
+    byte bitTelegram[] = { 0xbc, 0x11, 0x01, 0x08, 0x01, 0xe1, 0x00, 0x81 };
+    bcu->comObjects->processGroupTelegram(0x0801, APCI_GROUP_VALUE_WRITE_PDU, bitTelegram);
+    REQUIRE(bcu->comObjects->objectRead(0) == 1);
+
+    byte wordTelegram[] = { 0xbc, 0x11, 0x01, 0x08, 0x03, 0xe3, 0x00, 0x80, 0x12, 0x34 };
+    bcu->comObjects->processGroupTelegram(0x0803, APCI_GROUP_VALUE_WRITE_PDU, wordTelegram);
+    REQUIRE(bcu->comObjects->objectRead(1) == 0x1234);
+
+    REQUIRE(bcu->comObjects->nextUpdatedObject() == 0);
+    REQUIRE(bcu->comObjects->nextUpdatedObject() == 1);
+    REQUIRE(bcu->comObjects->nextUpdatedObject() == INVALID_OBJECT_NUMBER);
+
+    // No transmission is requested
+    REQUIRE_FALSE(bcu->comObjects->sendNextGroupTelegram());
+}
+
+TEST_CASE("BCU with compile time table access","[SBLIB][BCU_STATIC]")
+{
+    IAP_Init_Flash(0xFF);
+
+    SECTION("BCU 2")
+    {
+        BCU2* bcu = new BCU2();
+        setupTables(bcu, bcu->userEeprom);
+        checkTables(bcu, bcu->addrTables, (ComObjectsBCU2*) bcu->comObjects);
+        checkGroupTelegrams(bcu);
+    }
+
+    SECTION("Static BCU 2")
+    {
+        StaticBCU2* bcu = new StaticBCU2(new UserRamBCU2(memoryData<UserRamBCU2, StaticBCU2>()),
+                                           new UserEepromBCU2(memoryData<UserEepromBCU2, StaticBCU2>()));
+        setupTables(bcu, bcu->userEeprom);
+        checkTables(bcu, bcu->staticAddrTables(), bcu->staticComObjects());
+
+        // The virtual interface is kept
+        checkTables(bcu, bcu->addrTables, (ComObjectsBCU2*) bcu->comObjects);
+        checkGroupTelegrams(bcu);
+    }
+}
+
+/** @}*/
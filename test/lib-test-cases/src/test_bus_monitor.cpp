@@ -0,0 +1,224 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Bus monitor Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the binary bus monitor stream and its host side decoder
+ * @details The frames are captured by calling the end of telegram handling of
+ *          the bus directly, as the bus timer interrupt handler would do.
+ *
+ * @{
+ *
+ * @file   test_bus_monitor.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <protocol.h>
+#include <sblib/buffered_stream.h>
+#include <sblib/eib/bus_const.h>
+#include <sblib/eib/bus_monitor.h>
+#include <sblib/timer.h>
+#include <vector>
+#include "../busmon/busmon_decoder.h"
+
+/**
+ * A stream that collects the written bytes and takes only a limited number
+ * of bytes without waiting.
+ */
+class TestStream: public BufferedStream
+{
+public:
+    TestStream(int space = BUFFER_SIZE - 1)
+    {
+        clearBuffers();
+        writeHead = (space + 1) & BUFFER_SIZE_MASK;
+    }
+
+    virtual int write(byte ch)
+    {
+        bytes.push_back(ch);
+        return 1;
+    }
+
+    virtual void flush() {}
+
+    std::vector<byte> bytes;
+};
+
+/**
+ * Decode all records of the bytes.
+ */
+static std::vector<BusMonitorRecord> decode(BusMonitorDecoder& decoder, const std::vector<byte>& bytes)
+{
+    std::vector<BusMonitorRecord> records;
+    for (byte ch : bytes)
+    {
+        if (decoder.decode(ch))
+            records.push_back(decoder.record());
+    }
+    return records;
+}
+
+TEST_CASE("Bus monitor records","[SBLIB][BUSMON]")
+{
+    const unsigned int load = SysTick->LOAD;
+    SysTick->LOAD = 47999;
+    SCB->ICSR = 0;
+
+    BusMonitor monitor;
+    BusMonitorDecoder decoder;
+    TestStream out;
+    const byte telegram[] = { 0xbc, 0x11, 0x01, 0x09, 0x01, 0xe1, 0x00, 0x81, 0x35 };
+    const byte ack[] = { SB_BUS_ACK };
+
+    SECTION("Capture and decode")
+    {
+        setMillis(5000);
+        SysTick->VAL = 47999 - 24000;
+        monitor.capture(telegram, sizeof(telegram), BUS_MONITOR_VALID, RX_OK);
+        setMillis(5002);
+        SysTick->VAL = 47999;
+        monitor.capture(ack, 1, BUS_MONITOR_ACK | BUS_MONITOR_VALID, RX_OK);
+        monitor.capture(telegram, 3, 0, RX_CHECKSUM_ERROR | RX_PARITY_ERROR);
+        REQUIRE(monitor.available() == 3 * BUS_MONITOR_HEADER_SIZE + sizeof(telegram) + 1 + 3);
+
+        int pending = monitor.available();
+        REQUIRE(monitor.stream(out) == pending);
+        REQUIRE(monitor.available() == 0);
+        REQUIRE(out.bytes[0] == BUS_MONITOR_SYNC);
+        REQUIRE(out.bytes[1] == sizeof(telegram));
+
+        std::vector<BusMonitorRecord> records = decode(decoder, out.bytes);
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].timeUs == 5000500);
+        REQUIRE(records[0].flags == BUS_MONITOR_VALID);
+        REQUIRE(records[0].errors == RX_OK);
+        REQUIRE(records[0].length == sizeof(telegram));
+        REQUIRE(memcmp(records[0].bytes, telegram, sizeof(telegram)) == 0);
+        REQUIRE(records[1].timeUs == 5002000);
+        REQUIRE(records[1].flags == (BUS_MONITOR_ACK | BUS_MONITOR_VALID));
+        REQUIRE(records[1].length == 1);
+        REQUIRE(records[1].bytes[0] == SB_BUS_ACK);
+        REQUIRE(records[2].flags == 0);
+        REQUIRE(records[2].errors == (RX_CHECKSUM_ERROR | RX_PARITY_ERROR));
+        REQUIRE(records[2].length == 3);
+        REQUIRE(decoder.skipped() == 0);
+    }
+
+    SECTION("Stream only what fits")
+    {
+        TestStream smallOut(5);
+        monitor.capture(telegram, sizeof(telegram), BUS_MONITOR_VALID, RX_OK);
+        REQUIRE(monitor.stream(smallOut) == 5);
+        REQUIRE(monitor.available() == BUS_MONITOR_HEADER_SIZE + sizeof(telegram) - 5);
+        REQUIRE(decode(decoder, smallOut.bytes).empty());
+
+        REQUIRE(monitor.stream(out) == BUS_MONITOR_HEADER_SIZE + sizeof(telegram) - 5);
+        std::vector<BusMonitorRecord> records = decode(decoder, out.bytes);
+        REQUIRE(records.size() == 1);
+        REQUIRE(memcmp(records[0].bytes, telegram, sizeof(telegram)) == 0);
+    }
+
+    SECTION("Full ring buffer drops records")
+    {
+        const int recordSize = BUS_MONITOR_HEADER_SIZE + sizeof(telegram);
+        const int fit = (BUS_MONITOR_BUFFER_SIZE - 1) / recordSize;
+        for (int i = 0; i < fit + 2; ++i)
+        {
+            monitor.capture(telegram, sizeof(telegram), BUS_MONITOR_VALID, RX_OK);
+        }
+        REQUIRE(monitor.available() == fit * recordSize);
+        REQUIRE(monitor.lost() == 2);
+
+        while (monitor.stream(out))
+            ;
+        monitor.capture(ack, 1, BUS_MONITOR_ACK | BUS_MONITOR_VALID, RX_OK);
+        monitor.capture(ack, 1, BUS_MONITOR_ACK | BUS_MONITOR_VALID, RX_OK);
+        monitor.stream(out);
+
+        std::vector<BusMonitorRecord> records = decode(decoder, out.bytes);
+        REQUIRE(records.size() == fit + 2);
+        REQUIRE(records[fit].flags == (BUS_MONITOR_ACK | BUS_MONITOR_VALID | BUS_MONITOR_LOST));
+        REQUIRE(records[fit + 1].flags == (BUS_MONITOR_ACK | BUS_MONITOR_VALID));
+
+        monitor.clear();
+        REQUIRE(monitor.lost() == 0);
+        REQUIRE(monitor.available() == 0);
+    }
+
+    SECTION("Decoder synchronizes to the records")
+    {
+        monitor.capture(telegram, sizeof(telegram), BUS_MONITOR_VALID, RX_OK);
+        monitor.capture(ack, 1, BUS_MONITOR_ACK | BUS_MONITOR_VALID, RX_OK);
+
+        // the end of a record, and a sync byte that is no record
+        out.bytes = { 0x81, 0x35, BUS_MONITOR_SYNC, 0x7f, 0x00 };
+        monitor.stream(out);
+
+        std::vector<BusMonitorRecord> records = decode(decoder, out.bytes);
+        REQUIRE(records.size() == 2);
+        REQUIRE(records[0].length == sizeof(telegram));
+        REQUIRE(records[1].length == 1);
+        REQUIRE(decoder.skipped() == 5);
+    }
+
+    SECTION("Decoder extends the time stamps")
+    {
+        setMillis(4294967); // micros() overflows after 4294967.296 milliseconds
+        SysTick->VAL = 47999;
+        monitor.capture(ack, 1, BUS_MONITOR_ACK, RX_OK);
+        setMillis(4294968);
+        monitor.capture(ack, 1, BUS_MONITOR_ACK, RX_OK);
+        monitor.stream(out);
+
+        std::vector<BusMonitorRecord> records = decode(decoder, out.bytes);
+        REQUIRE(records.size() == 2);
+        REQUIRE(records[0].timeUs == 4294967000ULL);
+        REQUIRE(records[1].timeUs == 4294968000ULL);
+    }
+
+    SECTION("Bus captures all frames")
+    {
+        IAP_Init_Flash(0xFF);
+        BCU2* bcu = new BCU2();
+        bcu->begin(0x4, 0x2060, 0x1);
+        Bus* bus = bcu->bus;
+        bus->setMonitor(&monitor);
+
+        // occupy the receive buffer, the telegram is captured nevertheless
+        bus->telegramLen = 1;
+        receiveFrame(bus, telegram, sizeof(telegram), false);
+        REQUIRE(bus->telegramLen == 1);
+
+        // the checksum error of an acknowledge frame is no error
+        receiveFrame(bus, ack, 1, false, RX_CHECKSUM_ERROR);
+        receiveFrame(bus, telegram, 5, false, RX_CHECKSUM_ERROR | RX_PARITY_ERROR, false);
+
+        bus->setMonitor(nullptr);
+        receiveFrame(bus, telegram, sizeof(telegram), false);
+
+        monitor.stream(out);
+        std::vector<BusMonitorRecord> records = decode(decoder, out.bytes);
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].flags == BUS_MONITOR_VALID);
+        REQUIRE(records[0].length == sizeof(telegram));
+        REQUIRE(records[1].flags == (BUS_MONITOR_ACK | BUS_MONITOR_VALID));
+        REQUIRE(records[1].errors == RX_OK);
+        REQUIRE(records[2].flags == 0);
+        REQUIRE(records[2].errors == (RX_CHECKSUM_ERROR | RX_PARITY_ERROR));
+        REQUIRE(records[2].length == 5);
+        bus->telegramLen = 0;
+    }
+
+    SysTick->LOAD = load;
+    SysTick->VAL = 0;
+    setMillis(0);
+}
+
+/** @}*/
@@ -0,0 +1,147 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Bus receive Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for handing received telegrams from the bus to the higher layers
+ * @details The frames are received by calling the end of telegram handling of
+ *          the bus directly, as the bus timer interrupt handler would do.
+ *
+ * @{
+ *
+ * @file   test_bus_receive.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <protocol.h>
+#include <sblib/eib/bus_const.h>
+
+TEST_CASE("Bus receive buffer hand-off","[SBLIB][BUS]")
+{
+    IAP_Init_Flash(0xFF);
+    BCU2* bcu = new BCU2();
+    bcu->begin(0x4, 0x2060, 0x1);
+    bcu->setOwnAddress(0x1140);
+    Bus* bus = bcu->bus;
+
+    // T_Connect from 1.1.5 to our own address, not repeated
+    const byte connect[] = { 0xb0, 0x11, 0x05, 0x11, 0x40, 0x60, 0x80 };
+    const byte disconnect[] = { 0xb0, 0x11, 0x05, 0x11, 0x40, 0x60, 0x81 };
+
+    SECTION("Received telegram is handed over without copying")
+    {
+        byte* rxBuffer = bus->rx_telegram;
+        receiveFrame(bus, connect, sizeof(connect), true);
+        REQUIRE(bus->telegramReceived());
+        REQUIRE(bus->telegramLen == sizeof(connect) + 1);
+        REQUIRE(bus->telegram == rxBuffer);
+        REQUIRE(memcmp(bus->telegram, connect, sizeof(connect)) == 0);
+        REQUIRE(bus->rx_telegram != rxBuffer);
+    }
+
+    SECTION("Telegram is kept until it is discarded")
+    {
+        receiveFrame(bus, connect, sizeof(connect), true);
+        byte* received = bus->telegram;
+
+        receiveFrame(bus, disconnect, sizeof(disconnect), true);
+        REQUIRE(bus->rx_error & RX_BUFFER_BUSY);
+        REQUIRE(bus->telegram == received);
+        REQUIRE(memcmp(bus->telegram, connect, sizeof(connect)) == 0);
+
+        bus->discardReceivedTelegram();
+        receiveFrame(bus, disconnect, sizeof(disconnect), true);
+        REQUIRE(bus->telegramReceived());
+        REQUIRE(bus->telegram != received);
+        REQUIRE(memcmp(bus->telegram, disconnect, sizeof(disconnect)) == 0);
+    }
+
+    SECTION("Repetition of the last telegram is not handed over again")
+    {
+        receiveFrame(bus, connect, sizeof(connect), true);
+        bus->discardReceivedTelegram();
+
+        byte repeated[sizeof(connect)];
+        memcpy(repeated, connect, sizeof(connect));
+        repeated[0] &= ~SB_TEL_REPEAT_FLAG;
+        receiveFrame(bus, repeated, sizeof(repeated), true);
+        REQUIRE_FALSE(bus->telegramReceived());
+    }
+
+    SECTION("Repetition is detected after other telegrams")
+    {
+        receiveFrame(bus, connect, sizeof(connect), true);
+        bus->discardReceivedTelegram();
+        receiveFrame(bus, disconnect, sizeof(disconnect), true);
+
+        // the buffer is busy, the repetition is acknowledged but not handed over
+        byte repeated[sizeof(connect)];
+        memcpy(repeated, connect, sizeof(connect));
+        repeated[0] &= ~SB_TEL_REPEAT_FLAG;
+        receiveFrame(bus, repeated, sizeof(repeated), true);
+        REQUIRE_FALSE(bus->rx_error & RX_BUFFER_BUSY);
+        REQUIRE(memcmp(bus->telegram, disconnect, sizeof(disconnect)) == 0);
+
+        bus->discardReceivedTelegram();
+        receiveFrame(bus, repeated, sizeof(repeated), true);
+        REQUIRE_FALSE(bus->telegramReceived());
+    }
+
+    SECTION("Repetition with other data is handed over")
+    {
+        receiveFrame(bus, connect, sizeof(connect), true);
+        bus->discardReceivedTelegram();
+
+        byte repeated[sizeof(disconnect)];
+        memcpy(repeated, disconnect, sizeof(disconnect));
+        repeated[0] &= ~SB_TEL_REPEAT_FLAG;
+        receiveFrame(bus, repeated, sizeof(repeated), true);
+        REQUIRE(bus->telegramReceived());
+    }
+
+    SECTION("Repetition is handed over after the history timeout")
+    {
+        receiveFrame(bus, connect, sizeof(connect), true);
+        bus->discardReceivedTelegram();
+
+        setMillis(millis() + RX_HISTORY_TIMEOUT);
+        byte repeated[sizeof(connect)];
+        memcpy(repeated, connect, sizeof(connect));
+        repeated[0] &= ~SB_TEL_REPEAT_FLAG;
+        receiveFrame(bus, repeated, sizeof(repeated), true);
+        REQUIRE(bus->telegramReceived());
+    }
+
+    SECTION("Destination is decided while receiving")
+    {
+        const byte otherDest[] = { 0xb0, 0x11, 0x05, 0x11, 0x41, 0x60, 0x80 };
+        memcpy(bus->rx_telegram, otherDest, 6);
+        bus->nextByteIndex = 6;
+        bus->checkDestination();
+        REQUIRE(bus->rxDestination == Bus::RX_DESTINATION_OTHER);
+
+        memcpy(bus->rx_telegram, connect, 6);
+        bus->checkDestination();
+        REQUIRE(bus->rxDestination == Bus::RX_DESTINATION_OURS);
+
+        // the end of the telegram uses the decision
+        bus->rxDestination = Bus::RX_DESTINATION_OTHER;
+        receiveFrame(bus, connect, sizeof(connect), true);
+        REQUIRE_FALSE(bus->telegramReceived());
+        REQUIRE(bus->rxDestination == Bus::RX_DESTINATION_UNKNOWN);
+
+        receiveFrame(bus, connect, sizeof(connect), true);
+        REQUIRE(bus->telegramReceived());
+    }
+
+    bus->discardReceivedTelegram();
+    setMillis(0);
+}
+
+/** @}*/
@@ -0,0 +1,105 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Debouncer bank Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the port-wide vertical counter debouncer
+ * @details The port inputs are emulated by writing the DATA register of the
+ *          emulated GPIO ports.
+ *
+ * @{
+ *
+ * @file   test_debounce.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/debounce.h>
+#include <sblib/digital_pin.h>
+#include <sblib/platform.h>
+#include <sblib/timer.h>
+
+TEST_CASE("Debouncer bank","[SBLIB][DEBOUNCE]")
+{
+    gpioPorts[PIO1]->DATA = 0;
+    gpioPorts[PIO2]->DATA = 0x0f0;
+
+    DebouncerBank bank;
+    bank.addPins(PIO2, 0x0ff);
+    bank.addPin(PIO1_8);
+    REQUIRE(bank.value(PIO2) == 0x0f0);
+    REQUIRE(bank.value(PIO1) == 0);
+    REQUIRE(bank.value(PIO0) == 0);
+    REQUIRE_FALSE(bank.pinValue(PIO1_8));
+    REQUIRE(bank.pinValue(PIO2_4));
+
+    SECTION("Change after 4 equal samples")
+    {
+        gpioPorts[PIO2]->DATA = 0xf0f;  // the upper 4 pins are not selected
+        gpioPorts[PIO1]->DATA = 1 << 8;
+        for (int i = 0; i < 3; ++i)
+        {
+            REQUIRE_FALSE(bank.sample());
+            REQUIRE(bank.value(PIO2) == 0x0f0);
+        }
+        REQUIRE(bank.sample());
+        REQUIRE(bank.value(PIO2) == 0x00f);
+        REQUIRE(bank.pinValue(PIO1_8));
+        REQUIRE(bank.changed(PIO2) == 0x0ff);
+        REQUIRE(bank.changed(PIO2) == 0);
+        REQUIRE(bank.changed(PIO1) == 1 << 8);
+
+        // stable input does not change again
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE_FALSE(bank.sample());
+        }
+        REQUIRE(bank.value(PIO2) == 0x00f);
+    }
+
+    SECTION("Bouncing input restarts the counter")
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            gpioPorts[PIO2]->DATA = 0x0f1;
+            REQUIRE_FALSE(bank.sample());
+            REQUIRE_FALSE(bank.sample());
+            REQUIRE_FALSE(bank.sample());
+            gpioPorts[PIO2]->DATA = 0x0f0;
+            REQUIRE_FALSE(bank.sample());
+        }
+
+        gpioPorts[PIO2]->DATA = 0x0f1;
+        REQUIRE_FALSE(bank.sample());
+        REQUIRE_FALSE(bank.sample());
+        REQUIRE_FALSE(bank.sample());
+        REQUIRE(bank.sample());
+        REQUIRE(bank.value(PIO2) == 0x0f1);
+        REQUIRE(bank.changed(PIO2) == 0x001);
+    }
+
+    SECTION("Sample interval")
+    {
+        setMillis(1000);
+        REQUIRE_FALSE(bank.debounce(5));
+
+        gpioPorts[PIO2]->DATA = 0x0e0;
+        for (int ms = 1; ms < 20; ++ms)
+        {
+            setMillis(1000 + ms);
+            REQUIRE_FALSE(bank.debounce(5));
+        }
+        setMillis(1020);
+        REQUIRE(bank.debounce(5));
+        REQUIRE(bank.debounce(5));
+        REQUIRE(bank.changed(PIO2) == 0x010);
+        REQUIRE_FALSE(bank.debounce(5));
+    }
+}
+
+/** @}*/
@@ -0,0 +1,127 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST DHT Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the capture based, non-blocking DHT read
+ * @details The interrupt handler is called directly after setting the
+ *          timer flags and the capture register like the hardware would.
+ *
+ * @{
+ *
+ * @file   test_dht.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/core.h>
+#include <sblib/timer.h>
+#include <sblib/sensors/dht.h>
+
+#define DHT_TEST_PIN PIO1_5 //!< CT32B0_CAP0
+
+static void matchInterrupt(DHT& dht)
+{
+    LPC_TMR32B0->IR = 1 << MAT0;
+    dht.DHTTimerInterruptHandler();
+}
+
+static void captureInterrupt(DHT& dht, unsigned int time)
+{
+    LPC_TMR32B0->CR0 = time;
+    LPC_TMR32B0->IR = 16 << CAP0;
+    dht.DHTTimerInterruptHandler();
+}
+
+/**
+ * Send the falling edges of a DHT answer.
+ *
+ * @param dht   - the DHT to receive the answer
+ * @param data  - the 5 data bytes
+ * @param start - timer value of the response start
+ * @param bits  - number of bits to send
+ */
+static void sendAnswer(DHT& dht, const uint8_t* data, unsigned int start, int bits)
+{
+    unsigned int time = start;
+    captureInterrupt(dht, time);
+    time += 160;                  // 80us low, 80us high
+    captureInterrupt(dht, time);
+    for (int i = 0; i < bits; i++)
+    {
+        bool bit = data[i / 8] & (0x80 >> (i % 8));
+        time += bit ? 120 : 78;   // 50us low, 70us or 28us high
+        captureInterrupt(dht, time);
+    }
+}
+
+TEST_CASE("DHT capture based read","[SBLIB][DHT]")
+{
+    DHT dht;
+    dht.DHTInit(DHT_TEST_PIN, DHT22);
+
+    REQUIRE_FALSE(dht.startReadData(true));
+    REQUIRE(dht._lastError == BUS_BUSY);
+
+    dht.DHTTimerInit(timer32_0, CAP0);
+    LPC_TMR32B0->TC = 0;
+    REQUIRE(dht.startReadData(true));
+    REQUIRE(LPC_TMR32B0->MR0 == 1100);
+    REQUIRE(dht._lastError == BUS_BUSY);
+    REQUIRE_FALSE(dht.startReadData(true));
+    REQUIRE_FALSE(dht.finishReadData());
+
+    matchInterrupt(dht);
+    REQUIRE(LPC_TMR32B0->MR0 == 10000);
+
+    SECTION("Valid answer")
+    {
+        // 65.2 %, -10.1 degrees celsius
+        uint8_t data[5] = {0x02, 0x8C, 0x80, 0x65, 0x00};
+        data[4] = data[0] + data[1] + data[2] + data[3];
+        sendAnswer(dht, data, 65500, 40); // the 16 bit edge times wrap
+
+        REQUIRE(dht.finishReadData());
+        REQUIRE(dht._lastError == ERROR_NONE);
+        REQUIRE(dht._lastHumidity == Approx(65.2f));
+        REQUIRE(dht._lastTemperature == Approx(-10.1f));
+        REQUIRE_FALSE(dht.finishReadData());
+    }
+
+    SECTION("Checksum error")
+    {
+        uint8_t data[5] = {0x02, 0x8C, 0x00, 0xE1, 0x00};
+        sendAnswer(dht, data, 30, 40);
+
+        REQUIRE_FALSE(dht.finishReadData());
+        REQUIRE(dht._lastError == ERROR_CHECKSUM);
+    }
+
+    SECTION("Answer too short")
+    {
+        uint8_t data[5] = {0x02, 0x8C, 0x00, 0xE1, 0x6F};
+        sendAnswer(dht, data, 30, 20);
+        REQUIRE_FALSE(dht.finishReadData());
+
+        matchInterrupt(dht);
+        REQUIRE_FALSE(dht.finishReadData());
+        REQUIRE(dht._lastError == ERROR_DATA_TIMEOUT);
+    }
+
+    SECTION("No sensor")
+    {
+        matchInterrupt(dht);
+        REQUIRE_FALSE(dht.finishReadData());
+        REQUIRE(dht._lastError == ERROR_NOT_PRESENT);
+    }
+
+    // idle again
+    REQUIRE(dht.startReadData(true));
+}
+
+/** @}*/
@@ -0,0 +1,240 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST FT1.2 interface Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the serial KNX data link interface
+ * @details The host side of the serial port is emulated by a stream, the end of
+ *          sending a telegram is emulated by finishing it on the bus directly.
+ *
+ * @{
+ *
+ * @file   test_ft12_interface.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <protocol.h>
+#include <sblib/buffered_stream.h>
+#include <sblib/eib/bus_const.h>
+#include <sblib/eib/ft12_interface.h>
+#include <vector>
+
+typedef std::vector<byte> Bytes;
+
+/**
+ * The serial port to the host: the host writes into the read buffer, the
+ * bytes the interface writes are collected.
+ */
+class HostPort: public BufferedStream
+{
+public:
+    HostPort()
+    {
+        clearBuffers();
+    }
+
+    void hostWrite(const Bytes& data)
+    {
+        for (byte ch : data)
+        {
+            readBuffer[readTail] = ch;
+            readTail = (readTail + 1) & BUFFER_SIZE_MASK;
+        }
+    }
+
+    virtual int write(byte ch)
+    {
+        written.push_back(ch);
+        return 1;
+    }
+
+    virtual void flush() {}
+
+    /**
+     * @return The bytes written by the interface since the last call.
+     */
+    Bytes take()
+    {
+        Bytes result = written;
+        written.clear();
+        return result;
+    }
+
+    Bytes written;
+};
+
+/**
+ * Build a variable length FT1.2 frame.
+ */
+static Bytes frame(byte cf, byte code, const Bytes& telegram)
+{
+    Bytes result = { 0x68, (byte) (telegram.size() + 2), (byte) (telegram.size() + 2), 0x68, cf, code };
+    byte sum = cf + code;
+    for (byte ch : telegram)
+    {
+        result.push_back(ch);
+        sum += ch;
+    }
+    result.push_back(sum);
+    result.push_back(0x16);
+    return result;
+}
+
+static const Bytes ack = { 0xe5 };
+
+TEST_CASE("FT1.2 interface","[SBLIB][FT12]")
+{
+    IAP_Init_Flash(0xFF);
+    BCU2* bcu = new BCU2();
+    bcu->begin(0x4, 0x2060, 0x1);
+    bcu->setOwnAddress(0x1140);
+    Bus* bus = bcu->bus;
+
+    HostPort port;
+    Ft12Interface knxInterface(bcu, port);
+    const byte status = bcu->userRam->status();
+    knxInterface.begin();
+    REQUIRE_FALSE(bcu->userRam->status() & BCU_STATUS_TRANSPORT_LAYER);
+    REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE);
+
+    const Bytes groupWrite = { 0xbc, 0x00, 0x00, 0x09, 0x01, 0xe1, 0x00, 0x81 };
+    Bytes sentGroupWrite = groupWrite;
+    sentGroupWrite[1] = 0x11; // the source is our own address
+    sentGroupWrite[2] = 0x40;
+
+    port.hostWrite({ 0x10, 0x40, 0x40, 0x16 }); // reset
+    knxInterface.loop();
+    REQUIRE(port.take() == ack);
+
+    SECTION("Send a telegram")
+    {
+        port.hostWrite(frame(0x73, FT12_L_DATA_REQ, groupWrite));
+        knxInterface.loop();
+        REQUIRE(port.take() == ack);
+        REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE - 1);
+        REQUIRE(bus->sendCurTelegram != nullptr);
+        REQUIRE(Bytes(bus->sendCurTelegram, bus->sendCurTelegram + groupWrite.size()) == sentGroupWrite);
+
+        // a repetition is acknowledged but not sent again
+        port.hostWrite(frame(0x73, FT12_L_DATA_REQ, groupWrite));
+        knxInterface.loop();
+        REQUIRE(port.take() == ack);
+        REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE - 1);
+
+        bus->tx_error = TX_OK;
+        bus->finishSendingTelegram();
+        knxInterface.loop();
+        REQUIRE(port.take() == frame(0xf3, FT12_L_DATA_CON, sentGroupWrite));
+        REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE);
+
+        // a telegram that is not acknowledged on the bus is confirmed negatively
+        port.hostWrite(frame(0x53, FT12_L_DATA_REQ, groupWrite));
+        knxInterface.loop();
+        REQUIRE(port.take() == ack);
+        bus->tx_error = TX_RETRY_ERROR;
+        bus->finishSendingTelegram();
+        knxInterface.loop();
+        Bytes failed = sentGroupWrite;
+        failed[0] |= 1;
+        REQUIRE(port.take() == frame(0xd3, FT12_L_DATA_CON, failed));
+    }
+
+    SECTION("Pipelined telegrams in the send window")
+    {
+        byte cf = 0x73;
+        for (int i = 0; i < FT12_WINDOW_SIZE; ++i)
+        {
+            Bytes telegram = groupWrite;
+            telegram[7] = i;
+            port.hostWrite(frame(cf, FT12_L_DATA_REQ, telegram));
+            cf ^= 0x20;
+        }
+        knxInterface.loop();
+        REQUIRE(port.take() == Bytes(FT12_WINDOW_SIZE, 0xe5));
+        REQUIRE(knxInterface.freeSlots() == 0);
+
+        // the window is full, the frame is not acknowledged
+        port.hostWrite(frame(cf, FT12_L_DATA_REQ, groupWrite));
+        knxInterface.loop();
+        REQUIRE(port.take().empty());
+
+        // the telegrams are sent and confirmed in order
+        for (int i = 0; i < FT12_WINDOW_SIZE; ++i)
+        {
+            REQUIRE(bus->sendCurTelegram[7] == i);
+            bus->tx_error = TX_OK;
+            bus->finishSendingTelegram();
+            knxInterface.loop();
+            Bytes confirmed = port.take();
+            REQUIRE(confirmed.size() == groupWrite.size() + 8);
+            REQUIRE(confirmed[5] == FT12_L_DATA_CON);
+            REQUIRE(confirmed[6 + 7] == i);
+        }
+        REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE);
+        REQUIRE(bus->sendCurTelegram == nullptr);
+
+        // the repeated frame is accepted now
+        port.hostWrite(frame(cf, FT12_L_DATA_REQ, groupWrite));
+        knxInterface.loop();
+        REQUIRE(port.take() == ack);
+        REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE - 1);
+        bus->finishSendingTelegram();
+    }
+
+    SECTION("Invalid frames")
+    {
+        Bytes badChecksum = frame(0x73, FT12_L_DATA_REQ, groupWrite);
+        badChecksum[badChecksum.size() - 2] ^= 1;
+        port.hostWrite(badChecksum);
+        knxInterface.loop();
+        REQUIRE(port.take().empty());
+        REQUIRE(knxInterface.freeSlots() == FT12_WINDOW_SIZE);
+
+        // an incomplete frame is discarded after a timeout
+        Bytes incomplete = frame(0x73, FT12_L_DATA_REQ, groupWrite);
+        incomplete.resize(6);
+        port.hostWrite(incomplete);
+        knxInterface.loop();
+        setMillis(millis() + FT12_RX_TIMEOUT + 1);
+        port.hostWrite(frame(0x73, FT12_L_DATA_REQ, groupWrite));
+        knxInterface.loop();
+        REQUIRE(port.take() == ack);
+
+        // a telegram whose length does not match is confirmed negatively without sending
+        bus->finishSendingTelegram();
+        knxInterface.loop();
+        port.take();
+        Bytes tooShort = groupWrite;
+        tooShort.pop_back();
+        port.hostWrite(frame(0x53, FT12_L_DATA_REQ, tooShort));
+        knxInterface.loop();
+        tooShort[0] |= 1;
+        Bytes expected = ack;
+        Bytes confirmation = frame(0xd3, FT12_L_DATA_CON, tooShort);
+        expected.insert(expected.end(), confirmation.begin(), confirmation.end());
+        REQUIRE(port.take() == expected);
+        REQUIRE(bus->sendCurTelegram == nullptr);
+    }
+
+    SECTION("Received telegrams")
+    {
+        const Bytes received = { 0xbc, 0x11, 0x05, 0x09, 0x01, 0xe1, 0x00, 0x80, 0x00 };
+        memcpy(bus->telegram, received.data(), received.size());
+        bus->telegramLen = received.size();
+        knxInterface.loop();
+        REQUIRE(port.take() == frame(0xf3, FT12_L_DATA_IND, Bytes(received.begin(), received.end() - 1)));
+        REQUIRE_FALSE(bus->telegramReceived());
+    }
+
+    knxInterface.end();
+    REQUIRE(bcu->userRam->status() == status);
+    setMillis(0);
+}
+
+/** @}*/
@@ -0,0 +1,137 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Gas index fixed-point Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Compare the fixed-point gas index algorithm with the float reference
+ * @details Both algorithms process the same generated raw signal traces:
+ *          a baseline with a daily drift, noise and a gas event every 3 hours.
+ *          The fixed-point gas index may differ by at most 2 index points
+ *          from the float reference, 0.25 on average.
+ *
+ * @{
+ *
+ * @file   test_gas_index_fix16.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <catch.hpp>
+#include <sblib/i2c/sensirion_gas_index_algorithm.h>
+#include <sblib/i2c/sensirion_gas_index_algorithm_fix16.h>
+
+#define MAX_INDEX_DIFFERENCE  2
+#define MEAN_INDEX_DIFFERENCE 0.25
+
+/**
+ * Generate a raw signal trace and compare the gas index of both algorithms.
+ *
+ * @param algorithmType     GasIndexAlgorithm_ALGORITHM_TYPE_VOC or GasIndexAlgorithm_ALGORITHM_TYPE_NOX
+ * @param samplingInterval  sampling interval in seconds
+ * @param days              duration of the trace in days
+ */
+static void compareTrace(int32_t algorithmType, int samplingInterval, int days)
+{
+    GasIndexAlgorithmParams reference;
+    GasIndexAlgorithmFix16Params fixed;
+    GasIndexAlgorithm_init_with_sampling_interval(&reference, algorithmType, (float) samplingInterval);
+    GasIndexAlgorithmFix16_init_with_sampling_interval(&fixed, algorithmType, samplingInterval * F16(1.));
+
+    bool voc = (algorithmType == GasIndexAlgorithm_ALGORITHM_TYPE_VOC);
+    uint32_t seed = 12345;
+    long samples = days * 86400L / samplingInterval;
+    int maxDifference = 0;
+    long sumDifference = 0;
+    int32_t maxIndex = 0;
+
+    for (long i = 0; i < samples; i++)
+    {
+        long time = i * samplingInterval;
+        double sraw = (voc ? 30000 : 15000) + 800 * sin(time * 2 * M_PI / 86400);
+
+        long eventTime = time % 10800;
+        if (eventTime < 1200)
+        {
+            // VOC events lower the raw signal, NOx events raise it
+            sraw += (voc ? -4000 : 3000) * sin(eventTime * M_PI / 1200);
+        }
+
+        seed = seed * 1103515245u + 12345u;
+        int noise = voc ? 30 : 8;
+        sraw += (int)((seed >> 16) % (2 * noise + 1)) - noise;
+
+        int32_t referenceIndex;
+        int32_t fixedIndex;
+        GasIndexAlgorithm_process(&reference, (int32_t) sraw, &referenceIndex);
+        GasIndexAlgorithmFix16_process(&fixed, (int32_t) sraw, &fixedIndex);
+
+        int difference = abs(referenceIndex - fixedIndex);
+        if (difference > maxDifference)
+        {
+            maxDifference = difference;
+        }
+        sumDifference += difference;
+        if (referenceIndex > maxIndex)
+        {
+            maxIndex = referenceIndex;
+        }
+    }
+
+    INFO("samples " << samples << " max difference " << maxDifference
+         << " mean difference " << ((double) sumDifference / samples));
+    REQUIRE(maxIndex > (voc ? 200 : 20)); // the events must be visible
+    REQUIRE(maxDifference <= MAX_INDEX_DIFFERENCE);
+    REQUIRE(((double) sumDifference / samples) <= MEAN_INDEX_DIFFERENCE);
+}
+
+TEST_CASE("Fixed-point gas index algorithm","[SBLIB][I2C][GAS_INDEX]")
+{
+    SECTION("VOC, 1s sampling interval, 7 days")
+    {
+        compareTrace(GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 1, 7);
+    }
+
+    SECTION("VOC, 10s sampling interval, 7 days")
+    {
+        compareTrace(GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 10, 7);
+    }
+
+    SECTION("NOx, 1s sampling interval, 7 days")
+    {
+        compareTrace(GasIndexAlgorithm_ALGORITHM_TYPE_NOX, 1, 7);
+    }
+
+    SECTION("NOx, 10s sampling interval, 7 days")
+    {
+        compareTrace(GasIndexAlgorithm_ALGORITHM_TYPE_NOX, 10, 7);
+    }
+
+    SECTION("Tuning parameters")
+    {
+        GasIndexAlgorithmFix16Params fixed;
+        GasIndexAlgorithmFix16_init(&fixed, GasIndexAlgorithm_ALGORITHM_TYPE_VOC);
+        GasIndexAlgorithmFix16_set_tuning_parameters(&fixed, 150, 24, 48, 60, 100, 300);
+
+        int32_t indexOffset, learningTimeOffset, learningTimeGain, gatingMaxDuration, stdInitial, gainFactor;
+        GasIndexAlgorithmFix16_get_tuning_parameters(&fixed, &indexOffset, &learningTimeOffset, &learningTimeGain,
+                                                     &gatingMaxDuration, &stdInitial, &gainFactor);
+        REQUIRE(indexOffset == 150);
+        REQUIRE(learningTimeOffset == 24);
+        REQUIRE(learningTimeGain == 48);
+        REQUIRE(gatingMaxDuration == 60);
+        REQUIRE(stdInitial == 100);
+        REQUIRE(gainFactor == 300);
+
+        fix16_t samplingInterval;
+        GasIndexAlgorithmFix16_get_sampling_interval(&fixed, &samplingInterval);
+        REQUIRE(samplingInterval == F16(1.));
+    }
+}
+
+/** @}*/
@@ -0,0 +1,144 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST I2C Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the queued I2C master transfers
+ * @details The state handler is called directly after setting the status
+ *          register like the hardware would.
+ *
+ * @{
+ *
+ * @file   test_i2c.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/core.h>
+#include <sblib/i2c.h>
+
+static int callbackCount;
+static I2C_MASTER_REQ_T* callbackReq;
+
+static void testCallback(I2C_MASTER_REQ_T* req)
+{
+    callbackCount++;
+    callbackReq = req;
+}
+
+static void stateChange(uint32_t stat)
+{
+    *((volatile uint32_t *) &LPC_I2C->STAT) = stat;
+    Chip_I2C_MasterStateHandler(I2C0);
+}
+
+static void setupRequest(I2C_MASTER_REQ_T& req, I2C_XFER_T& xfer, const uint8_t* tx, int txSz)
+{
+    xfer = {};
+    xfer.slaveAddr = 0x40;
+    xfer.txBuff = tx;
+    xfer.txSz = txSz;
+    req = {};
+    req.xfer = &xfer;
+    req.callback = testCallback;
+}
+
+TEST_CASE("I2C queued master transfers","[SBLIB][I2C]")
+{
+    const uint8_t data[2] = {0x12, 0x34};
+    I2C_MASTER_REQ_T req1, req2;
+    I2C_XFER_T xfer1, xfer2;
+    setupRequest(req1, xfer1, data, 2);
+    setupRequest(req2, xfer2, data + 1, 1);
+    callbackCount = 0;
+    callbackReq = nullptr;
+
+    SECTION("Requests are processed in order")
+    {
+        Chip_I2C_MasterSubmit(I2C0, &req1);
+        REQUIRE(LPC_I2C->CONSET == (I2C_CON_I2EN | I2C_CON_STA));
+        Chip_I2C_MasterSubmit(I2C0, &req2);
+        REQUIRE(xfer1.status == I2C_STATUS_BUSY);
+        REQUIRE(xfer2.status == I2C_STATUS_BUSY);
+
+        stateChange(0x08);
+        REQUIRE(LPC_I2C->DAT == 0x80);
+        stateChange(0x18);
+        REQUIRE(LPC_I2C->DAT == 0x12);
+        stateChange(0x28);
+        REQUIRE(LPC_I2C->DAT == 0x34);
+        REQUIRE(callbackCount == 0);
+
+        stateChange(0x28);
+        REQUIRE(xfer1.status == I2C_STATUS_DONE);
+        REQUIRE(callbackCount == 1);
+        REQUIRE(callbackReq == &req1);
+        REQUIRE(LPC_I2C->CONSET == (I2C_CON_I2EN | I2C_CON_STA)); // start of the second request
+
+        stateChange(0x08);
+        stateChange(0x20);
+        REQUIRE(xfer2.status == I2C_STATUS_NAK);
+        REQUIRE(callbackCount == 2);
+        REQUIRE(callbackReq == &req2);
+    }
+
+    SECTION("Lost arbitration is retried")
+    {
+        req1.retries = 1;
+        Chip_I2C_MasterSubmit(I2C0, &req1);
+        stateChange(0x08);
+        stateChange(0x18);
+        stateChange(0x38);
+        REQUIRE(xfer1.status == I2C_STATUS_BUSY);
+        REQUIRE(xfer1.txSz == 2);
+        REQUIRE(xfer1.txBuff == data);
+        REQUIRE(req1.retries == 0);
+        REQUIRE(callbackCount == 0);
+
+        stateChange(0x08);
+        stateChange(0x38);
+        REQUIRE(xfer1.status == I2C_STATUS_ARBLOST);
+        REQUIRE(callbackCount == 1);
+    }
+
+    SECTION("Timeout aborts the transfer")
+    {
+        setMillis(1000);
+        req1.timeoutMs = 10;
+        Chip_I2C_MasterSubmit(I2C0, &req1);
+        Chip_I2C_MasterSubmit(I2C0, &req2);
+        stateChange(0x08);
+
+        setMillis(1009);
+        Chip_I2C_MasterCheckTimeout(I2C0);
+        REQUIRE(xfer1.status == I2C_STATUS_BUSY);
+
+        setMillis(1010);
+        Chip_I2C_MasterCheckTimeout(I2C0);
+        REQUIRE(xfer1.status == I2C_STATUS_TIMEOUT);
+        REQUIRE(callbackCount == 1);
+        REQUIRE(callbackReq == &req1);
+
+        // the second request has no timeout
+        setMillis(5000);
+        Chip_I2C_MasterCheckTimeout(I2C0);
+        REQUIRE(xfer2.status == I2C_STATUS_BUSY);
+        stateChange(0x08);
+        stateChange(0x18);
+        stateChange(0x28);
+        REQUIRE(xfer2.status == I2C_STATUS_DONE);
+        REQUIRE(callbackCount == 2);
+    }
+
+    // a stray interrupt without request is ignored
+    int count = callbackCount;
+    stateChange(0x08);
+    REQUIRE(callbackCount == count);
+}
+
+/** @}*/
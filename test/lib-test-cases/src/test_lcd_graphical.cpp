@@ -0,0 +1,148 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Graphical LCD frame buffer Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the frame buffer of the graphical LCD displays
+ * @details A display class that records the columns that flush() sends is
+ *          used instead of a real display.
+ *
+ * @{
+ *
+ * @file   test_lcd_graphical.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/lcd/font_5x7.h>
+#include <sblib/lcd/graphical.h>
+
+#define TEST_WIDTH 32
+#define TEST_PAGES 4
+
+/**
+ * A display that records what is sent to it.
+ */
+class TestDisplay: public LcdGraphical
+{
+public:
+    TestDisplay() : LcdGraphical(font_5x7, TEST_WIDTH, TEST_PAGES), writes(0), columns(0)
+    {
+        for (int i = 0; i < TEST_WIDTH * TEST_PAGES; ++i)
+            display[i] = 0xff;
+    }
+
+    virtual void pos(int x, int y)
+    {
+        cursorX = x;
+        cursorY = y;
+    }
+
+    virtual int write(byte ch)
+    {
+        return drawChar(ch);
+    }
+
+    virtual void writeColumns(int x, int page, const byte* data, int count)
+    {
+        REQUIRE(x >= 0);
+        REQUIRE(x + count <= TEST_WIDTH);
+        lastX = x;
+        lastPage = page;
+        ++writes;
+        columns += count;
+
+        for (int i = 0; i < count; ++i)
+            display[page * TEST_WIDTH + x + i] = data[i];
+    }
+
+    byte display[TEST_WIDTH * TEST_PAGES];
+    int writes, columns, lastX, lastPage;
+};
+
+TEST_CASE("Graphical LCD frame buffer","[SBLIB][LCD]")
+{
+    static byte frame[TEST_WIDTH * TEST_PAGES];
+    TestDisplay lcd;
+
+    // without a frame buffer flush() does nothing
+    lcd.flush();
+    REQUIRE(lcd.writes == 0);
+
+    lcd.frameBuffer(frame);
+    lcd.flush();
+    REQUIRE(lcd.writes == TEST_PAGES);
+    REQUIRE(lcd.columns == TEST_WIDTH * TEST_PAGES);
+    for (int i = 0; i < TEST_WIDTH * TEST_PAGES; ++i)
+        REQUIRE(lcd.display[i] == 0);
+
+    // nothing changed
+    lcd.writes = lcd.columns = 0;
+    lcd.flush();
+    REQUIRE(lcd.writes == 0);
+
+    SECTION("Text")
+    {
+        lcd.pos(10, 2);
+        REQUIRE(lcd.write('A') == 1);
+        REQUIRE(lcd.write(1) == 0);  // not in the font
+        lcd.flush();
+        REQUIRE(lcd.writes == 1);
+        REQUIRE(lcd.lastPage == 2);
+        REQUIRE(lcd.lastX >= 10);
+        REQUIRE(lcd.columns <= font_5x7.charWidth);
+        for (int i = 0; i < font_5x7.charWidth; ++i)
+            REQUIRE(lcd.display[2 * TEST_WIDTH + 10 + i] == (byte) font_5x7.data[('A' - font_5x7.firstChar) * font_5x7.charWidth + i]);
+
+        // the same text again changes nothing
+        lcd.writes = 0;
+        lcd.pos(10, 2);
+        lcd.write('A');
+        lcd.flush();
+        REQUIRE(lcd.writes == 0);
+
+        // text at the right border is clipped
+        lcd.columns = 0;
+        lcd.pos(TEST_WIDTH - 2, 0);
+        lcd.write('W');
+        lcd.write('W');
+        lcd.flush();
+        REQUIRE(lcd.writes == 1);
+        REQUIRE(lcd.lastX + lcd.columns <= TEST_WIDTH);
+    }
+
+    SECTION("Pixels")
+    {
+        lcd.pixel(3, 9, true);
+        lcd.pixel(20, 15, true);
+        lcd.pixel(TEST_WIDTH, 0, true);      // outside
+        lcd.pixel(0, TEST_PAGES * 8, true);  // outside
+        lcd.flush();
+        REQUIRE(lcd.writes == 1);
+        REQUIRE(lcd.lastPage == 1);
+        REQUIRE(lcd.lastX == 3);
+        REQUIRE(lcd.columns == 18);
+        REQUIRE(lcd.display[TEST_WIDTH + 3] == 0x02);
+        REQUIRE(lcd.display[TEST_WIDTH + 20] == 0x80);
+
+        lcd.writes = lcd.columns = 0;
+        lcd.pixel(3, 9, true);  // already set
+        lcd.flush();
+        REQUIRE(lcd.writes == 0);
+
+        lcd.pixel(3, 9, false);
+        lcd.pixel(5, 0, true);
+        lcd.flush();
+        REQUIRE(lcd.writes == 2);
+        REQUIRE(lcd.columns == 2);
+        REQUIRE(lcd.display[TEST_WIDTH + 3] == 0);
+        REQUIRE(lcd.display[5] == 0x01);
+    }
+}
+
+/** @}*/
@@ -0,0 +1,139 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST OneWire Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the timer driven OneWire operations
+ * @details The interrupt handler is called directly. The emulated GPIO reads
+ *          back what was written last, so a released bus reads high. The
+ *          presence pulse is emulated by pulling the line low before its sample.
+ *
+ * @{
+ *
+ * @file   test_onewire.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/core.h>
+#include <sblib/digital_pin.h>
+#include <sblib/timer.h>
+#include <sblib/onewire.h>
+
+#define OW_TEST_PIN PIO2_2
+
+static int callbackCount;
+static bool callbackSuccess;
+static void* callbackContext;
+
+static void testCallback(void* context, bool bSuccess)
+{
+    callbackCount++;
+    callbackSuccess = bSuccess;
+    callbackContext = context;
+}
+
+/**
+ * Call the interrupt handler until the queue is done.
+ *
+ * @param ow       - the OneWire to run
+ * @param presence - true to answer resets with a presence pulse
+ * @return The sum of all scheduled timer delays in microseconds.
+ */
+static unsigned int runQueue(OneWire& ow, bool presence)
+{
+    unsigned int total = LPC_TMR32B0->MR0;
+    for (int steps = 0; ow.OneWireBusy() && steps < 10000; steps++)
+    {
+        if (presence && LPC_TMR32B0->MR0 == 70)
+        {
+            digitalWrite(OW_TEST_PIN, 0);
+        }
+        LPC_TMR32B0->MR0 = 0;
+        ow.OneWireTimerInterruptHandler();
+        total += LPC_TMR32B0->MR0;
+    }
+    return total;
+}
+
+TEST_CASE("OneWire queued transaction","[SBLIB][ONEWIRE]")
+{
+    OneWire ow;
+    ow.OneWireInit(OW_TEST_PIN);
+    callbackCount = 0;
+
+    SECTION("Not initialized")
+    {
+        REQUIRE_FALSE(ow.OneWireQueueReset());
+        REQUIRE_FALSE(ow.OneWireBusy());
+    }
+
+    ow.OneWireTimerInit(timer32_0);
+    REQUIRE(ow.OneWireQueueSpace() == ONEWIRE_QUEUE_SIZE - 1);
+
+    SECTION("Write and read with presence")
+    {
+        uint8_t data[2] = {0, 0x12};
+        REQUIRE(ow.OneWireQueueReset());
+        REQUIRE(ow.OneWireBusy());
+        REQUIRE(LPC_TMR32B0->MR0 == 2);
+        REQUIRE(ow.OneWireQueueWrite(0xA5));
+        REQUIRE(ow.OneWireQueueReadBytes(data, 2));
+        REQUIRE(ow.OneWireQueueCallback(testCallback, data));
+        REQUIRE(ow.OneWireQueueSpace() == ONEWIRE_QUEUE_SIZE - 5);
+
+        unsigned int usec = runQueue(ow, true);
+
+        REQUIRE(callbackCount == 1);
+        REQUIRE(callbackSuccess);
+        REQUIRE(callbackContext == data);
+        REQUIRE(data[0] == 0xFF);
+        REQUIRE(data[1] == 0xFF);
+        REQUIRE_FALSE(ow.OneWireBusy());
+        REQUIRE(ow.OneWireQueueSpace() == ONEWIRE_QUEUE_SIZE - 1);
+
+        // start, reset, 0xA5 = four 1 bits and four 0 bits, 16 read slots
+        REQUIRE(usec == 2 + (480 + 70 + 410) + 4 * 55 + 4 * (65 + 5) + 16 * 53);
+    }
+
+    SECTION("No presence skips the transaction")
+    {
+        uint8_t data = 0x12;
+        REQUIRE(ow.OneWireQueueReset());
+        REQUIRE(ow.OneWireQueueSkip());
+        REQUIRE(ow.OneWireQueueRead(&data));
+        REQUIRE(ow.OneWireQueueCallback(testCallback, nullptr));
+        REQUIRE(ow.OneWireQueueReset());
+        REQUIRE(ow.OneWireQueueCallback(testCallback, &data));
+
+        runQueue(ow, false);
+
+        REQUIRE(callbackCount == 2);
+        REQUIRE_FALSE(callbackSuccess);
+        REQUIRE(callbackContext == &data);
+        REQUIRE(data == 0x12);
+        REQUIRE_FALSE(ow.OneWireBusy());
+    }
+
+    SECTION("Queue full")
+    {
+        for (int i = 0; i < ONEWIRE_QUEUE_SIZE - 1; i++)
+        {
+            REQUIRE(ow.OneWireQueueWrite(i));
+        }
+        REQUIRE(ow.OneWireQueueSpace() == 0);
+        REQUIRE_FALSE(ow.OneWireQueueWrite(0));
+        REQUIRE_FALSE(ow.OneWireQueueCallback(testCallback, nullptr));
+
+        runQueue(ow, false);
+        REQUIRE(callbackCount == 0);
+        REQUIRE(ow.OneWireQueueSpace() == ONEWIRE_QUEUE_SIZE - 1);
+    }
+}
+
+/** @}*/
@@ -0,0 +1,106 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Pin Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the compile-time port pin descriptors
+ * @details Pin<> must configure the same registers as pinMode() does.
+ *
+ * @{
+ *
+ * @file   test_pin.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/pin.h>
+
+static_assert(Pin<PIO1_9>::port == 1, "port");
+static_assert(Pin<PIO1_9>::pinNum == 9, "pin number");
+static_assert(Pin<PIO1_9>::mask == 0x200, "mask");
+static_assert(pinModeIocon(PIO0_3, SERIAL_RXD) < 0, "PIO0_3 has no RXD function");
+static_assert(pinModeIocon(PIO1_6, SERIAL_RXD) == 1, "PIO1_6 has RXD as function 1");
+static_assert(pinModeIocon(PIO0_11, INPUT_ANALOG) == 2, "analog mode without digital mode bit");
+static_assert(pinModeIocon(PIO0_11, OUTPUT | PULL_UP) == (0x80 | 0x10 | 1), "digital mode bit");
+
+/**
+ * Configure a pin with Pin<> and with pinMode() and compare the registers.
+ */
+template <int pin, int mode>
+static void requireSameAsPinMode()
+{
+    *ioconPointer(pin) = 0xffff;
+    Pin<pin>::template mode<mode>();
+    unsigned int iocon = *ioconPointer(pin);
+    unsigned int dir = gpioPorts[digitalPinToPort(pin)]->DIR;
+    LPC_IOCON_TypeDef locations = *LPC_IOCON;
+
+    *ioconPointer(pin) = 0xffff;
+    pinMode(pin, mode);
+    REQUIRE(*ioconPointer(pin) == iocon);
+    REQUIRE(gpioPorts[digitalPinToPort(pin)]->DIR == dir);
+    REQUIRE(LPC_IOCON->RXD_LOC == locations.RXD_LOC);
+    REQUIRE(LPC_IOCON->SCK_LOC == locations.SCK_LOC);
+    REQUIRE(LPC_IOCON->SCK1_LOC == locations.SCK1_LOC);
+    REQUIRE(LPC_IOCON->MISO1_LOC == locations.MISO1_LOC);
+    REQUIRE(LPC_IOCON->MOSI1_LOC == locations.MOSI1_LOC);
+    REQUIRE(LPC_IOCON->CT16B0_CAP0_LOC == locations.CT16B0_CAP0_LOC);
+    REQUIRE(LPC_IOCON->CT32B0_CAP0_LOC == locations.CT32B0_CAP0_LOC);
+}
+
+TEST_CASE("Pin mode","[SBLIB][PIN]")
+{
+    REQUIRE(Pin<PIO2_11>::iocon() == ioconPointer(PIO2_11));
+    REQUIRE(Pin<PIO3_5>::iocon() == ioconPointer(PIO3_5));
+    REQUIRE(Pin<PIO0_4>::gpio() == gpioPorts[0]);
+    REQUIRE(Pin<PIO3_0>::gpio() == gpioPorts[3]);
+
+    requireSameAsPinMode<PIO1_8, OUTPUT>();
+    requireSameAsPinMode<PIO1_8, INPUT_CAPTURE | HYSTERESIS>();
+    requireSameAsPinMode<PIO1_9, OUTPUT_MATCH>();
+    requireSameAsPinMode<PIO0_11, INPUT_ANALOG>();
+    requireSameAsPinMode<PIO1_1, INPUT | PULL_UP>();
+    requireSameAsPinMode<PIO0_4, PINMODE_FUNC(PF_SCL)>();
+
+    LPC_IOCON->RXD_LOC = 0;
+    requireSameAsPinMode<PIO3_4, SERIAL_RXD>();
+    REQUIRE(LPC_IOCON->RXD_LOC == 3);
+    requireSameAsPinMode<PIO3_0, SERIAL_TXD>();
+
+    requireSameAsPinMode<PIO2_9, INPUT_CAPTURE>();
+    REQUIRE(LPC_IOCON->CT32B0_CAP0_LOC == 1);
+    requireSameAsPinMode<PIO3_2, OUTPUT | SPI_CLOCK>();
+    REQUIRE(LPC_IOCON->SCK1_LOC == 1);
+    requireSameAsPinMode<PIO1_10, INPUT | SPI_MISO>();
+    REQUIRE(LPC_IOCON->MISO1_LOC == 1);
+}
+
+TEST_CASE("Pin write and read","[SBLIB][PIN]")
+{
+    typedef Pin<PIO2_6> TestPin;
+
+    TestPin::set();
+    REQUIRE(digitalRead(PIO2_6));
+    REQUIRE(TestPin::read());
+
+    TestPin::clear();
+    REQUIRE_FALSE(digitalRead(PIO2_6));
+    REQUIRE_FALSE(TestPin::read());
+
+    digitalWrite(PIO2_6, true);
+    REQUIRE(TestPin::read());
+    TestPin::write(false);
+    REQUIRE_FALSE(TestPin::read());
+
+    TestPin::direction(OUTPUT);
+    REQUIRE((gpioPorts[2]->DIR & 0x40) == 0x40);
+    TestPin::direction(INPUT);
+    REQUIRE((gpioPorts[2]->DIR & 0x40) == 0);
+}
+
+/** @}*/
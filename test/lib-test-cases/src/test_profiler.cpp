@@ -0,0 +1,93 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Profiler Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the SysTick based run-time profiler
+ *
+ * @{
+ *
+ * @file   test_profiler.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/profiler.h>
+#include <sblib/platform.h>
+#include <sblib/timer.h>
+
+TEST_CASE("Profiler time stamps","[SBLIB][PROFILER]")
+{
+    const unsigned int load = SysTick->LOAD;
+    const unsigned int oldMillis = millis();
+    SysTick->LOAD = 47999;
+    SCB->ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+
+    setMillis(10);
+    SysTick->VAL = 47999;
+    uint32_t start = profilerCycles();
+    REQUIRE(start == 10 * 48000);
+
+    SysTick->VAL = 47999 - 1000;
+    REQUIRE(profilerCycles() - start == 1000);
+
+    // SysTick reloaded, but the SysTick_Handler did not increment the system time yet
+    SysTick->VAL = 47900;
+    SCB->ICSR |= SCB_ICSR_PENDSTSET_Msk;
+    REQUIRE(profilerCycles() - start == 48000 + 99);
+
+    // pending flag alone with a low counter value means the reload did not happen yet
+    SysTick->VAL = 100;
+    REQUIRE(profilerCycles() - start == 47899);
+
+    SCB->ICSR &= ~SCB_ICSR_PENDSTSET_Msk;
+    SysTick->LOAD = load;
+    setMillis(oldMillis);
+}
+
+TEST_CASE("Profiler statistics","[SBLIB][PROFILER]")
+{
+    profilerReset();
+    REQUIRE(profilerStats(PROFILE_USER_0).count == 0);
+
+    profilerRecord(PROFILE_USER_0, 10);
+    profilerRecord(PROFILE_USER_0, 100);
+    profilerRecord(PROFILE_USER_0, 1000);
+    profilerRecord(PROFILE_USER_0, 0xffffffff);
+
+    const ProfileStats& stats = profilerStats(PROFILE_USER_0);
+    REQUIRE(stats.count == 4);
+    REQUIRE(stats.minCycles == 10);
+    REQUIRE(stats.maxCycles == 0xffffffff);
+    REQUIRE(stats.sumCycles == 1110ULL + 0xffffffffULL);
+    REQUIRE(stats.histogram[0] == 1); // 10 is below 2^6
+    REQUIRE(stats.histogram[1] == 1); // 100 is within 2^6..2^7-1
+    REQUIRE(stats.histogram[4] == 1); // 1000 is within 2^9..2^10-1
+    REQUIRE(stats.histogram[PROFILE_HISTOGRAM_BUCKETS - 1] == 1);
+    REQUIRE(profilerStats(PROFILE_USER_1).count == 0);
+
+    byte buffer[PROFILE_SERIALIZED_SIZE];
+    REQUIRE(profilerRead(PROFILE_USER_0, buffer, sizeof(buffer) - 1) == 0);
+    REQUIRE(profilerRead(PROFILE_USER_0, buffer, sizeof(buffer)) == PROFILE_SERIALIZED_SIZE);
+    REQUIRE(buffer[3] == 4);     // count
+    REQUIRE(buffer[7] == 10);    // min
+    REQUIRE(buffer[8] == 0xff);  // max
+    REQUIRE(buffer[16] == 0);    // histogram[0]
+    REQUIRE(buffer[17] == 1);
+
+    {
+        ProfileScope scope(PROFILE_USER_1);
+    }
+    REQUIRE(profilerStats(PROFILE_USER_1).count == 1);
+
+    profilerReset();
+    REQUIRE(profilerStats(PROFILE_USER_0).count == 0);
+    REQUIRE(profilerStats(PROFILE_USER_0).histogram[0] == 0);
+}
+
+/** @}*/
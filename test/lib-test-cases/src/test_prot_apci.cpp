@@ -179,7 +179,23 @@ static Telegram apciPropertyDescriptionReadTelegrams[] =
     {TEL_TX, 15, 0, 0, NULL, {0xB0, 0xA0, 0x00, 0xA0, 0x01, 0x68, 0x47, 0xD9, 0x03, 0x0D, 0x00, 0x15, 0x00, 0x01, 0x50}},
     // 9. T_ACK for APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU
     {TEL_RX,  7, 0, 0, NULL, {0xB0, 0xA0, 0x01, 0xA0, 0x00, 0x60, 0xC6}},
-    // 10.
+    // 10. APCI_PROPERTY_DESCRIPTION_READ_PDU, objIdx = 0x00 (deviceObjectProps) , propId = 0x00, index = 0x01 (PID_DEVICE_CONTROL)
+    {TEL_RX, 11, 0, 0, NULL, {0xB0, 0xA0, 0x01, 0xA0, 0x00, 0x61, 0x4B, 0xD8, 0x00, 0x00, 0x01}},
+    // 11. Check T_ACK, loop() once so APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU will be send
+    {TEL_TX,  7, 1, 0, NULL, {0xB0, 0xA0, 0x00, 0xA0, 0x01, 0x60, 0xCA}},
+    // 12. APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU
+    {TEL_TX, 15, 0, 0, NULL, {0xB0, 0xA0, 0x00, 0xA0, 0x01, 0x68, 0x4B, 0xD9, 0x00, 0x0E, 0x01, 0x91, 0x00, 0x01, 0xF1}},
+    // 13. T_ACK for APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU
+    {TEL_RX,  7, 0, 0, NULL, {0xB0, 0xA0, 0x01, 0xA0, 0x00, 0x60, 0xCA}},
+    // 14. APCI_PROPERTY_DESCRIPTION_READ_PDU, objIdx = 0x00 (deviceObjectProps) , propId = 0x00, index = 0x40 (behind the last property)
+    {TEL_RX, 11, 0, 0, NULL, {0xB0, 0xA0, 0x01, 0xA0, 0x00, 0x61, 0x4F, 0xD8, 0x00, 0x00, 0x40}},
+    // 15. Check T_ACK, loop() once so APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU will be send
+    {TEL_TX,  7, 1, 0, NULL, {0xB0, 0xA0, 0x00, 0xA0, 0x01, 0x60, 0xCE}},
+    // 16. APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU, the property does not exist
+    {TEL_TX, 15, 0, 0, NULL, {0xB0, 0xA0, 0x00, 0xA0, 0x01, 0x68, 0x4F, 0xD9, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00}},
+    // 17. T_ACK for APCI_PROPERTY_DESCRIPTION_RESPONSE_PDU
+    {TEL_RX,  7, 0, 0, NULL, {0xB0, 0xA0, 0x01, 0xA0, 0x00, 0x60, 0xCE}},
+    // 18.
     {END}
 };
 
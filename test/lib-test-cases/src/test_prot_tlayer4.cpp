@@ -48,7 +48,7 @@ static void tc_setup_1001(Telegram* tel, uint16_t telCount)
 static void tc_setup_OpenWait(Telegram* tel, uint16_t telCount)
 {
     tc_setup(tel, telCount);
-    bcuUnderTest->connectedTime = millis(); // "start connection timeout timer"
+    bcuUnderTest->connectionTimer.start(TL4_CONNECTION_TIMEOUT_MS); // "start connection timeout timer"
     bcuUnderTest->state = TLayer4::OPEN_WAIT;
     bcuUnderTest->seqNoRcv = 0;
     bcuUnderTest->seqNoSend = 0;
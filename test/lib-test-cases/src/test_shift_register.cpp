@@ -0,0 +1,97 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Shift register chain Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the shift register chain on a SPI port
+ * @details The emulated SSP port cannot run a block transfer, so the tests check
+ *          the image and the SPI frames that update() would send.
+ *
+ * @{
+ *
+ * @file   test_shift_register.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/shift_register.h>
+
+/**
+ * A shift register chain with access to the SPI frames.
+ */
+class TestChain: public ShiftRegisterChain
+{
+public:
+    TestChain(int length) : ShiftRegisterChain(SPI_PORT_0, PIO0_9, PIO2_11, PIO0_2, length) {}
+
+    using ShiftRegisterChain::frames;
+    using ShiftRegisterChain::prepareFrames;
+};
+
+TEST_CASE("Shift register chain image","[SBLIB][SHIFT_REGISTER]")
+{
+    TestChain chain(4);
+    REQUIRE(chain.changed());  // the outputs are unknown until begin()
+    REQUIRE(chain.getRegister(0) == 0);
+
+    chain.set(0, true);
+    chain.set(9, true);
+    chain.set(31, true);
+    REQUIRE(chain.get(0));
+    REQUIRE(chain.get(9));
+    REQUIRE_FALSE(chain.get(10));
+    REQUIRE(chain.getRegister(1) == 0x02);
+    REQUIRE(chain.getRegister(3) == 0x80);
+
+    chain.set(31, false);
+    REQUIRE(chain.getRegister(3) == 0);
+    chain.setRegister(2, 0xa5);
+    REQUIRE(chain.get(16));
+    REQUIRE_FALSE(chain.get(17));
+    REQUIRE(chain.changed());
+}
+
+TEST_CASE("Shift register chain frames","[SBLIB][SHIFT_REGISTER]")
+{
+    SECTION("Even length uses 16 bit frames")
+    {
+        TestChain chain(4);
+        chain.setRegister(0, 0x01);
+        chain.setRegister(1, 0x02);
+        chain.setRegister(2, 0x03);
+        chain.setRegister(3, 0x04);
+
+        // the last register is sent first, in the upper byte of the first frame
+        REQUIRE(chain.prepareFrames() == 2);
+        REQUIRE(chain.frames[0] == 0x0403);
+        REQUIRE(chain.frames[1] == 0x0201);
+    }
+
+    SECTION("Odd length uses 8 bit frames")
+    {
+        TestChain chain(3);
+        chain.setRegister(0, 0x11);
+        chain.setRegister(1, 0x22);
+        chain.setRegister(2, 0x33);
+
+        REQUIRE(chain.prepareFrames() == 3);
+        REQUIRE(chain.frames[0] == 0x33);
+        REQUIRE(chain.frames[1] == 0x22);
+        REQUIRE(chain.frames[2] == 0x11);
+    }
+
+    SECTION("Maximum length")
+    {
+        TestChain chain(SHIFT_REGISTER_MAX_LENGTH + 2);
+        chain.set(8 * SHIFT_REGISTER_MAX_LENGTH - 1, true);
+        REQUIRE(chain.prepareFrames() == SHIFT_REGISTER_MAX_LENGTH / 2);
+        REQUIRE(chain.frames[0] == 0x8000);
+    }
+}
+
+/** @}*/
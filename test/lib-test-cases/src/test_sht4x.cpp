@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST SHT4x Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the non-blocking SHT4x measurement
+ * @details The I2C state handler is called directly after setting the status
+ *          and data register like the hardware would.
+ *
+ * @{
+ *
+ * @file   test_sht4x.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/core.h>
+#include <sblib/i2c.h>
+#include <sblib/i2c/SHT4x.h>
+
+static void stateChange(uint32_t stat, uint32_t data = 0)
+{
+    LPC_I2C->DAT = data;
+    *((volatile uint32_t *) &LPC_I2C->STAT) = stat;
+    Chip_I2C_MasterStateHandler(I2C0);
+}
+
+static void sendCommand(uint8_t command)
+{
+    stateChange(0x08);
+    REQUIRE(LPC_I2C->DAT == (0x44 << 1));
+    stateChange(0x18);
+    REQUIRE(LPC_I2C->DAT == command);
+    stateChange(0x28);
+}
+
+TEST_CASE("SHT4x non-blocking measurement","[SBLIB][I2C][SHT4x]")
+{
+    SHT4xClass sht;
+    setMillis(1000);
+
+    REQUIRE(sht.startMeasurement());
+    REQUIRE_FALSE(sht.startMeasurement());
+    REQUIRE_FALSE(sht.poll());
+    sendCommand(0xFD);
+    REQUIRE_FALSE(sht.poll());
+
+    setMillis(1009);
+    REQUIRE_FALSE(sht.poll());
+    setMillis(1010);
+    REQUIRE_FALSE(sht.poll());
+
+    SECTION("Valid result")
+    {
+        // 0x6666 = 25 degree celsius, 0x8000 = 56.5 %RH
+        const uint8_t answer[6] = {0x66, 0x66, 0x93, 0x80, 0x00, 0xA2};
+        stateChange(0x08);
+        REQUIRE(LPC_I2C->DAT == ((0x44 << 1) | 1));
+        stateChange(0x40);
+        for (int i = 0; i < 5; i++)
+        {
+            stateChange(0x50, answer[i]);
+        }
+        REQUIRE_FALSE(sht.poll());
+        stateChange(0x58, answer[5]);
+
+        REQUIRE(sht.poll());
+        REQUIRE(sht.result());
+        REQUIRE(sht.getTemperature() == Approx(25.0f).margin(0.01f));
+        REQUIRE(sht.getHumidity() == Approx(56.5f).margin(0.01f));
+        REQUIRE_FALSE(sht.poll());
+    }
+
+    SECTION("Retry while the conversion is running")
+    {
+        stateChange(0x08);
+        stateChange(0x48);
+        REQUIRE_FALSE(sht.poll());
+
+        setMillis(1300);
+        REQUIRE_FALSE(sht.poll());
+        stateChange(0x08);
+        stateChange(0x48);
+        REQUIRE(sht.poll());
+        REQUIRE_FALSE(sht.result());
+        REQUIRE_FALSE(sht.poll());
+    }
+}
+
+/** @}*/
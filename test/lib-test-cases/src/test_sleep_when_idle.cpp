@@ -0,0 +1,149 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Sleep when idle Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for sleeping between the events of the main loop
+ * @details The SysTick registers are plain memory in the emulation, the counter
+ *          does not run while sleeping. So a sleep always lasts until the
+ *          reprogrammed SysTick expires.
+ *
+ * @{
+ *
+ * @file   test_sleep_when_idle.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <protocol.h>
+#include <sblib/timer.h>
+#include <sblib/timer_wheel.h>
+
+extern unsigned int wfiSystemTimeInc;
+
+TEST_CASE("Sleep until interrupt","[SBLIB][SLEEP]")
+{
+    const unsigned int load = SysTick->LOAD;
+    SysTick->LOAD = 47999;
+    SysTick->VAL = 47999;
+    SCB->ICSR = 0;
+    wfiSystemTimeInc = 0;
+    setMillis(1000);
+
+    SECTION("Sleep until the deadline")
+    {
+        sleepUntilInterrupt(10);
+        REQUIRE(millis() == 1010);
+        REQUIRE(SysTick->LOAD == 47999);
+
+        // in the middle of a millisecond
+        SysTick->VAL = 24000;
+        sleepUntilInterrupt(5);
+        REQUIRE(millis() == 1015);
+        REQUIRE(SysTick->LOAD == 47999);
+    }
+
+    SECTION("Short sleeps are not reprogrammed")
+    {
+        sleepUntilInterrupt(0);
+        sleepUntilInterrupt(1);
+        REQUIRE(millis() == 1000);
+        REQUIRE(SysTick->VAL == 47999);
+    }
+
+    SECTION("Sleep is limited by the SysTick counter")
+    {
+        sleepUntilInterrupt(100000);
+        REQUIRE(millis() == 1000 + (SysTick_LOAD_RELOAD_Msk + 1) / 48000);
+        REQUIRE(SysTick->LOAD == 47999);
+    }
+
+    SECTION("Pending tick is counted first")
+    {
+        SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+        sleepUntilInterrupt(10);
+        REQUIRE(millis() == 1000);
+        REQUIRE(SysTick->VAL == 47999);
+    }
+
+    SysTick->LOAD = load;
+    SysTick->VAL = 0;
+    SCB->ICSR = 0;
+    setMillis(0);
+}
+
+TEST_CASE("BCU idle time","[SBLIB][SLEEP]")
+{
+    IAP_Init_Flash(0xFF);
+    BCU2* bcu = new BCU2();
+    bcu->begin(0x4, 0x2060, 0x1);
+    setMillis(1000);
+    timerWheel.dispatch();
+    bcu->userEeprom->modified(false);
+    bcu->progButtonTime = millis();
+
+    REQUIRE(bcu->idleTime() == BCU_PROG_BUTTON_POLL_TIME);
+
+    SECTION("Next programming button sample")
+    {
+        setMillis(1000 + BCU_PROG_BUTTON_POLL_TIME - 1);
+        REQUIRE(bcu->idleTime() == 1);
+        setMillis(1000 + BCU_PROG_BUTTON_POLL_TIME);
+        REQUIRE(bcu->idleTime() == 0);
+    }
+
+    SECTION("No programming button")
+    {
+        int progPin = bcu->progPin;
+        bcu->progPin = 0;
+        REQUIRE(bcu->idleTime() == TIMER_WHEEL_IDLE_FOREVER);
+        bcu->progPin = progPin;
+    }
+
+    SECTION("Next timer")
+    {
+        SoftTimer timer;
+        timer.start(3);
+        REQUIRE(bcu->idleTime() == 3);
+        timer.stop();
+    }
+
+    SECTION("Received telegram")
+    {
+        bcu->bus->telegramLen = 8;
+        REQUIRE(bcu->idleTime() == 0);
+        bcu->bus->telegramLen = 0;
+    }
+
+    SECTION("Modified user EEPROM")
+    {
+        int progPin = bcu->progPin;
+        bcu->progPin = 0;
+        bcu->userEeprom->modified(true);
+        REQUIRE(bcu->idleTime() == USER_EEPROM_WRITE_DELAY);
+        setMillis(1000 + USER_EEPROM_WRITE_DELAY - 1);
+        REQUIRE(bcu->idleTime() == 1);
+        setMillis(1000 + USER_EEPROM_WRITE_DELAY);
+        REQUIRE(bcu->idleTime() == 0);
+        bcu->userEeprom->modified(false);
+        bcu->progPin = progPin;
+    }
+
+    SECTION("Modified user EEPROM during a direct connection")
+    {
+        bcu->userEeprom->modified(true);
+        bcu->state = TLayer4::OPEN_IDLE;
+        REQUIRE(bcu->idleTime() == 0);
+        bcu->state = TLayer4::CLOSED;
+        bcu->userEeprom->modified(false);
+    }
+
+    setMillis(0);
+}
+
+/** @}*/
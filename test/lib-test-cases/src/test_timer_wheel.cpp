@@ -0,0 +1,187 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST Timer wheel Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the software timers of the timer wheel
+ * @details The system time is set with setMillis() and the timers are processed
+ *          by calling TimerWheel::dispatch() like the main loop does.
+ *
+ * @{
+ *
+ * @file   test_timer_wheel.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <sblib/timer.h>
+#include <sblib/timer_wheel.h>
+
+/**
+ * Records the system time of the timer callbacks.
+ */
+class TestCallback: public TimerCallback
+{
+public:
+    TestCallback() : calls(0), time(0), timer(0) {}
+
+    virtual void timerExpired(SoftTimer* t)
+    {
+        ++calls;
+        time = millis();
+        timer = t;
+    }
+
+    int calls;
+    unsigned int time;
+    SoftTimer* timer;
+};
+
+/**
+ * Advance the system time millisecond by millisecond until the callback
+ * was called, and call the timer wheel like the main loop does.
+ *
+ * @return The system time of the callback.
+ */
+static unsigned int runUntilCalled(TestCallback& cb, unsigned int maxTime)
+{
+    int calls = cb.calls;
+    for (unsigned int t = millis(); cb.calls == calls && t <= maxTime; ++t)
+    {
+        setMillis(t);
+        timerWheel.dispatch();
+    }
+    return cb.time;
+}
+
+TEST_CASE("Timer wheel","[SBLIB][TIMER_WHEEL]")
+{
+    setMillis(1000);
+    timerWheel.dispatch();
+    unsigned int running = timerWheel.running();
+
+    TestCallback cb;
+
+    SECTION("Callbacks at the exact time")
+    {
+        static const unsigned int timeouts[] = { 1, 15, 16, 17, 255, 256, 300, 4095, 4096, 6000, 70000 };
+        for (unsigned int timeout : timeouts)
+        {
+            SoftTimer timer(&cb);
+            unsigned int start = millis();
+            timer.start(timeout);
+            REQUIRE(timer.started());
+            REQUIRE(timerWheel.running() == running + 1);
+            REQUIRE(runUntilCalled(cb, start + timeout + 10) == start + timeout);
+            REQUIRE(cb.timer == &timer);
+            REQUIRE(timer.stopped());
+            REQUIRE(timerWheel.running() == running);
+        }
+    }
+
+    SECTION("Late dispatch")
+    {
+        SoftTimer timer1(&cb), timer2(&cb);
+        timer1.start(20);
+        timer2.start(5000);
+
+        setMillis(1019);
+        timerWheel.dispatch();
+        REQUIRE(cb.calls == 0);
+
+        // the main loop was blocked for a long time
+        setMillis(10000);
+        timerWheel.dispatch();
+        REQUIRE(cb.calls == 2);
+        REQUIRE(timer1.stopped());
+        REQUIRE(timer2.stopped());
+    }
+
+    SECTION("Timeouts beyond the wheel range")
+    {
+        SoftTimer timer(&cb);
+        timer.start(3600000);
+        setMillis(1000 + 3599990);
+        timerWheel.dispatch();
+        REQUIRE(cb.calls == 0);
+        REQUIRE(runUntilCalled(cb, 1000 + 3600010) == 1000 + 3600000);
+    }
+
+    SECTION("Stop and restart")
+    {
+        SoftTimer timer1(&cb), timer2(&cb), timer3(&cb);
+        timer1.start(100);
+        timer2.start(100);
+        timer3.start(100);
+        timer2.stop();
+        REQUIRE(timer2.stopped());
+        REQUIRE(timerWheel.running() == running + 2);
+
+        setMillis(1050);
+        timerWheel.dispatch();
+        timer3.start(100);  // expires at 1150 now
+        timer1.start(0);    // same as stop()
+        REQUIRE(timer1.stopped());
+
+        REQUIRE(runUntilCalled(cb, 1200) == 1150);
+        REQUIRE(cb.calls == 1);
+        REQUIRE(cb.timer == &timer3);
+    }
+
+    SECTION("Polling without callback")
+    {
+        SoftTimer timer;
+        timer.start(10);
+        setMillis(1009);
+        timerWheel.dispatch();
+        REQUIRE_FALSE(timer.expired());
+
+        setMillis(1010);
+        timerWheel.dispatch();
+        REQUIRE(timer.started());
+        REQUIRE(timer.expired());
+        REQUIRE_FALSE(timer.expired());
+        REQUIRE(timer.stopped());
+    }
+
+    SECTION("Idle time")
+    {
+        SoftTimer timer(&cb);
+        timer.start(40);
+        unsigned int idle = timerWheel.idleTime();
+        REQUIRE(idle > 0);
+        REQUIRE(idle <= 40);
+
+        // the idle time is a lower bound, sleeping for it never misses the timer
+        while (cb.calls == 0)
+        {
+            idle = timerWheel.idleTime();
+            REQUIRE(millis() + idle <= 1040);
+            setMillis(millis() + (idle ? idle : 1));
+            timerWheel.dispatch();
+        }
+        REQUIRE(cb.time == 1040);
+    }
+
+    SECTION("Destroyed timers are removed")
+    {
+        {
+            SoftTimer timer(&cb);
+            timer.start(10);
+            REQUIRE(timerWheel.running() == running + 1);
+        }
+        REQUIRE(timerWheel.running() == running);
+        setMillis(1020);
+        timerWheel.dispatch();
+        REQUIRE(cb.calls == 0);
+    }
+
+    REQUIRE(timerWheel.running() == running);
+}
+
+/** @}*/
@@ -0,0 +1,215 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TEST TP transceiver Unit Test
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Tests for the bus on a TP transceiver chip with a UART interface
+ * @details The transceiver is emulated by the serial port of the TpUart, which
+ *          passes the bytes to the TpUart like the receive interrupt does. The
+ *          timeouts are processed by calling the bus' loop() like the BCU does.
+ *
+ * @{
+ *
+ * @file   test_tp_uart.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include <catch.hpp>
+#include <protocol.h>
+#include <sblib/eib/bus_const.h>
+#include <sblib/eib/tp_uart.h>
+#include "../tpuart/tpuart_emulator.h"
+
+/**
+ * Records the notifications that sending a telegram has ended.
+ */
+class SentRecorder: public BusSendCallback
+{
+public:
+    virtual void telegramSent(byte* telegram, bool successful) override
+    {
+        results.push_back(successful);
+    }
+
+    std::vector<bool> results;
+};
+
+TEST_CASE("TP transceiver","[SBLIB][TPUART]")
+{
+    setMillis(1000);
+    IAP_Init_Flash(0xFF);
+    TpUartEmulator chip;
+    TpUart transceiver(chip);
+    BCU2* bcu = new BCU2();
+    bcu->bus->setTransceiver(&transceiver);
+    bcu->begin(0x4, 0x2060, 0x1);
+    bcu->setOwnAddress(0x1140);
+    Bus* bus = bcu->bus;
+    SentRecorder recorder;
+    bus->setSendCallback(&recorder);
+    REQUIRE(chip.resets == 1);
+
+    // T_Connect from 1.1.5 to our own address
+    const Bytes connect = { 0xb0, 0x11, 0x05, 0x11, 0x40, 0x60, 0x80 };
+    const Bytes groupWrite = { 0xbc, 0x00, 0x00, 0x09, 0x01, 0xe1, 0x00, 0x81 };
+    byte sendBuffer[MAX_TELEGRAM_SIZE];
+    memcpy(sendBuffer, groupWrite.data(), groupWrite.size());
+
+    SECTION("Receive a telegram for us")
+    {
+        bus->loop();
+        Bytes frame = TpUartEmulator::withChecksum(connect);
+        chip.indicate(Bytes(frame.begin(), frame.begin() + 6));
+        REQUIRE(chip.acks == Bytes({ TP_UART_ACK_INFO | TP_UART_ACK_ADDRESSED }));
+        REQUIRE_FALSE(bus->telegramReceived());
+
+        chip.indicate(Bytes(frame.begin() + 6, frame.end()));
+        bus->loop();
+        REQUIRE(bus->telegramReceived());
+        REQUIRE(bus->telegramLen == (int) frame.size());
+        REQUIRE(memcmp(bus->telegram, frame.data(), frame.size()) == 0);
+
+        // the repetition is acknowledged, but not handed over again
+        bus->discardReceivedTelegram();
+        Bytes repeated = connect;
+        repeated[0] &= ~SB_TEL_REPEAT_FLAG;
+        chip.receive(repeated);
+        bus->loop();
+        REQUIRE(chip.acks.size() == 2);
+        REQUIRE_FALSE(bus->telegramReceived());
+    }
+
+    SECTION("Telegrams that are not acknowledged")
+    {
+        bus->loop();
+        Bytes other = connect;
+        other[4] = 0x41;
+        chip.receive(other);
+        bus->loop();
+        REQUIRE_FALSE(bus->telegramReceived());
+        REQUIRE(chip.acks.empty());
+    }
+
+    SECTION("Receive buffer is busy")
+    {
+        bus->loop();
+        chip.receive(connect);
+        REQUIRE(bus->telegramReceived());
+
+        // a new telegram is answered with busy
+        Bytes disconnect = connect;
+        disconnect[6] = 0x81;
+        chip.receive(disconnect);
+        REQUIRE(bus->rx_error & RX_BUFFER_BUSY);
+
+        // the repetition of the received telegram is acknowledged
+        Bytes repeated = connect;
+        repeated[0] &= ~SB_TEL_REPEAT_FLAG;
+        chip.receive(repeated);
+
+        REQUIRE(chip.acks == Bytes({ TP_UART_ACK_INFO | TP_UART_ACK_ADDRESSED,
+                                     TP_UART_ACK_INFO | TP_UART_ACK_ADDRESSED | TP_UART_ACK_BUSY,
+                                     TP_UART_ACK_INFO | TP_UART_ACK_ADDRESSED }));
+        REQUIRE(bus->telegramLen == (int) connect.size() + 1);
+        bus->discardReceivedTelegram();
+    }
+
+    SECTION("Invalid frames")
+    {
+        bus->loop();
+        Bytes badChecksum = TpUartEmulator::withChecksum(connect);
+        badChecksum.back() ^= 1;
+        chip.indicate(badChecksum);
+        bus->loop();
+        REQUIRE_FALSE(bus->telegramReceived());
+        REQUIRE(bus->rx_error & RX_CHECKSUM_ERROR);
+
+        // an incomplete frame is discarded after a timeout
+        Bytes frame = TpUartEmulator::withChecksum(connect);
+        chip.indicate(Bytes(frame.begin(), frame.begin() + 4));
+        bus->loop();
+        setMillis(millis() + TP_UART_RX_TIMEOUT + 1);
+        bus->loop();
+        chip.indicate(frame);
+        bus->loop();
+        REQUIRE(bus->telegramReceived());
+        bus->discardReceivedTelegram();
+
+        // also when loop() did not run in the gap
+        chip.indicate(Bytes(frame.begin(), frame.begin() + 4));
+        setMillis(millis() + TP_UART_RX_TIMEOUT + 1);
+        chip.indicate(frame);
+        bus->loop();
+        REQUIRE(bus->telegramReceived());
+        REQUIRE(bus->telegramLen == (int) frame.size());
+    }
+
+    SECTION("Send a telegram")
+    {
+        bus->loop();
+        bus->sendTelegram(sendBuffer, groupWrite.size());
+        REQUIRE(chip.sent.size() == 1);
+        Bytes expected = groupWrite;
+        expected[1] = 0x11; // the source is our own address
+        expected[2] = 0x40;
+        REQUIRE(chip.sent[0] == TpUartEmulator::withChecksum(expected));
+        REQUIRE(chip.protocolErrors == 0);
+        REQUIRE(bus->sendingFrame());
+
+        // the sent frame comes back from the transceiver before the confirmation
+        chip.confirm(true);
+        REQUIRE_FALSE(bus->sendingFrame());
+        REQUIRE_FALSE(bus->telegramReceived());
+        REQUIRE(recorder.results == std::vector<bool>({ true }));
+
+        bus->sendTelegram(sendBuffer, groupWrite.size());
+        chip.confirm(false);
+        bus->loop();
+        REQUIRE(recorder.results == std::vector<bool>({ true, false }));
+    }
+
+    SECTION("Sending waits for the end of the reset")
+    {
+        chip.resetIndication = false;
+        transceiver.begin(bus);
+        bus->sendTelegram(sendBuffer, groupWrite.size());
+        bus->loop();
+        REQUIRE(chip.sent.empty());
+        chip.indicate({ TP_UART_RESET_IND });
+        REQUIRE(chip.sent.size() == 1);
+        chip.confirm(true);
+        bus->loop();
+        REQUIRE(recorder.results == std::vector<bool>({ true }));
+    }
+
+    SECTION("Telegram without confirmation")
+    {
+        bus->loop();
+        bus->sendTelegram(sendBuffer, groupWrite.size());
+        setMillis(millis() + TP_UART_CON_TIMEOUT + 1);
+        bus->loop();
+        REQUIRE_FALSE(bus->sendingFrame());
+        REQUIRE(recorder.results == std::vector<bool>({ false }));
+
+        // a late confirmation is ignored
+        chip.confirm(true);
+        REQUIRE(recorder.results == std::vector<bool>({ false }));
+
+        // an unexpected reset of the transceiver loses the telegram
+        bus->sendTelegram(sendBuffer, groupWrite.size());
+        chip.indicate({ TP_UART_RESET_IND });
+        bus->loop();
+        REQUIRE(recorder.results == std::vector<bool>({ false, false }));
+    }
+
+    bus->setSendCallback(nullptr);
+    bus->setTransceiver(nullptr);
+    setMillis(0);
+}
+
+/** @}*/
@@ -0,0 +1,108 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TPUART TP transceiver emulator
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Host side emulation of a TP transceiver chip with a UART interface
+ *
+ * @{
+ *
+ * @file   tpuart_emulator.cpp
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#include "tpuart_emulator.h"
+#include <sblib/eib/tp_uart.h>
+
+TpUartEmulator::TpUartEmulator()
+    : resets(0)
+    , protocolErrors(0)
+    , echo(true)
+    , resetIndication(true)
+    , txData(0)
+{
+    clearBuffers();
+}
+
+int TpUartEmulator::write(byte ch)
+{
+    if (txData)
+    {
+        txFrame.push_back(ch);
+        if (txData == TP_UART_DATA_END)
+        {
+            sent.push_back(txFrame);
+            txFrame.clear();
+        }
+        txData = 0;
+    }
+    else if (ch & TP_UART_DATA_CONTINUE)
+    {
+        if ((ch & ~TP_UART_DATA_CONTINUE) != (int) txFrame.size())
+            ++protocolErrors;
+        txData = TP_UART_DATA_CONTINUE;
+    }
+    else if (ch & TP_UART_DATA_END)
+    {
+        if ((ch & ~TP_UART_DATA_END) != (int) txFrame.size())
+            ++protocolErrors;
+        txData = TP_UART_DATA_END;
+    }
+    else if ((ch & ~(TP_UART_ACK_ADDRESSED | TP_UART_ACK_BUSY | TP_UART_ACK_NACK)) == TP_UART_ACK_INFO)
+    {
+        acks.push_back(ch);
+    }
+    else if (ch == TP_UART_RESET_REQ)
+    {
+        ++resets;
+        txFrame.clear();
+        if (resetIndication)
+            indicate({ TP_UART_RESET_IND });
+    }
+    else if (ch == TP_UART_STATE_REQ)
+    {
+        indicate({ TP_UART_STATE_IND });
+    }
+    else
+    {
+        ++protocolErrors;
+    }
+    return 1;
+}
+
+void TpUartEmulator::indicate(const Bytes& bytes)
+{
+    for (byte ch : bytes)
+    {
+        received(ch);
+    }
+}
+
+void TpUartEmulator::receive(const Bytes& frame)
+{
+    indicate(withChecksum(frame));
+}
+
+void TpUartEmulator::confirm(bool acknowledged)
+{
+    if (echo && !sent.empty())
+        indicate(sent.back());
+    indicate({ (byte) (TP_UART_DATA_CON | (acknowledged ? 0x80 : 0)) });
+}
+
+Bytes TpUartEmulator::withChecksum(const Bytes& frame)
+{
+    Bytes result = frame;
+    byte checksum = 0xff;
+    for (byte ch : frame)
+        checksum ^= ch;
+    result.push_back(checksum);
+    return result;
+}
+
+/** @}*/
@@ -0,0 +1,78 @@
+/**************************************************************************//**
+ * @addtogroup SBLIB_MAIN_GROUP Selfbus KNX-Library
+ * @defgroup SBLIB_SUB_GROUP_TPUART TP transceiver emulator
+ * @ingroup SBLIB_MAIN_GROUP
+ * @brief   Host side emulation of a TP transceiver chip with a UART interface
+ * @details The emulator is the serial port of a TpUart. It decodes the services
+ *          that the TpUart writes, and passes the frames and services of the
+ *          transceiver to the TpUart, like the receive interrupt of the serial
+ *          port does, see sblib/eib/tp_uart.h.
+ *
+ * @{
+ *
+ * @file   tpuart_emulator.h
+ * @bug No known bugs.
+ ******************************************************************************/
+
+/*
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License version 3 as
+ published by the Free Software Foundation.
+ ---------------------------------------------------------------------------*/
+
+#ifndef TPUART_EMULATOR_H_
+#define TPUART_EMULATOR_H_
+
+#include <sblib/buffered_stream.h>
+#include <vector>
+
+typedef std::vector<byte> Bytes;
+
+class TpUartEmulator: public BufferedStream
+{
+public:
+    TpUartEmulator();
+
+    /**
+     * Process a byte that the TpUart writes to the transceiver.
+     */
+    virtual int write(byte ch);
+
+    virtual void flush() {}
+
+    /**
+     * Pass bytes from the transceiver to the TpUart.
+     */
+    void indicate(const Bytes& bytes);
+
+    /**
+     * Receive a frame from the bus and pass it to the TpUart. The checksum is appended.
+     */
+    void receive(const Bytes& frame);
+
+    /**
+     * End sending the last frame: pass it back to the TpUart and confirm it.
+     *
+     * @param acknowledged - true if the frame was acknowledged on the bus
+     */
+    void confirm(bool acknowledged);
+
+    /**
+     * @return The frame with the checksum appended.
+     */
+    static Bytes withChecksum(const Bytes& frame);
+
+    std::vector<Bytes> sent; //!< The frames that the TpUart sent, with the checksum
+    Bytes acks;              //!< The U_AckInformation services that the TpUart sent
+    int resets;              //!< The number of U_Reset.req services
+    int protocolErrors;      //!< The number of unknown services and bytes out of order
+    bool echo;               //!< Pass the sent frames back to the TpUart, like the transceiver does
+    bool resetIndication;    //!< Answer U_Reset.req with U_Reset.ind right away
+
+private:
+    Bytes txFrame;           //!< The frame that the TpUart is sending
+    int txData;              //!< The service of the data byte that follows, 0 if no data byte follows
+};
+
+#endif /* TPUART_EMULATOR_H_ */
+/** @}*/
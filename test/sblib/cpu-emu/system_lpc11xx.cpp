@@ -34,6 +34,11 @@ unsigned char FLASH[FLASH_SIZE];
 uint32_t SystemCoreClock = 48000000;
 unsigned int wfiSystemTimeInc = 0;
 
+// The emulated core clock does not change
+void SystemCoreClockUpdate(void)
+{
+}
+
 
 typedef enum
 {
@@ -1,14 +0,0 @@
-/*
- *  timer.cpp - 
- *
- *  Copyright (c) 2015 Martin Glueck <martin@mangari.org>
- *
- *  This program is free software; you can redistribute it and/or modify
- *  it under the terms of the GNU General Public License version 3 as
- *  published by the Free Software Foundation.
- */
-
-void delayMicroseconds(unsigned int usec)
-{
-
-}
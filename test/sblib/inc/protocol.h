@@ -108,4 +108,16 @@ struct Test_Case
 void executeTest(BcuType testBcuType, Test_Case * tc);
 void telegramPreparation(BcuDefault* testBcu, Telegram* tel, uint16_t telCount);
 
+/**
+ * Let the bus receive a frame like the bus timer interrupt handler does at the end of a frame.
+ *
+ * @param bus - the bus that receives the frame
+ * @param frame - the bytes of the frame
+ * @param length - the number of bytes of the frame
+ * @param appendChecksum - true to append the checksum to the frame, false if the frame ends with its checksum
+ * @param errors - the receive errors of the frame, see RX_* in bus_const.h
+ * @param valid - false if the bytes of the frame were not received correctly
+ */
+void receiveFrame(Bus* bus, const byte* frame, int length, bool appendChecksum, unsigned short errors = RX_OK, bool valid = true);
+
 #endif /* PROTOCOL_H_ */
@@ -7,7 +7,6 @@ set(SBLIB_TEST_SRC
         cpu-emu/system_LPC11xx.h
         inc/protocol.h
         cpu-emu/system_lpc11xx.cpp
-        cpu-emu/timer.cpp
         src/protocol.cpp
 #        src/wrapper.cc
 )
\ No newline at end of file
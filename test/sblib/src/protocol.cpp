@@ -9,6 +9,7 @@
  */
 
 #include "protocol.h"
+#include <sblib/main.h>
 #include <sblib/eib/knx_npdu.h>
 #include <sblib/internal/iap.h>
 #include <sblib/eib/bus_const.h>
@@ -128,6 +129,27 @@ static void addChecksum(unsigned char * telegram, unsigned int telLength)
     telegram[telLength-1] = checksum;
 }
 
+void receiveFrame(Bus* bus, const byte* frame, int length, bool appendChecksum, unsigned short errors, bool valid)
+{
+    byte checksum = 0xff;
+    for (int i = 0; i < length; ++i)
+    {
+        bus->rx_telegram[i] = frame[i];
+        checksum ^= frame[i];
+    }
+    if (appendChecksum)
+    {
+        bus->rx_telegram[length++] = checksum;
+    }
+    bus->nextByteIndex = length;
+    bus->currentByte = bus->rx_telegram[length - 1];
+    bus->parity = 1;
+    bus->valid = valid;
+    bus->rx_error = errors;
+    bus->state = Bus::RECV_WAIT_FOR_STARTBIT_OR_TELEND;
+    bus->handleTelegram(valid && !(errors & RX_CHECKSUM_ERROR));
+}
+
 static void _handleRx(BcuDefault* currentBcu, Test_Case * tc, Telegram * tel, unsigned int testStep)
 {
     tel->length++; // add one byte for checksum
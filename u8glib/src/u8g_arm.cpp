@@ -54,6 +54,7 @@
 #include "u8g_arm.h"
 
 #include <sblib/core.h>
+#include <sblib/spi.h>
 
 
 /*========================================================================*/
@@ -388,6 +389,52 @@ void spi_out(uint8_t data)
   LPC_SSP0->DR = data;
 }
 
+/*
+  Background transfer of the byte sequences with the FIFO/interrupt driven
+  block transfer of the sblib SPI class. The SPI class only drives the
+  transfer, spi_init() does the configuration of SSP0.
+*/
+
+/* number of bytes of a sequence that are sent in the background, larger sequences are split */
+#ifndef U8G_SPI_BUFFER_SIZE
+#define U8G_SPI_BUFFER_SIZE 132
+#endif
+
+static SPI u8g_spi(SPI_PORT_0, SPI_CPOL_HIGH | SPI_CPHASE_FALL);
+static uint16_t spi_buffer[U8G_SPI_BUFFER_SIZE];
+static uint8_t spi_busy = 0;		/* a background transfer is running */
+
+/* wait until all bytes are shifted out */
+static void spi_wait(void)
+{
+  if ( spi_busy )
+  {
+    while ( !u8g_spi.finished )
+      ;
+    u8g_spi.finalizeBlockTransfer();
+    spi_busy = 0;
+  }
+  while ( LPC_SSP0->SR & (1 << 4) )	/* SSP busy */
+    ;
+}
+
+/* send a byte sequence, the last up to U8G_SPI_BUFFER_SIZE bytes are sent in the background */
+static void spi_out_seq(const uint8_t *ptr, uint8_t cnt)
+{
+  for(;;)
+  {
+    uint8_t len = cnt > U8G_SPI_BUFFER_SIZE ? U8G_SPI_BUFFER_SIZE : cnt;
+    for( uint8_t i = 0; i < len; i++ )
+      spi_buffer[i] = *ptr++;
+    cnt -= len;
+
+    u8g_spi.transferBlock(spi_buffer, len, 0, cnt == 0);
+    if ( cnt == 0 )
+      break;
+  }
+  spi_busy = 1;
+}
+
 /*========================================================================*/
 /*
   The following delay procedures must be implemented for u8glib
@@ -452,8 +499,38 @@ uint16_t u8g_pin_cs = PIN(1,10);  // PIO1_2 ?
 uint16_t u8g_pin_rst = PIN(2,4); // PIO1_0 ?
 
 
+/* release the chip select after the background transfer, see U8G_COM_MSG_CHIP_SELECT */
+static uint8_t u8g_cs_release = 0;
+
+static void u8g_release_chip_select(void)
+{
+  uint8_t i;
+  /* this delay is required to avoid that the display is switched off too early --> DOGS102 with LPC1114 */
+  for( i = 0; i < 5; i++ )
+    u8g_10MicroDelay();
+  set_gpio_level(u8g_pin_cs, 1);
+  u8g_MicroDelay();
+}
+
 uint8_t u8g_com_hw_spi_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr)
 {
+  /*
+    A page flush ends with the data sequence and the chip select release. The
+    sequence is sent in the background and the release is delayed to the next
+    message, so the next page is rendered while the previous one is sent.
+  */
+  if ( msg == U8G_COM_MSG_CHIP_SELECT && arg_val == 0 && spi_busy )
+  {
+    u8g_cs_release = 1;
+    return 1;
+  }
+  spi_wait();
+  if ( u8g_cs_release )
+  {
+    u8g_cs_release = 0;
+    u8g_release_chip_select();
+  }
+
   switch(msg)
   {
     case U8G_COM_MSG_STOP:
@@ -495,18 +572,14 @@ uint8_t u8g_com_hw_spi_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_pt
       if ( arg_val == 0 )
       {
         /* disable */
-	uint8_t i;
-	/* this delay is required to avoid that the display is switched off too early --> DOGS102 with LPC1114 */
-	for( i = 0; i < 5; i++ )
-	  u8g_10MicroDelay();
-	set_gpio_level(u8g_pin_cs, 1);
+	u8g_release_chip_select();
       }
       else
       {
         /* enable */
 	set_gpio_level(u8g_pin_cs, 0);
+	u8g_MicroDelay();
       }
-      u8g_MicroDelay();
       break;
       
     case U8G_COM_MSG_RESET:
@@ -521,14 +594,8 @@ uint8_t u8g_com_hw_spi_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_pt
     
     case U8G_COM_MSG_WRITE_SEQ:
     case U8G_COM_MSG_WRITE_SEQ_P:
-      {
-    	  register uint8_t *ptr = (uint8_t*) arg_ptr;
-        while( arg_val > 0 )
-        {
-          spi_out(*ptr++);
-          arg_val--;
-        }
-      }
+      if ( arg_val > 0 )
+        spi_out_seq((const uint8_t *) arg_ptr, arg_val);
       break;
   }
   return 1;